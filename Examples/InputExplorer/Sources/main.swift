@@ -64,8 +64,14 @@ struct InputExplorer {
                     case .scaleFactorChanged(let id, let oldFactor, let newFactor):
                         print("[\(eventCount)] Scale factor changed: \(id) -> \(oldFactor)x to \(newFactor)x")
 
-                    case .created(_):
-                        break  // Don't print window created events
+                    case .liveResizeStarted(let id):
+                        print("[\(eventCount)] Live resize started: \(id)")
+
+                    case .liveResizeEnded(let id):
+                        print("[\(eventCount)] Live resize ended: \(id)")
+
+                    case .created(_), .redrawRequested(_):
+                        break  // Don't print window created or redraw events
                     }
 
                 // Pointer Events
@@ -91,6 +97,9 @@ struct InputExplorer {
 
                     case .left(let id):
                         print("[\(eventCount)] Pointer left window: \(id)")
+
+                    case .rawMotion(let dx, let dy):
+                        print("[\(eventCount)] Raw motion: dx=\(dx), dy=\(dy)")
                     }
 
                 // Keyboard Events
@@ -111,6 +120,11 @@ struct InputExplorer {
                 // User Events
                 case .user(let userEvent):
                     print("[\(eventCount)] User event: \(userEvent.data)")
+
+                // Display Events
+                case .monitorsChanged:
+                    let count = (try? Monitor.all().count) ?? 0
+                    print("[\(eventCount)] Monitors changed: \(count) connected")
                 }
             }
 
@@ -28,6 +28,18 @@ let package = Package(
             ]
         ),
 
+        // MARK: - Benchmarks
+
+        /// Benchmark suite (`swift run -c release LuminaBenchmarks --json results.json`)
+        .executableTarget(
+            name: "LuminaBenchmarks",
+            dependencies: ["Lumina"],
+            swiftSettings: [
+                .swiftLanguageMode(.v6),
+                .enableUpcomingFeature("StrictConcurrency")
+            ]
+        ),
+
         // MARK: - Tests
 
         /// Unit tests (includes platform-specific tests via conditional compilation)
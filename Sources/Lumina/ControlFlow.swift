@@ -0,0 +1,57 @@
+/// How a custom event loop sleeps when no events are pending.
+///
+/// Set `LuminaApp.controlFlow` and call `waitForEvents()` once per loop
+/// iteration; the application then polls, sleeps until the next event, or
+/// sleeps until a deadline without busy-spinning.
+///
+/// Example:
+/// ```swift
+/// // Fixed 60 Hz simulation tick that still wakes for input
+/// let tick = Duration.milliseconds(16)
+/// var nextTick = ContinuousClock.now + tick
+/// while running {
+///     app.controlFlow = .waitUntil(nextTick)
+///     try app.waitForEvents()
+///     while let event = try app.poll() {
+///         handle(event)
+///     }
+///     if ContinuousClock.now >= nextTick {
+///         simulation.step()
+///         nextTick += tick
+///     }
+/// }
+/// ```
+public enum ControlFlow: Sendable, Equatable {
+    /// Never sleep; `waitForEvents()` returns immediately.
+    ///
+    /// Use for loops that render continuously and are throttled elsewhere
+    /// (for example by a vsync'd present).
+    case poll
+
+    /// Sleep until the next event arrives (the default).
+    case wait
+
+    /// Sleep until the next event arrives or the deadline passes, whichever
+    /// comes first.
+    case waitUntil(ContinuousClock.Instant)
+
+    /// Leave the event loop.
+    ///
+    /// Returned from a `run(handler:)` handler to make `run` return;
+    /// `waitForEvents()` treats it like `.poll`.
+    case exit
+}
+
+// MARK: - Deadline Helpers
+
+extension ContinuousClock.Instant {
+    /// Seconds from now until this instant (zero if it has passed).
+    internal var secondsFromNow: Double {
+        let remaining = ContinuousClock.now.duration(to: self)
+        guard remaining > .zero else {
+            return 0
+        }
+        let (seconds, attoseconds) = remaining.components
+        return Double(seconds) + Double(attoseconds) / 1e18
+    }
+}
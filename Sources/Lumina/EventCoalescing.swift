@@ -0,0 +1,323 @@
+/// Opt-in event coalescing for high-frequency input.
+///
+/// High-polling-rate mice and trackpads report far more samples than an
+/// application renders frames. With coalescing enabled, `poll()` and
+/// `drain(into:)` merge runs of redundant events before handing them over,
+/// so a game loop sees one motion event per window per batch instead of
+/// dozens.
+///
+/// Pointer and wheel events are only merged when *consecutive* and for the
+/// *same* window, so the relative order of motion, button and keyboard
+/// events is preserved. Window geometry (`.resize`) is collapsed across the
+/// whole batch, since only the latest size and position matter. Text
+/// (`.text`) is joined across the key events that typed it.
+///
+/// Options can also be set per window with
+/// `setEventCoalescing(_:for:)`, overriding the application-wide value.
+///
+/// Example:
+/// ```swift
+/// // Games: only the latest pointer position matters
+/// app.eventCoalescing = [.pointerMotion, .wheel]
+///
+/// // Drawing apps: coalesce, but keep the full stroke path
+/// app.eventCoalescing = [.pointerMotion, .pointerSamples]
+/// while let event = try app.poll() {
+///     if case .pointer(.moved(let id, _)) = event {
+///         for point in app.coalescedPointerSamples(for: id) {
+///             stroke.add(point)
+///         }
+///     }
+/// }
+/// ```
+public struct EventCoalescing: OptionSet, Sendable {
+    public let rawValue: UInt8
+
+    public init(rawValue: UInt8) {
+        self.rawValue = rawValue
+    }
+
+    /// Merge consecutive `.pointer(.moved)` events for the same window into
+    /// the most recent one, and consecutive `.pointer(.rawMotion)` events by
+    /// summing their deltas.
+    public static let pointerMotion = EventCoalescing(rawValue: 1 << 0)
+
+    /// Merge consecutive `.pointer(.wheel)` events for the same window by
+    /// summing their deltas.
+    public static let wheel = EventCoalescing(rawValue: 1 << 1)
+
+    /// Keep every pointer position seen in the latest batch, including the
+    /// ones merged away, available through `coalescedPointerSamples(for:)`.
+    public static let pointerSamples = EventCoalescing(rawValue: 1 << 2)
+
+    /// Collapse every pending `.window(.resized)` and `.window(.moved)` event
+    /// for a window into the latest one of each kind.
+    ///
+    /// Useful during live resize, where the OS reports every intermediate
+    /// size; pair with `.liveResizeStarted`/`.liveResizeEnded` to defer
+    /// expensive reallocations until the drag ends.
+    public static let resize = EventCoalescing(rawValue: 1 << 3)
+
+    /// Concatenate runs of `.keyboard(.textInput)` events for the same window
+    /// into one event.
+    ///
+    /// Text-heavy views (consoles, editors) then insert one string per batch
+    /// instead of one per character. The key events that produced the
+    /// characters stay in the stream but are delivered ahead of the merged
+    /// text; any other key press (Backspace, arrows, shortcuts) ends the run,
+    /// so edits keep their position relative to the text.
+    public static let text = EventCoalescing(rawValue: 1 << 4)
+
+    /// Coalesce pointer motion and wheel events (without sample retention).
+    public static let all: EventCoalescing = [.pointerMotion, .wheel]
+}
+
+/// Merges redundant events within a batch according to `EventCoalescing`.
+///
+/// This is the platform-independent core of the coalescing mode; backends
+/// feed it whole batches through `EventPipeline`.
+internal struct EventCoalescer {
+    /// Pointer positions per window seen in the most recent batch
+    /// (only populated with `.pointerSamples`).
+    private(set) var pointerSamples: [WindowID: [LogicalPosition]] = [:]
+
+    /// Index of the latest `.resized`/`.moved` event per window in the
+    /// current batch (scratch, kept for its capacity).
+    private var latestResize: [WindowID: Int] = [:]
+    private var latestMove: [WindowID: Int] = [:]
+
+    /// Text run being joined (scratch, kept for its capacity).
+    private var textRun = TextRun()
+
+    /// Characters of one window's text run and the key events typed
+    /// between them, held back until the run ends.
+    private struct TextRun {
+        var window: WindowID?
+        var pieces: [String] = []
+        var utf8Count = 0
+        var timestamp = EventTimestamp(nanoseconds: 0)
+        var keys: [EventEnvelope] = []
+
+        /// Number of `keys` that precede the latest piece
+        var keysBeforeText = 0
+
+        mutating func append(_ text: String, at timestamp: EventTimestamp) {
+            pieces.append(text)
+            utf8Count += text.utf8.count
+            self.timestamp = timestamp
+            keysBeforeText = keys.count
+        }
+
+        /// The run's text as one string, built with a single allocation.
+        func joinedText() -> String {
+            guard pieces.count > 1 else {
+                return pieces.first ?? ""
+            }
+            var joined = String()
+            joined.reserveCapacity(utf8Count)
+            for piece in pieces {
+                joined.append(piece)
+            }
+            return joined
+        }
+
+        mutating func reset() {
+            window = nil
+            pieces.removeAll(keepingCapacity: true)
+            utf8Count = 0
+            keys.removeAll(keepingCapacity: true)
+            keysBeforeText = 0
+        }
+    }
+
+    /// Coalesce `events` in place.
+    ///
+    /// A merged envelope carries the timestamp of the latest event in its run.
+    ///
+    /// - Parameters:
+    ///   - events: Batch of events in delivery order; merged in place
+    ///   - options: Which event kinds to merge
+    ///   - overrides: Per-window options replacing `options` for that window
+    mutating func coalesce(
+        _ events: inout [EventEnvelope],
+        options: EventCoalescing,
+        overrides: [WindowID: EventCoalescing] = [:]
+    ) {
+        let retainsSamples = options.contains(.pointerSamples)
+            || overrides.values.contains { $0.contains(.pointerSamples) }
+        if retainsSamples || !pointerSamples.isEmpty {
+            pointerSamples.removeAll(keepingCapacity: retainsSamples)
+        }
+
+        guard !(options.isEmpty && overrides.isEmpty), !events.isEmpty else {
+            return
+        }
+
+        let collapsesGeometry = options.contains(.resize)
+            || overrides.values.contains { $0.contains(.resize) }
+        if collapsesGeometry {
+            indexLatestGeometry(in: events, options: options, overrides: overrides)
+        }
+
+        var write = 0
+        for read in events.indices {
+            let envelope = events[read]
+            let effective = effectiveOptions(for: envelope.event, options: options, overrides: overrides)
+
+            if effective.contains(.pointerSamples), case .pointer(.moved(let id, let position)) = envelope.event {
+                pointerSamples[id, default: []].append(position)
+            }
+
+            if collapsesGeometry, isSuperseded(envelope.event, at: read) {
+                continue
+            }
+
+            // Text runs are held back and written in one piece when they
+            // end; everything they took was read, so they never overtake `read`
+            if effective.contains(.text), case .keyboard(.textInput(let id, let text)) = envelope.event {
+                if textRun.window != id {
+                    closeTextRun(in: &events, at: &write)
+                    textRun.window = id
+                }
+                textRun.append(text, at: envelope.timestamp)
+                continue
+            }
+            if textRun.window != nil {
+                if continuesText(envelope.event, before: read + 1 < events.count ? events[read + 1].event : nil) {
+                    textRun.keys.append(envelope)
+                    continue
+                }
+                closeTextRun(in: &events, at: &write)
+            }
+
+            if write > 0, let merged = merge(events[write - 1].event, envelope.event, options: effective) {
+                events[write - 1] = EventEnvelope(merged, timestamp: envelope.timestamp)
+            } else {
+                events[write] = envelope
+                write += 1
+            }
+        }
+        closeTextRun(in: &events, at: &write)
+        events.removeLast(events.count - write)
+
+        if collapsesGeometry {
+            latestResize.removeAll(keepingCapacity: true)
+            latestMove.removeAll(keepingCapacity: true)
+        }
+    }
+
+    /// Write the open text run at `write`: the key events typed up to its
+    /// last character, the joined text, then the key events after it.
+    private mutating func closeTextRun(in events: inout [EventEnvelope], at write: inout Int) {
+        guard let window = textRun.window else {
+            return
+        }
+        for (index, key) in textRun.keys.enumerated() {
+            if index == textRun.keysBeforeText {
+                events[write] = textEnvelope(window)
+                write += 1
+            }
+            events[write] = key
+            write += 1
+        }
+        if textRun.keysBeforeText == textRun.keys.count {
+            events[write] = textEnvelope(window)
+            write += 1
+        }
+        textRun.reset()
+    }
+
+    private func textEnvelope(_ window: WindowID) -> EventEnvelope {
+        EventEnvelope(.keyboard(.textInput(window, text: textRun.joinedText())), timestamp: textRun.timestamp)
+    }
+
+    /// Record where the last geometry event of each window sits in the batch.
+    private mutating func indexLatestGeometry(
+        in events: [EventEnvelope],
+        options: EventCoalescing,
+        overrides: [WindowID: EventCoalescing]
+    ) {
+        for (index, envelope) in events.enumerated() {
+            switch envelope.event {
+            case .window(.resized(let id, _)) where (overrides[id] ?? options).contains(.resize):
+                latestResize[id] = index
+            case .window(.moved(let id, _)) where (overrides[id] ?? options).contains(.resize):
+                latestMove[id] = index
+            default:
+                break
+            }
+        }
+    }
+
+    /// Whether a later geometry event of the same kind replaces `event`.
+    private func isSuperseded(_ event: Event, at index: Int) -> Bool {
+        switch event {
+        case .window(.resized(let id, _)):
+            return latestResize[id].map { $0 != index } ?? false
+        case .window(.moved(let id, _)):
+            return latestMove[id].map { $0 != index } ?? false
+        default:
+            return false
+        }
+    }
+
+    /// Options in effect for `event`'s window.
+    private func effectiveOptions(
+        for event: Event,
+        options: EventCoalescing,
+        overrides: [WindowID: EventCoalescing]
+    ) -> EventCoalescing {
+        guard !overrides.isEmpty else {
+            return options
+        }
+
+        switch event {
+        case .pointer(.moved(let id, _)), .pointer(.wheel(let id, _, _)),
+             .keyboard(.textInput(let id, _)):
+            return overrides[id] ?? options
+        default:
+            return options
+        }
+    }
+
+    /// Whether a text run may continue past `event`.
+    ///
+    /// Typing interleaves characters with the key events that produce them
+    /// (keyDown, textInput, keyUp), so key releases and key presses directly
+    /// followed by their text don't split a run. Any other key press (such as
+    /// Backspace) does, keeping edits ordered relative to the text.
+    private func continuesText(_ event: Event, before next: Event?) -> Bool {
+        switch event {
+        case .keyboard(.keyUp):
+            return true
+        case .keyboard(.keyDown(let id, _, _)):
+            if case .keyboard(.textInput(id, _)) = next {
+                return true
+            }
+            return false
+        default:
+            return false
+        }
+    }
+
+    /// Merge two adjacent events, or return nil if they must stay separate.
+    private func merge(_ previous: Event, _ next: Event, options: EventCoalescing) -> Event? {
+        switch (previous, next) {
+        case (.pointer(.moved(let previousID, _)), .pointer(.moved(let nextID, _)))
+            where previousID == nextID && options.contains(.pointerMotion):
+            return next
+
+        case (.pointer(.rawMotion(let previousX, let previousY)), .pointer(.rawMotion(let nextX, let nextY)))
+            where options.contains(.pointerMotion):
+            return .pointer(.rawMotion(dx: previousX + nextX, dy: previousY + nextY))
+
+        case (.pointer(.wheel(let previousID, let previousX, let previousY)),
+              .pointer(.wheel(let nextID, let nextX, let nextY)))
+            where previousID == nextID && options.contains(.wheel):
+            return .pointer(.wheel(nextID, deltaX: previousX + nextX, deltaY: previousY + nextY))
+
+        default:
+            return nil
+        }
+    }
+}
@@ -0,0 +1,69 @@
+/// Routes events straight to the handler of `LuminaApp.run(handler:)`.
+///
+/// While `run(handler:)` is active, backends hand each event to the
+/// dispatcher at the point of translation (in WndProc, or right after
+/// `NSApp.sendEvent`) instead of queueing it for `poll()`, saving the
+/// enqueue/dequeue round-trip per event.
+///
+/// The handler's most recent return value decides how the loop sleeps
+/// once it runs out of events. After it returns `.exit`, nothing more is
+/// dispatched; backends queue any remaining events so the next `poll()`
+/// still sees them.
+///
+/// Thread Safety: Must only be accessed from @MainActor.
+@MainActor
+internal final class EventDispatcher {
+    private let handler: EventHandler
+
+    /// The control flow requested by the handler's latest return value
+    private(set) var controlFlow: ControlFlow
+
+    /// Receives every delivered event (see `LuminaApp.eventRecorder`)
+    var recorder: EventTraceRecorder?
+
+    /// Create a dispatcher.
+    ///
+    /// - Parameters:
+    ///   - handler: The application's event handler
+    ///   - controlFlow: How to sleep until the handler returns its first value
+    init(handler: @escaping EventHandler, controlFlow: ControlFlow) {
+        self.handler = handler
+        self.controlFlow = controlFlow
+    }
+
+    /// Whether the handler asked the loop to return.
+    var isExiting: Bool {
+        controlFlow == .exit
+    }
+
+    /// Deliver one event to the handler.
+    ///
+    /// - Returns: false if the handler already returned `.exit` (the event
+    ///   was not delivered)
+    @discardableResult
+    func dispatch(_ envelope: EventEnvelope) -> Bool {
+        guard !isExiting else {
+            return false
+        }
+        recorder?.record(envelope)
+        controlFlow = handler(envelope.event)
+        return true
+    }
+
+    /// Deliver one event, timestamped now.
+    @discardableResult
+    func dispatch(_ event: Event) -> Bool {
+        dispatch(EventEnvelope(event))
+    }
+
+    /// Deliver a batch of events in order, stopping at `.exit`.
+    ///
+    /// - Parameter envelopes: Events to deliver
+    /// - Returns: The events left undelivered
+    func dispatch(_ envelopes: [EventEnvelope]) -> ArraySlice<EventEnvelope> {
+        for index in envelopes.indices where !dispatch(envelopes[index]) {
+            return envelopes[index...]
+        }
+        return []
+    }
+}
@@ -0,0 +1,119 @@
+#if os(macOS)
+import Darwin
+#elseif os(Windows)
+import WinSDK
+#else
+import Glibc
+#endif
+
+/// Monotonic, high-resolution timestamp of an event.
+///
+/// Timestamps are captured as close to the OS source as possible:
+/// - macOS: `NSEvent.timestamp` (system uptime, same base as `CLOCK_UPTIME_RAW`)
+/// - Windows: `QueryPerformanceCounter` at WndProc entry
+///
+/// The origin is unspecified (typically system boot) but fixed for the
+/// lifetime of the process, so timestamps can be subtracted from each other
+/// and from `EventTimestamp.now()` to measure input latency.
+///
+/// Example:
+/// ```swift
+/// while let envelope = try app.pollEnvelope() {
+///     let age = envelope.timestamp.duration(to: .now())
+///     print("Event is \(age) old")
+/// }
+/// ```
+public struct EventTimestamp: Sendable, Hashable, Comparable {
+    /// Nanoseconds since the clock's (unspecified) origin
+    public let nanoseconds: UInt64
+
+    /// Create a timestamp from a raw nanosecond value.
+    ///
+    /// - Parameter nanoseconds: Nanoseconds since the platform clock's origin
+    public init(nanoseconds: UInt64) {
+        self.nanoseconds = nanoseconds
+    }
+
+    /// Create a timestamp from fractional seconds of system uptime.
+    ///
+    /// This matches the representation used by `NSEvent.timestamp`.
+    internal init(seconds: Double) {
+        self.nanoseconds = seconds > 0 ? UInt64(seconds * 1_000_000_000) : 0
+    }
+
+    /// The current time on the event clock.
+    public static func now() -> EventTimestamp {
+        #if os(macOS)
+        return EventTimestamp(nanoseconds: clock_gettime_nsec_np(CLOCK_UPTIME_RAW))
+        #elseif os(Windows)
+        var counter = LARGE_INTEGER()
+        QueryPerformanceCounter(&counter)
+        let ticks = UInt64(counter.QuadPart)
+        let frequency = performanceFrequency
+        // Split to avoid overflowing ticks * 1e9
+        let nanoseconds = (ticks / frequency) * 1_000_000_000
+            + (ticks % frequency) * 1_000_000_000 / frequency
+        return EventTimestamp(nanoseconds: nanoseconds)
+        #else
+        var spec = timespec()
+        clock_gettime(CLOCK_MONOTONIC, &spec)
+        return EventTimestamp(nanoseconds: UInt64(spec.tv_sec) * 1_000_000_000 + UInt64(spec.tv_nsec))
+        #endif
+    }
+
+    /// Time elapsed from this timestamp to `other` (negative if `other` is earlier).
+    public func duration(to other: EventTimestamp) -> Duration {
+        if other.nanoseconds >= nanoseconds {
+            return .nanoseconds(Int64(other.nanoseconds - nanoseconds))
+        }
+        return .nanoseconds(-Int64(nanoseconds - other.nanoseconds))
+    }
+
+    public static func < (lhs: EventTimestamp, rhs: EventTimestamp) -> Bool {
+        lhs.nanoseconds < rhs.nanoseconds
+    }
+}
+
+#if os(Windows)
+/// QueryPerformanceFrequency is fixed at boot, so query it once.
+private let performanceFrequency: UInt64 = {
+    var frequency = LARGE_INTEGER()
+    QueryPerformanceFrequency(&frequency)
+    return UInt64(frequency.QuadPart)
+}()
+#endif
+
+/// An event together with the time the OS reported it.
+///
+/// `Event` itself carries no timestamp so that pattern matching and the
+/// enum's layout stay unchanged; the envelope adds it alongside. Use
+/// `pollEnvelope()` or `drain(into:)` with an `[EventEnvelope]` buffer to
+/// receive envelopes instead of bare events.
+///
+/// Example:
+/// ```swift
+/// var envelopes: [EventEnvelope] = []
+/// try app.drain(into: &envelopes)
+/// for envelope in envelopes {
+///     if case .pointer(.buttonPressed) = envelope.event {
+///         latencyTracker.record(envelope.timestamp)
+///     }
+/// }
+/// ```
+public struct EventEnvelope: Sendable {
+    /// The wrapped event
+    public let event: Event
+
+    /// When the OS reported the event
+    public let timestamp: EventTimestamp
+
+    /// Wrap an event with its timestamp.
+    ///
+    /// - Parameters:
+    ///   - event: The event
+    ///   - timestamp: When the event occurred (defaults to now)
+    public init(_ event: Event, timestamp: EventTimestamp = .now()) {
+        self.event = event
+        self.timestamp = timestamp
+    }
+}
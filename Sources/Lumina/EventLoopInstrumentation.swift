@@ -0,0 +1,360 @@
+import Synchronization
+#if os(macOS)
+import os
+#elseif os(Windows)
+import WinSDK
+#endif
+
+/// Event loop counters collected while instrumentation is enabled.
+///
+/// Returned by `LuminaApp.statistics()`. Counts accumulate while
+/// `LuminaApp.instrumentationEnabled` is true and are cleared by
+/// `resetStatistics()`.
+public struct EventLoopStatistics: Sendable, Equatable {
+    /// OS messages dispatched (`NSApp.sendEvent` / `DispatchMessageW`)
+    public var messagesDispatched: UInt64 = 0
+
+    /// Lumina events produced from OS messages
+    public var eventsTranslated: UInt64 = 0
+
+    /// Input events discarded by an event mask
+    public var eventsDropped: UInt64 = 0
+
+    /// Events merged into a later event by coalescing
+    public var eventsCoalesced: UInt64 = 0
+
+    /// Most translated events handed over by the backend in one batch
+    public var queueHighWaterMark: Int = 0
+
+    /// Times the event loop went to sleep in `wait()` or `run(handler:)`
+    public var waits: UInt64 = 0
+
+    /// Wakeups posted to a sleeping event loop by `postUserEvent(_:)`
+    public var wakeups: UInt64 = 0
+
+    public init() {}
+}
+
+/// Per-application counters and trace intervals for the event loop hot path.
+///
+/// Every entry point first checks `isEnabled` with one relaxed atomic load,
+/// so a disabled instance costs a load and a branch per call. When enabled,
+/// counters are relaxed atomic adds and `measure` emits a platform trace
+/// interval:
+/// - macOS: `os_signpost` intervals (subsystem "Lumina", category
+///   "EventLoop"), shown by Instruments' os_signpost and Points of
+///   Interest instruments
+/// - Windows: ETW events in the TraceLogging format from the "Lumina"
+///   provider (see `LuminaTraceProvider`), with Start/Stop opcodes
+///
+/// Thread Safety: All methods may be called from any thread;
+/// `postUserEvent` counts wakeups from producer threads.
+internal final class EventLoopInstrumentation: Sendable {
+    enum Counter {
+        case messagesDispatched
+        case eventsTranslated
+        case eventsDropped
+        case eventsCoalesced
+        case waits
+        case wakeups
+    }
+
+    /// Hot path sections reported as trace intervals.
+    enum Interval {
+        case dispatch
+        case translate
+        case enqueue
+        case dequeue
+        case wait
+    }
+
+    private let enabled = Atomic<Bool>(false)
+
+    private let messagesDispatched = Atomic<UInt64>(0)
+    private let eventsTranslated = Atomic<UInt64>(0)
+    private let eventsDropped = Atomic<UInt64>(0)
+    private let eventsCoalesced = Atomic<UInt64>(0)
+    private let queueHighWaterMark = Atomic<Int>(0)
+    private let waits = Atomic<UInt64>(0)
+    private let wakeups = Atomic<UInt64>(0)
+
+    init() {}
+
+    var isEnabled: Bool {
+        get { enabled.load(ordering: .relaxed) }
+        set { enabled.store(newValue, ordering: .relaxed) }
+    }
+
+    /// Add `amount` to a counter (no-op while disabled).
+    @inline(__always)
+    func count(_ counter: Counter, _ amount: Int = 1) {
+        guard isEnabled, amount > 0 else {
+            return
+        }
+        let delta = UInt64(amount)
+        switch counter {
+        case .messagesDispatched:
+            messagesDispatched.wrappingAdd(delta, ordering: .relaxed)
+        case .eventsTranslated:
+            eventsTranslated.wrappingAdd(delta, ordering: .relaxed)
+        case .eventsDropped:
+            eventsDropped.wrappingAdd(delta, ordering: .relaxed)
+        case .eventsCoalesced:
+            eventsCoalesced.wrappingAdd(delta, ordering: .relaxed)
+        case .waits:
+            waits.wrappingAdd(delta, ordering: .relaxed)
+        case .wakeups:
+            wakeups.wrappingAdd(delta, ordering: .relaxed)
+            LuminaTracer.mark(.wakeup)
+        }
+    }
+
+    /// Record a batch size for `queueHighWaterMark` (no-op while disabled).
+    @inline(__always)
+    func noteQueueDepth(_ depth: Int) {
+        guard isEnabled else {
+            return
+        }
+        queueHighWaterMark.max(depth, ordering: .relaxed)
+    }
+
+    /// Run `body` inside a trace interval (just `body` while disabled).
+    @inline(__always)
+    func measure<T>(_ interval: Interval, _ body: () throws -> T) rethrows -> T {
+        guard isEnabled else {
+            return try body()
+        }
+        let token = LuminaTracer.begin(interval)
+        defer { LuminaTracer.end(interval, token) }
+        return try body()
+    }
+
+    /// Current counter values.
+    func snapshot() -> EventLoopStatistics {
+        var statistics = EventLoopStatistics()
+        statistics.messagesDispatched = messagesDispatched.load(ordering: .relaxed)
+        statistics.eventsTranslated = eventsTranslated.load(ordering: .relaxed)
+        statistics.eventsDropped = eventsDropped.load(ordering: .relaxed)
+        statistics.eventsCoalesced = eventsCoalesced.load(ordering: .relaxed)
+        statistics.queueHighWaterMark = queueHighWaterMark.load(ordering: .relaxed)
+        statistics.waits = waits.load(ordering: .relaxed)
+        statistics.wakeups = wakeups.load(ordering: .relaxed)
+        return statistics
+    }
+
+    /// Zero every counter.
+    func reset() {
+        messagesDispatched.store(0, ordering: .relaxed)
+        eventsTranslated.store(0, ordering: .relaxed)
+        eventsDropped.store(0, ordering: .relaxed)
+        eventsCoalesced.store(0, ordering: .relaxed)
+        queueHighWaterMark.store(0, ordering: .relaxed)
+        waits.store(0, ordering: .relaxed)
+        wakeups.store(0, ordering: .relaxed)
+    }
+}
+
+// MARK: - Platform Tracing
+
+/// Point events reported without a duration.
+internal enum TraceMark {
+    case wakeup
+}
+
+#if os(macOS)
+
+/// os_signpost backend of `EventLoopInstrumentation`.
+internal enum LuminaTracer {
+    private static let signposter = OSSignposter(subsystem: "Lumina", category: "EventLoop")
+
+    static func begin(_ interval: EventLoopInstrumentation.Interval) -> OSSignpostIntervalState {
+        // Signpost names must be static strings
+        let id = signposter.makeSignpostID()
+        switch interval {
+        case .dispatch:
+            return signposter.beginInterval("Dispatch", id: id)
+        case .translate:
+            return signposter.beginInterval("Translate", id: id)
+        case .enqueue:
+            return signposter.beginInterval("Enqueue", id: id)
+        case .dequeue:
+            return signposter.beginInterval("Dequeue", id: id)
+        case .wait:
+            return signposter.beginInterval("Wait", id: id)
+        }
+    }
+
+    static func end(_ interval: EventLoopInstrumentation.Interval, _ state: OSSignpostIntervalState) {
+        switch interval {
+        case .dispatch:
+            signposter.endInterval("Dispatch", state)
+        case .translate:
+            signposter.endInterval("Translate", state)
+        case .enqueue:
+            signposter.endInterval("Enqueue", state)
+        case .dequeue:
+            signposter.endInterval("Dequeue", state)
+        case .wait:
+            signposter.endInterval("Wait", state)
+        }
+    }
+
+    static func mark(_ mark: TraceMark) {
+        switch mark {
+        case .wakeup:
+            signposter.emitEvent("Wakeup")
+        }
+    }
+}
+
+#elseif os(Windows)
+
+/// ETW backend of `EventLoopInstrumentation`.
+internal enum LuminaTracer {
+    static func begin(_ interval: EventLoopInstrumentation.Interval) {
+        LuminaTraceProvider.shared.write(interval.traceName, opcode: LuminaTraceProvider.opcodeStart)
+    }
+
+    static func end(_ interval: EventLoopInstrumentation.Interval, _ token: Void) {
+        LuminaTraceProvider.shared.write(interval.traceName, opcode: LuminaTraceProvider.opcodeStop)
+    }
+
+    static func mark(_ mark: TraceMark) {
+        switch mark {
+        case .wakeup:
+            LuminaTraceProvider.shared.write("Wakeup", opcode: LuminaTraceProvider.opcodeInfo)
+        }
+    }
+}
+
+extension EventLoopInstrumentation.Interval {
+    fileprivate var traceName: String {
+        switch self {
+        case .dispatch: "Dispatch"
+        case .translate: "Translate"
+        case .enqueue: "Enqueue"
+        case .dequeue: "Dequeue"
+        case .wait: "Wait"
+        }
+    }
+}
+
+/// The "Lumina" ETW provider, {5B1D3C7E-8F2A-4C61-9D0B-3E7A4F6C2915}.
+///
+/// The TraceLogging headers are macros Swift can't import, so this writes
+/// the same self-describing format by hand: provider traits naming the
+/// provider, and per-event metadata naming the event, passed to
+/// `EventWriteTransfer` ahead of the (empty) payload. Tools decode the
+/// events without a manifest, e.g.
+/// `wpr -start Lumina.wprp` or
+/// `tracelog -start lumina -guid #5B1D3C7E-8F2A-4C61-9D0B-3E7A4F6C2915`.
+///
+/// Nothing is formatted or written unless a trace session enabled the
+/// provider (`EventProviderEnabled`).
+internal final class LuminaTraceProvider: @unchecked Sendable {
+    static let shared = LuminaTraceProvider()
+
+    static let opcodeInfo: UCHAR = 0
+    static let opcodeStart: UCHAR = 1
+    static let opcodeStop: UCHAR = 2
+
+    // WINEVENT_CHANNEL_TRACELOGGING / WINEVENT_LEVEL_VERBOSE
+    private static let channel: UCHAR = 11
+    private static let level: UCHAR = 5
+
+    // EVENT_DATA_DESCRIPTOR_TYPE_*
+    private static let eventMetadataType: UInt32 = 1
+    private static let providerMetadataType: UInt32 = 2
+
+    private var handle: REGHANDLE = 0
+
+    /// Provider traits blob: total size, then the NUL-terminated name
+    private let traits: [UInt8]
+
+    /// Event metadata blobs, built once per event name; locked because
+    /// wakeups are written from producer threads
+    private let metadata: Mutex<[String: [UInt8]]> = Mutex([:])
+
+    private init() {
+        traits = Self.sizePrefixed(Array("Lumina".utf8) + [0])
+
+        var providerID = GUID(
+            Data1: 0x5B1D_3C7E, Data2: 0x8F2A, Data3: 0x4C61,
+            Data4: (0x9D, 0x0B, 0x3E, 0x7A, 0x4F, 0x6C, 0x29, 0x15)
+        )
+        guard EventRegister(&providerID, nil, nil, &handle) == ERROR_SUCCESS else {
+            handle = 0
+            return
+        }
+        traits.withUnsafeBytes { bytes in
+            _ = EventSetInformation(
+                handle, EventProviderSetTraits,
+                UnsafeMutableRawPointer(mutating: bytes.baseAddress), ULONG(bytes.count)
+            )
+        }
+    }
+
+    deinit {
+        if handle != 0 {
+            EventUnregister(handle)
+        }
+    }
+
+    /// Write a payload-less event if a session is listening.
+    func write(_ name: String, opcode: UCHAR) {
+        guard handle != 0, EventProviderEnabled(handle, Self.level, 0) != 0 else {
+            return
+        }
+        let eventMetadata = metadata.withLock { cache in
+            if let cached = cache[name] {
+                return cached
+            }
+            // Size, one tags byte (none), NUL-terminated name; no fields
+            let blob = Self.sizePrefixed([0] + Array(name.utf8) + [0])
+            cache[name] = blob
+            return blob
+        }
+
+        var descriptor = EVENT_DESCRIPTOR(
+            Id: 0, Version: 0, Channel: Self.channel, Level: Self.level,
+            Opcode: opcode, Task: 0, Keyword: 0
+        )
+        traits.withUnsafeBytes { traitBytes in
+            eventMetadata.withUnsafeBytes { metadataBytes in
+                var data = [
+                    Self.descriptor(traitBytes, type: Self.providerMetadataType),
+                    Self.descriptor(metadataBytes, type: Self.eventMetadataType),
+                ]
+                _ = EventWriteTransfer(handle, &descriptor, nil, nil, ULONG(data.count), &data)
+            }
+        }
+    }
+
+    private static func descriptor(_ bytes: UnsafeRawBufferPointer, type: UInt32) -> EVENT_DATA_DESCRIPTOR {
+        var descriptor = EVENT_DATA_DESCRIPTOR()
+        descriptor.Ptr = ULONGLONG(UInt(bitPattern: bytes.baseAddress))
+        descriptor.Size = ULONG(bytes.count)
+        // Type is the low byte of the Reserved union
+        descriptor.Reserved = ULONG(type)
+        return descriptor
+    }
+
+    /// Prefix `body` with its total length (including the 2-byte prefix).
+    private static func sizePrefixed(_ body: [UInt8]) -> [UInt8] {
+        let size = UInt16(body.count + 2)
+        return [UInt8(truncatingIfNeeded: size), UInt8(truncatingIfNeeded: size >> 8)] + body
+    }
+}
+
+#else
+
+/// No platform tracer; intervals only run their body.
+internal enum LuminaTracer {
+    static func begin(_ interval: EventLoopInstrumentation.Interval) {}
+
+    static func end(_ interval: EventLoopInstrumentation.Interval, _ token: Void) {}
+
+    static func mark(_ mark: TraceMark) {}
+}
+
+#endif
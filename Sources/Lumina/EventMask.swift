@@ -0,0 +1,73 @@
+/// Input event categories a window subscribes to.
+///
+/// Platform messages in a masked-out category are dropped at the top of the
+/// backend's translation function, before an `Event` is built or queued, so
+/// unsubscribed windows cost next to nothing per message. Window events
+/// (resize, focus, redraw, close, ...) and user events are always delivered.
+///
+/// Masked-out input is not folded into `keyboardState(for:)` and
+/// `pointerState(for:)` either.
+///
+/// Example:
+/// ```swift
+/// // A tool window that only reacts to window events
+/// app.setEventMask([], for: inspector.id)
+///
+/// // Ignore pointer motion everywhere, but keep clicks and keys
+/// app.eventMask = [.pointerButtons, .wheel, .keyboard, .text]
+/// ```
+///
+/// Platform Notes:
+/// - macOS: Without `.pointerMotion`, the window also stops generating
+///   mouse-moved events (`acceptsMouseMovedEvents` and its tracking area)
+/// - Windows: Messages still arrive at WndProc but are not translated
+public struct EventMask: OptionSet, Sendable {
+    public let rawValue: UInt8
+
+    public init(rawValue: UInt8) {
+        self.rawValue = rawValue
+    }
+
+    /// `.pointer(.moved)`, `.pointer(.entered)` and `.pointer(.left)`.
+    ///
+    /// Raw device motion is controlled separately by `rawPointerInput`.
+    public static let pointerMotion = EventMask(rawValue: 1 << 0)
+
+    /// `.pointer(.buttonPressed)` and `.pointer(.buttonReleased)`.
+    public static let pointerButtons = EventMask(rawValue: 1 << 1)
+
+    /// `.pointer(.wheel)`.
+    public static let wheel = EventMask(rawValue: 1 << 2)
+
+    /// `.keyboard(.keyDown)` and `.keyboard(.keyUp)`.
+    public static let keyboard = EventMask(rawValue: 1 << 3)
+
+    /// `.keyboard(.textInput)`.
+    public static let text = EventMask(rawValue: 1 << 4)
+
+    /// Every input category (the default).
+    public static let all: EventMask = [.pointerMotion, .pointerButtons, .wheel, .keyboard, .text]
+}
+
+extension EventMask {
+    /// The category an event is masked by.
+    ///
+    /// - Returns: The single category containing `event`, or nil for events
+    ///   that are always delivered (window, raw motion, monitor and user events)
+    internal static func category(of event: Event) -> EventMask? {
+        switch event {
+        case .pointer(.moved), .pointer(.entered), .pointer(.left):
+            return .pointerMotion
+        case .pointer(.buttonPressed), .pointer(.buttonReleased):
+            return .pointerButtons
+        case .pointer(.wheel):
+            return .wheel
+        case .keyboard(.keyDown), .keyboard(.keyUp):
+            return .keyboard
+        case .keyboard(.textInput):
+            return .text
+        case .pointer(.rawMotion), .window, .monitorsChanged, .user:
+            return nil
+        }
+    }
+}
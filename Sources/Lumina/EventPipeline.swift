@@ -0,0 +1,333 @@
+/// Main-thread event post-processing shared by the platform backends.
+///
+/// Each backend knows how to pump its OS queue and translate messages; the
+/// pipeline sits between that and the public `poll()`/`drain(into:)` API.
+/// It owns a lookahead buffer of already-translated events, which lets
+/// coalescing look past the event being returned without the backend
+/// having to support peeking.
+///
+/// When coalescing is disabled and the lookahead is empty, `next` calls the
+/// backend's single-event path directly, so the default mode pays nothing.
+///
+/// It also routes events of windows with a dedicated queue (see
+/// `LuminaApp.setWindowEventQueue`) out of the shared stream as batches
+/// are pulled from the backend, so each event is inspected once however
+/// many consumers there are.
+///
+/// Thread Safety: Must only be accessed from @MainActor. It is a reference
+/// type so copies of an application value share one pipeline.
+@MainActor
+internal final class EventPipeline {
+    /// Active coalescing options (empty = disabled)
+    var coalescing: EventCoalescing = []
+
+    /// Per-window options replacing `coalescing` for that window
+    private var windowCoalescing: [WindowID: EventCoalescing] = [:]
+
+    /// Receives every event handed to the application (see `LuminaApp.eventRecorder`)
+    var recorder: EventTraceRecorder?
+
+    /// Counters and trace intervals (see `LuminaApp.instrumentationEnabled`)
+    let instrumentation: EventLoopInstrumentation
+
+    private var coalescer = EventCoalescer()
+    private var lookahead = EventRingBuffer()
+
+    /// Dedicated queues of windows whose events bypass the lookahead
+    private var windowQueues: [WindowID: EventRingBuffer] = [:]
+
+    /// Events waiting in `windowQueues`
+    private var routedCount = 0
+    private var scratch: [EventEnvelope] = []
+
+    /// - Parameter instrumentation: Counters shared with backend code that
+    ///   runs outside the pipeline (window procedures, producer threads)
+    init(instrumentation: EventLoopInstrumentation = EventLoopInstrumentation()) {
+        self.instrumentation = instrumentation
+    }
+
+    /// Whether no already-translated events are waiting in the lookahead.
+    ///
+    /// Backends check this before blocking in `wait()`, since buffered
+    /// events will not wake the OS event loop.
+    var isEmpty: Bool {
+        lookahead.isEmpty && routedCount == 0
+    }
+
+    /// Whether any coalescing (application-wide or per window) is enabled.
+    private var isCoalescing: Bool {
+        !coalescing.isEmpty || !windowCoalescing.isEmpty
+    }
+
+    /// Whether batches must pass through `refill` (to coalesce or route)
+    /// instead of going straight to the caller.
+    private var needsLookahead: Bool {
+        isCoalescing || !windowQueues.isEmpty
+    }
+
+    /// Options in effect for `windowID`.
+    func coalescing(for windowID: WindowID) -> EventCoalescing {
+        windowCoalescing[windowID] ?? coalescing
+    }
+
+    /// Override the options for one window (nil = use the application-wide value).
+    ///
+    /// Backends clear the override when the window closes.
+    func setCoalescing(_ options: EventCoalescing?, for windowID: WindowID) {
+        windowCoalescing[windowID] = options
+    }
+
+    /// Pointer positions for `windowID` seen in the most recent batch.
+    func pointerSamples(for windowID: WindowID) -> [LogicalPosition] {
+        coalescer.pointerSamples[windowID] ?? []
+    }
+
+    /// Buffer an already-translated event ahead of anything still in the backend.
+    ///
+    /// Used when one OS event translates to several Lumina events but the
+    /// backend's single-event path can return only one.
+    func enqueue(_ envelope: EventEnvelope) {
+        if !windowQueues.isEmpty, route(envelope) {
+            return
+        }
+        lookahead.append(envelope)
+    }
+
+    /// Move every already-translated event out of the lookahead and the
+    /// window queues (`run(handler:)` delivers all of them).
+    ///
+    /// - Returns: Number of events moved
+    @discardableResult
+    func drainBuffered(into output: inout [EventEnvelope]) -> Int {
+        var moved = lookahead.drain(into: &output, maxCount: .max)
+        for id in Array(windowQueues.keys) {
+            moved += windowQueues[id]!.drain(into: &output, maxCount: .max)
+        }
+        routedCount = 0
+        return moved
+    }
+
+    // MARK: - Window Queues
+
+    /// Give `windowID` a dedicated queue, or return it to the shared stream.
+    ///
+    /// Events pulled from the backend before the queue was added stay in
+    /// the shared stream; events in the queue move back to it when the
+    /// queue is removed.
+    func setWindowQueue(_ enabled: Bool, for windowID: WindowID) {
+        guard enabled else {
+            if var queue = windowQueues.removeValue(forKey: windowID) {
+                routedCount -= queue.count
+                while let envelope = queue.popFirst() {
+                    lookahead.append(envelope)
+                }
+            }
+            return
+        }
+        if windowQueues[windowID] == nil {
+            windowQueues[windowID] = EventRingBuffer()
+        }
+    }
+
+    /// Whether `windowID` has a dedicated queue.
+    func hasWindowQueue(for windowID: WindowID) -> Bool {
+        windowQueues[windowID] != nil
+    }
+
+    /// Return the next event from `windowID`'s dedicated queue.
+    ///
+    /// Pulls a batch from the backend only when the queue is empty; events
+    /// for other windows in that batch wait for their own consumers.
+    ///
+    /// - Parameters:
+    ///   - windowID: Window with a dedicated queue
+    ///   - drain: Backend batch path; appends up to the given count and returns how many
+    /// - Returns: The window's next event, or nil if none is pending or the
+    ///   window has no dedicated queue
+    func next(
+        for windowID: WindowID,
+        drain: (inout [EventEnvelope], Int) throws -> Int
+    ) rethrows -> EventEnvelope? {
+        guard let queued = windowQueues[windowID]?.isEmpty else {
+            return nil
+        }
+        if queued {
+            try refill(drain)
+        }
+        guard let envelope = windowQueues[windowID]?.popFirst() else {
+            return nil
+        }
+        routedCount -= 1
+        delivered(envelope, for: windowID)
+        return envelope
+    }
+
+    /// Append up to `maxCount` events from `windowID`'s dedicated queue.
+    ///
+    /// - Parameters:
+    ///   - windowID: Window with a dedicated queue
+    ///   - output: Destination array
+    ///   - maxCount: Maximum number of events to append
+    ///   - transform: Conversion from envelope to the caller's element type
+    ///   - drain: Backend batch path; appends up to the given count and returns how many
+    /// - Returns: Number of events appended
+    func drain<T>(
+        for windowID: WindowID,
+        into output: inout [T],
+        maxCount: Int,
+        transform: (EventEnvelope) -> T,
+        drain: (inout [EventEnvelope], Int) throws -> Int
+    ) rethrows -> Int {
+        guard let queued = windowQueues[windowID]?.count else {
+            return 0
+        }
+        if queued < maxCount {
+            try refill(drain)
+        }
+        var moved = 0
+        while moved < maxCount, let envelope = windowQueues[windowID]?.popFirst() {
+            routedCount -= 1
+            moved += 1
+            delivered(envelope, for: windowID)
+            output.append(transform(envelope))
+        }
+        return moved
+    }
+
+    /// Record a delivered window-queue event; the queue of a closed window
+    /// goes away once its `.closed` has been handed out.
+    private func delivered(_ envelope: EventEnvelope, for windowID: WindowID) {
+        recorder?.record(envelope)
+        if case .window(.closed) = envelope.event, let queue = windowQueues.removeValue(forKey: windowID) {
+            routedCount -= queue.count
+        }
+    }
+
+    /// Move `envelope` to its window's dedicated queue, if it has one.
+    ///
+    /// - Returns: Whether the event was routed
+    private func route(_ envelope: EventEnvelope) -> Bool {
+        guard let windowID = envelope.event.windowID, windowQueues[windowID] != nil else {
+            return false
+        }
+        windowQueues[windowID]!.append(envelope)
+        routedCount += 1
+        return true
+    }
+
+    /// Return the next event.
+    ///
+    /// - Parameters:
+    ///   - poll: Backend single-event path, used when nothing needs coalescing
+    ///   - drain: Backend batch path; appends up to the given count and returns how many
+    /// - Returns: The next event, or nil if none are pending
+    func next(
+        poll: () throws -> EventEnvelope?,
+        drain: (inout [EventEnvelope], Int) throws -> Int
+    ) rethrows -> EventEnvelope? {
+        let envelope: EventEnvelope?
+        if let buffered = lookahead.popFirst() {
+            envelope = buffered
+        } else if !needsLookahead {
+            // Without coalescing or routing there is no need to look ahead
+            envelope = try instrumentation.measure(.dequeue, poll)
+        } else {
+            try refill(drain)
+            envelope = lookahead.popFirst()
+        }
+
+        if let recorder, let envelope {
+            recorder.record(envelope)
+        }
+        return envelope
+    }
+
+    /// Append up to `maxCount` events to `output`, converting each envelope
+    /// with `transform`.
+    ///
+    /// - Parameters:
+    ///   - output: Destination array
+    ///   - maxCount: Maximum number of events to append
+    ///   - transform: Conversion from envelope to the caller's element type
+    ///   - drain: Backend batch path; appends up to the given count and returns how many
+    /// - Returns: Number of events appended
+    func drain<T>(
+        into output: inout [T],
+        maxCount: Int,
+        transform: (EventEnvelope) -> T,
+        drain: (inout [EventEnvelope], Int) throws -> Int
+    ) rethrows -> Int {
+        guard let recorder else {
+            return try drainUnrecorded(into: &output, maxCount: maxCount, transform: transform, drain: drain)
+        }
+        return try drainUnrecorded(
+            into: &output,
+            maxCount: maxCount,
+            transform: { envelope in
+                recorder.record(envelope)
+                return transform(envelope)
+            },
+            drain: drain
+        )
+    }
+
+    private func drainUnrecorded<T>(
+        into output: inout [T],
+        maxCount: Int,
+        transform: (EventEnvelope) -> T,
+        drain: (inout [EventEnvelope], Int) throws -> Int
+    ) rethrows -> Int {
+        var moved = lookahead.drain(into: &output, maxCount: maxCount, transform: transform)
+        guard moved < maxCount else {
+            return moved
+        }
+
+        guard needsLookahead else {
+            var batch = takeScratch()
+            defer { returnScratch(&batch) }
+            moved += try instrumentation.measure(.dequeue) { try drain(&batch, maxCount - moved) }
+            instrumentation.noteQueueDepth(batch.count)
+            output.append(contentsOf: batch.lazy.map(transform))
+            return moved
+        }
+
+        // Coalesce and route the whole pending batch; whatever exceeds
+        // maxCount stays in the lookahead for the next call
+        try refill(drain)
+        moved += lookahead.drain(into: &output, maxCount: maxCount - moved, transform: transform)
+        return moved
+    }
+
+    /// Pull every pending event from the backend, coalesce, and buffer it
+    /// in the lookahead or its window's queue.
+    private func refill(_ drain: (inout [EventEnvelope], Int) throws -> Int) rethrows {
+        var batch = takeScratch()
+        defer { returnScratch(&batch) }
+
+        _ = try instrumentation.measure(.dequeue) { try drain(&batch, .max) }
+        let drained = batch.count
+        coalescer.coalesce(&batch, options: coalescing, overrides: windowCoalescing)
+        if windowQueues.isEmpty {
+            lookahead.append(contentsOf: batch)
+        } else {
+            for envelope in batch where !route(envelope) {
+                lookahead.append(envelope)
+            }
+        }
+
+        instrumentation.noteQueueDepth(drained)
+        instrumentation.count(.eventsCoalesced, drained - batch.count)
+    }
+
+    /// Borrow the scratch batch (keeps its capacity across calls).
+    private func takeScratch() -> [EventEnvelope] {
+        var batch: [EventEnvelope] = []
+        swap(&batch, &scratch)
+        return batch
+    }
+
+    private func returnScratch(_ batch: inout [EventEnvelope]) {
+        batch.removeAll(keepingCapacity: true)
+        swap(&batch, &scratch)
+    }
+}
@@ -0,0 +1,241 @@
+import Foundation
+
+/// FIFO storage behind an `EventQueue`.
+///
+/// `RingBuffer` stores any element as is; `EventRingBuffer` packs events
+/// into fixed-size records.
+internal protocol QueueBuffer {
+    associatedtype Element
+
+    init(minimumCapacity: Int)
+
+    var count: Int { get }
+    var isEmpty: Bool { get }
+
+    mutating func append(_ element: Element)
+    mutating func popFirst() -> Element?
+    mutating func drain<T>(into array: inout [T], maxCount: Int, transform: (Element) -> T) -> Int
+    mutating func removeAll()
+}
+
+extension QueueBuffer {
+    /// Append a sequence of elements at the back, in order.
+    mutating func append<S: Sequence>(contentsOf elements: S) where S.Element == Element {
+        for element in elements {
+            append(element)
+        }
+    }
+
+    /// Move up to `maxCount` elements, oldest first, onto the end of `array`.
+    ///
+    /// - Parameters:
+    ///   - array: Destination array; elements are appended in FIFO order
+    ///   - maxCount: Maximum number of elements to move
+    /// - Returns: Number of elements moved
+    @discardableResult
+    mutating func drain(into array: inout [Element], maxCount: Int = .max) -> Int {
+        drain(into: &array, maxCount: maxCount) { $0 }
+    }
+}
+
+/// Growable ring buffer used as the storage behind Lumina's event queues.
+///
+/// RingBuffer is a FIFO with O(1) append and O(1) removal from the front.
+/// Storage is a power-of-two sized array that doubles when full, so once a
+/// queue has reached its steady-state size no further allocation happens.
+/// Draining moves elements out in order without shifting the remainder,
+/// unlike `Array.removeFirst()` which is O(n) per call.
+///
+/// Thread Safety: RingBuffer is a plain value type with no synchronization.
+/// Use `EventQueue` when producers and the consumer live on different threads.
+internal struct RingBuffer<Element>: QueueBuffer {
+    private var storage: ContiguousArray<Element?>
+    private var head: Int = 0
+    private(set) var count: Int = 0
+
+    /// Create an empty ring buffer.
+    ///
+    /// - Parameter minimumCapacity: Initial number of slots (rounded up to a power of two)
+    init(minimumCapacity: Int = 64) {
+        var capacity = 1
+        while capacity < max(minimumCapacity, 1) {
+            capacity <<= 1
+        }
+        self.storage = ContiguousArray(repeating: nil, count: capacity)
+    }
+
+    /// Number of slots currently allocated.
+    var capacity: Int {
+        storage.count
+    }
+
+    /// Whether the buffer holds no elements.
+    var isEmpty: Bool {
+        count == 0
+    }
+
+    /// The oldest element, or nil if the buffer is empty.
+    var first: Element? {
+        isEmpty ? nil : storage[head]
+    }
+
+    /// Append an element at the back, growing the storage if it is full.
+    mutating func append(_ element: Element) {
+        if count == storage.count {
+            grow()
+        }
+        storage[(head + count) & (storage.count - 1)] = element
+        count += 1
+    }
+
+    /// Remove and return the oldest element, or nil if the buffer is empty.
+    mutating func popFirst() -> Element? {
+        guard count > 0 else {
+            return nil
+        }
+        let element = storage[head]
+        storage[head] = nil
+        head = (head + 1) & (storage.count - 1)
+        count -= 1
+        return element
+    }
+
+    /// Move up to `maxCount` elements, oldest first, onto the end of `array`,
+    /// converting each one with `transform`.
+    ///
+    /// - Returns: Number of elements moved
+    @discardableResult
+    mutating func drain<T>(
+        into array: inout [T],
+        maxCount: Int = .max,
+        transform: (Element) -> T
+    ) -> Int {
+        let moved = min(count, max(maxCount, 0))
+        guard moved > 0 else {
+            return 0
+        }
+        array.reserveCapacity(array.count + moved)
+        let mask = storage.count - 1
+        for offset in 0..<moved {
+            let index = (head + offset) & mask
+            array.append(transform(storage[index]!))
+            storage[index] = nil
+        }
+        head = (head + moved) & mask
+        count -= moved
+        return moved
+    }
+
+    /// Remove all elements, keeping the allocated storage.
+    mutating func removeAll() {
+        let mask = storage.count - 1
+        for offset in 0..<count {
+            storage[(head + offset) & mask] = nil
+        }
+        head = 0
+        count = 0
+    }
+
+    /// Double the storage, unwrapping the elements so they start at slot 0.
+    private mutating func grow() {
+        var newStorage = ContiguousArray<Element?>(repeating: nil, count: storage.count * 2)
+        let mask = storage.count - 1
+        for offset in 0..<count {
+            newStorage[offset] = storage[(head + offset) & mask]
+        }
+        storage = newStorage
+        head = 0
+    }
+}
+
+/// Thread-safe FIFO event queue shared by the platform backends.
+///
+/// Producers (WndProc, window delegates, background threads) append events
+/// and the main thread consumes them. Bulk operations (`append(contentsOf:)`,
+/// `drain(into:maxCount:)`) take the lock exactly once, so handing a whole
+/// frame's worth of input to the application costs a single lock round-trip.
+///
+/// The backends queue events in an `EventRingBuffer`, so the lock guards
+/// dense fixed-size records rather than `Event` values.
+internal final class EventQueue<Buffer: QueueBuffer>: @unchecked Sendable {
+    typealias Element = Buffer.Element
+
+    private let lock = NSLock()
+    private var buffer: Buffer
+
+    /// Create an empty queue.
+    ///
+    /// - Parameter minimumCapacity: Initial capacity; the queue grows as needed
+    init(minimumCapacity: Int = 256) {
+        self.buffer = Buffer(minimumCapacity: minimumCapacity)
+    }
+
+    func append(_ element: Element) {
+        lock.lock()
+        defer { lock.unlock() }
+        buffer.append(element)
+    }
+
+    func append<S: Sequence>(contentsOf elements: S) where S.Element == Element {
+        lock.lock()
+        defer { lock.unlock() }
+        buffer.append(contentsOf: elements)
+    }
+
+    func removeFirst() -> Element? {
+        lock.lock()
+        defer { lock.unlock() }
+        return buffer.popFirst()
+    }
+
+    /// Move up to `maxCount` queued elements onto the end of `array` under one lock.
+    ///
+    /// - Returns: Number of elements moved
+    @discardableResult
+    func drain(into array: inout [Element], maxCount: Int = .max) -> Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return buffer.drain(into: &array, maxCount: maxCount)
+    }
+
+    /// Move up to `maxCount` queued elements onto the end of `array` under one
+    /// lock, converting each one with `transform`.
+    ///
+    /// `transform` runs while the lock is held and must not touch the queue.
+    ///
+    /// - Returns: Number of elements moved
+    @discardableResult
+    func drain<T>(
+        into array: inout [T],
+        maxCount: Int = .max,
+        transform: (Element) -> T
+    ) -> Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return buffer.drain(into: &array, maxCount: maxCount, transform: transform)
+    }
+
+    /// Discard every queued element.
+    ///
+    /// - Returns: Number of elements discarded
+    @discardableResult
+    func removeAll() -> Int {
+        lock.lock()
+        defer { lock.unlock() }
+        let discarded = buffer.count
+        buffer.removeAll()
+        return discarded
+    }
+
+    var isEmpty: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return buffer.isEmpty
+    }
+
+    var count: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return buffer.count
+    }
+}
@@ -0,0 +1,227 @@
+/// Fixed-size, trivially copyable encoding of an `Event`.
+///
+/// A record is a tag, a small auxiliary field, the window's raw ID and two
+/// 32-bit payload words; Float payloads are stored by bit pattern. Text is
+/// the only variable-length payload and travels outside the record (the
+/// trace format appends its UTF-8 bytes). User events carry arbitrary
+/// `Sendable` values and have no record encoding.
+///
+/// Used by the event trace format, whose records are this struct's fields
+/// written in little-endian order, and by `EventRingBuffer`, which queues
+/// events as records and keeps text and user payloads beside them.
+internal struct EventRecord: Equatable, BitwiseCopyable {
+    /// Event kind. Raw values are part of the trace format; never reorder.
+    enum Tag: UInt8 {
+        case windowCreated = 1
+        case windowClosed = 2
+        case windowResized = 3
+        case windowMoved = 4
+        case windowFocused = 5
+        case windowUnfocused = 6
+        case scaleFactorChanged = 7
+        case redrawRequested = 8
+        case liveResizeStarted = 9
+        case liveResizeEnded = 10
+        case pointerMoved = 11
+        case pointerEntered = 12
+        case pointerLeft = 13
+        case buttonPressed = 14
+        case buttonReleased = 15
+        case wheel = 16
+        case rawMotion = 17
+        case keyDown = 18
+        case keyUp = 19
+        case textInput = 20
+        case monitorsChanged = 21
+        case occlusionChanged = 22
+        case windowMinimized = 23
+        case windowRestored = 24
+        /// In-memory only (`EventRingBuffer`); traces never contain it
+        case user = 25
+    }
+
+    var tag: Tag
+
+    /// Mouse button (buttonPressed/buttonReleased) or modifier keys (keyDown/keyUp)
+    var aux: UInt8 = 0
+
+    /// `WindowID.rawValue` (0 for events without a window)
+    var window: UInt64 = 0
+
+    /// Payload words; meaning depends on `tag`
+    var first: UInt32 = 0
+    var second: UInt32 = 0
+
+    init(tag: Tag, aux: UInt8 = 0, window: UInt64 = 0, first: UInt32 = 0, second: UInt32 = 0) {
+        self.tag = tag
+        self.aux = aux
+        self.window = window
+        self.first = first
+        self.second = second
+    }
+
+    /// Encode an event.
+    ///
+    /// - Parameter event: The event to encode
+    /// - Returns: The record, and for text input the text to store alongside;
+    ///   nil for user events
+    static func encode(_ event: Event) -> (record: EventRecord, text: String?)? {
+        switch event {
+        case .window(let windowEvent):
+            return (encode(windowEvent), nil)
+
+        case .pointer(let pointerEvent):
+            return (encode(pointerEvent), nil)
+
+        case .keyboard(.keyDown(let id, let key, let modifiers)):
+            return (EventRecord(tag: .keyDown, aux: modifiers.rawValue, window: id.rawValue, first: key.rawValue), nil)
+        case .keyboard(.keyUp(let id, let key, let modifiers)):
+            return (EventRecord(tag: .keyUp, aux: modifiers.rawValue, window: id.rawValue, first: key.rawValue), nil)
+        case .keyboard(.textInput(let id, let text)):
+            return (EventRecord(tag: .textInput, window: id.rawValue), text)
+
+        case .monitorsChanged:
+            return (EventRecord(tag: .monitorsChanged), nil)
+
+        case .user:
+            return nil
+        }
+    }
+
+    private static func encode(_ event: WindowEvent) -> EventRecord {
+        switch event {
+        case .created(let id):
+            return EventRecord(tag: .windowCreated, window: id.rawValue)
+        case .closed(let id):
+            return EventRecord(tag: .windowClosed, window: id.rawValue)
+        case .resized(let id, let size):
+            return EventRecord(tag: .windowResized, window: id.rawValue, first: size.width.bitPattern, second: size.height.bitPattern)
+        case .moved(let id, let position):
+            return EventRecord(tag: .windowMoved, window: id.rawValue, first: position.x.bitPattern, second: position.y.bitPattern)
+        case .focused(let id):
+            return EventRecord(tag: .windowFocused, window: id.rawValue)
+        case .unfocused(let id):
+            return EventRecord(tag: .windowUnfocused, window: id.rawValue)
+        case .scaleFactorChanged(let id, let oldFactor, let newFactor):
+            return EventRecord(tag: .scaleFactorChanged, window: id.rawValue, first: oldFactor.bitPattern, second: newFactor.bitPattern)
+        case .redrawRequested(let id):
+            return EventRecord(tag: .redrawRequested, window: id.rawValue)
+        case .liveResizeStarted(let id):
+            return EventRecord(tag: .liveResizeStarted, window: id.rawValue)
+        case .liveResizeEnded(let id):
+            return EventRecord(tag: .liveResizeEnded, window: id.rawValue)
+        case .occlusionChanged(let id, let isOccluded):
+            return EventRecord(tag: .occlusionChanged, window: id.rawValue, first: isOccluded ? 1 : 0)
+        case .minimized(let id):
+            return EventRecord(tag: .windowMinimized, window: id.rawValue)
+        case .restored(let id):
+            return EventRecord(tag: .windowRestored, window: id.rawValue)
+        }
+    }
+
+    private static func encode(_ event: PointerEvent) -> EventRecord {
+        switch event {
+        case .moved(let id, let position):
+            return EventRecord(tag: .pointerMoved, window: id.rawValue, first: position.x.bitPattern, second: position.y.bitPattern)
+        case .entered(let id):
+            return EventRecord(tag: .pointerEntered, window: id.rawValue)
+        case .left(let id):
+            return EventRecord(tag: .pointerLeft, window: id.rawValue)
+        case .buttonPressed(let id, let button, let position):
+            return EventRecord(
+                tag: .buttonPressed, aux: encode(button), window: id.rawValue,
+                first: position.x.bitPattern, second: position.y.bitPattern
+            )
+        case .buttonReleased(let id, let button, let position):
+            return EventRecord(
+                tag: .buttonReleased, aux: encode(button), window: id.rawValue,
+                first: position.x.bitPattern, second: position.y.bitPattern
+            )
+        case .wheel(let id, let deltaX, let deltaY):
+            return EventRecord(tag: .wheel, window: id.rawValue, first: deltaX.bitPattern, second: deltaY.bitPattern)
+        case .rawMotion(let dx, let dy):
+            return EventRecord(tag: .rawMotion, first: dx.bitPattern, second: dy.bitPattern)
+        }
+    }
+
+    private static func encode(_ button: MouseButton) -> UInt8 {
+        switch button {
+        case .left: return 0
+        case .right: return 1
+        case .middle: return 2
+        }
+    }
+
+    /// Decode the record back into an event.
+    ///
+    /// - Parameter text: The text stored alongside a `.textInput` record
+    /// - Returns: The event, or nil if the record is malformed
+    func event(text: String = "") -> Event? {
+        let id = WindowID(rawValue: window)
+        let firstFloat = Float(bitPattern: first)
+        let secondFloat = Float(bitPattern: second)
+
+        switch tag {
+        case .windowCreated:
+            return .window(.created(id))
+        case .windowClosed:
+            return .window(.closed(id))
+        case .windowResized:
+            return .window(.resized(id, LogicalSize(width: firstFloat, height: secondFloat)))
+        case .windowMoved:
+            return .window(.moved(id, LogicalPosition(x: firstFloat, y: secondFloat)))
+        case .windowFocused:
+            return .window(.focused(id))
+        case .windowUnfocused:
+            return .window(.unfocused(id))
+        case .scaleFactorChanged:
+            return .window(.scaleFactorChanged(id, oldFactor: firstFloat, newFactor: secondFloat))
+        case .redrawRequested:
+            return .window(.redrawRequested(id))
+        case .liveResizeStarted:
+            return .window(.liveResizeStarted(id))
+        case .liveResizeEnded:
+            return .window(.liveResizeEnded(id))
+        case .occlusionChanged:
+            return .window(.occlusionChanged(id, isOccluded: first != 0))
+        case .windowMinimized:
+            return .window(.minimized(id))
+        case .windowRestored:
+            return .window(.restored(id))
+        case .pointerMoved:
+            return .pointer(.moved(id, position: LogicalPosition(x: firstFloat, y: secondFloat)))
+        case .pointerEntered:
+            return .pointer(.entered(id))
+        case .pointerLeft:
+            return .pointer(.left(id))
+        case .buttonPressed:
+            return button.map { .pointer(.buttonPressed(id, button: $0, position: LogicalPosition(x: firstFloat, y: secondFloat))) }
+        case .buttonReleased:
+            return button.map { .pointer(.buttonReleased(id, button: $0, position: LogicalPosition(x: firstFloat, y: secondFloat))) }
+        case .wheel:
+            return .pointer(.wheel(id, deltaX: firstFloat, deltaY: secondFloat))
+        case .rawMotion:
+            return .pointer(.rawMotion(dx: firstFloat, dy: secondFloat))
+        case .keyDown:
+            return .keyboard(.keyDown(id, key: KeyCode(rawValue: first), modifiers: ModifierKeys(rawValue: aux)))
+        case .keyUp:
+            return .keyboard(.keyUp(id, key: KeyCode(rawValue: first), modifiers: ModifierKeys(rawValue: aux)))
+        case .textInput:
+            return .keyboard(.textInput(id, text: text))
+        case .monitorsChanged:
+            return .monitorsChanged
+        case .user:
+            // The payload lives outside the record
+            return nil
+        }
+    }
+
+    private var button: MouseButton? {
+        switch aux {
+        case 0: return .left
+        case 1: return .right
+        case 2: return .middle
+        default: return nil
+        }
+    }
+}
@@ -0,0 +1,161 @@
+/// An event as stored in an `EventRingBuffer`: its record and timestamp.
+///
+/// 32 bytes and trivially copyable, where an `EventEnvelope` is a nested
+/// enum with a `String` and an existential among its payloads, whose
+/// copies retain and release.
+internal struct PackedEvent: BitwiseCopyable {
+    var record: EventRecord
+    var timestamp: UInt64
+
+    /// Filler for unused ring slots
+    static let empty = PackedEvent(record: EventRecord(tag: .monitorsChanged), timestamp: 0)
+}
+
+/// Payload of an event kept outside its record.
+internal enum OutOfLinePayload {
+    case text(String)
+    case user(UserEvent)
+}
+
+/// Growable FIFO of events, stored as dense fixed-size records.
+///
+/// Every event is packed into a `PackedEvent` (`EventRecord` plus the
+/// timestamp), so the ring is one contiguous array of plain values: append
+/// and drain copy 32 bytes without reference counting and without the
+/// optional wrapper `RingBuffer` needs. Text and user events, the only
+/// payloads that don't fit a record, go to a second FIFO; since both
+/// FIFOs are consumed in order, the next out-of-line payload always
+/// belongs to the next `.textInput` or `.user` record.
+///
+/// Events come back as the `EventEnvelope` they went in as; the public
+/// `Event` enum is only materialized when an event leaves the buffer.
+///
+/// Thread Safety: A plain value type with no synchronization, like
+/// `RingBuffer`; `EventQueue<EventRingBuffer>` adds the lock.
+internal struct EventRingBuffer: QueueBuffer {
+    private var records: ContiguousArray<PackedEvent>
+    private var head: Int = 0
+    private(set) var count: Int = 0
+    private var payloads = RingBuffer<OutOfLinePayload>(minimumCapacity: 8)
+
+    /// Create an empty buffer.
+    ///
+    /// - Parameter minimumCapacity: Initial number of records (rounded up to a power of two)
+    init(minimumCapacity: Int = 64) {
+        var capacity = 1
+        while capacity < max(minimumCapacity, 1) {
+            capacity <<= 1
+        }
+        self.records = ContiguousArray(repeating: .empty, count: capacity)
+    }
+
+    /// Number of record slots currently allocated.
+    var capacity: Int {
+        records.count
+    }
+
+    var isEmpty: Bool {
+        count == 0
+    }
+
+    /// Append an event at the back, growing the storage if it is full.
+    mutating func append(_ envelope: EventEnvelope) {
+        if count == records.count {
+            grow()
+        }
+        records[(head + count) & (records.count - 1)] = pack(envelope)
+        count += 1
+    }
+
+    /// Remove and return the oldest event, or nil if the buffer is empty.
+    mutating func popFirst() -> EventEnvelope? {
+        guard count > 0 else {
+            return nil
+        }
+        let packed = records[head]
+        head = (head + 1) & (records.count - 1)
+        count -= 1
+        return unpack(packed)
+    }
+
+    /// Move up to `maxCount` events, oldest first, onto the end of `array`,
+    /// converting each one with `transform`.
+    ///
+    /// - Returns: Number of events moved
+    @discardableResult
+    mutating func drain<T>(
+        into array: inout [T],
+        maxCount: Int = .max,
+        transform: (EventEnvelope) -> T
+    ) -> Int {
+        let moved = min(count, max(maxCount, 0))
+        guard moved > 0 else {
+            return 0
+        }
+        array.reserveCapacity(array.count + moved)
+        let mask = records.count - 1
+        for offset in 0..<moved {
+            array.append(transform(unpack(records[(head + offset) & mask])))
+        }
+        head = (head + moved) & mask
+        count -= moved
+        return moved
+    }
+
+    /// Remove all events, keeping the allocated storage.
+    mutating func removeAll() {
+        // Records hold no references; only the payloads need releasing
+        payloads.removeAll()
+        head = 0
+        count = 0
+    }
+
+    // MARK: - Packing
+
+    private mutating func pack(_ envelope: EventEnvelope) -> PackedEvent {
+        let timestamp = envelope.timestamp.nanoseconds
+        guard let encoded = EventRecord.encode(envelope.event) else {
+            // Only user events lack a record encoding
+            if case .user(let event) = envelope.event {
+                payloads.append(.user(event))
+            }
+            return PackedEvent(record: EventRecord(tag: .user), timestamp: timestamp)
+        }
+        if let text = encoded.text {
+            payloads.append(.text(text))
+        }
+        return PackedEvent(record: encoded.record, timestamp: timestamp)
+    }
+
+    private mutating func unpack(_ packed: PackedEvent) -> EventEnvelope {
+        let timestamp = EventTimestamp(nanoseconds: packed.timestamp)
+        let event: Event
+        switch packed.record.tag {
+        case .user:
+            guard case .user(let userEvent) = payloads.popFirst() else {
+                preconditionFailure("User event record without its payload")
+            }
+            event = .user(userEvent)
+        case .textInput:
+            guard case .text(let text) = payloads.popFirst() else {
+                preconditionFailure("Text input record without its text")
+            }
+            event = .keyboard(.textInput(WindowID(rawValue: packed.record.window), text: text))
+        default:
+            // Records written by encode always decode
+            event = packed.record.event()!
+        }
+        return EventEnvelope(event, timestamp: timestamp)
+    }
+
+    /// Double the storage, unwrapping the records so they start at slot 0.
+    private mutating func grow() {
+        var newRecords = ContiguousArray<PackedEvent>(repeating: .empty, count: records.count * 2)
+        let mask = records.count - 1
+        for offset in 0..<count {
+            newRecords[offset] = records[(head + offset) & mask]
+        }
+        records = newRecords
+        head = 0
+    }
+}
@@ -0,0 +1,89 @@
+/// Batches of events as an `AsyncSequence`, for driving Lumina from Swift
+/// concurrency without a spinning loop.
+///
+/// Each element holds every event that was pending when the iterator
+/// resumed (in delivery order, with coalescing applied), so a burst of
+/// input costs one resumption rather than one per event. While nothing is
+/// pending, the iterator suspends in `LuminaApp.waitAsync()`. The sequence
+/// never finishes on its own; stop iterating (for example on
+/// `.window(.closed)`) to end it.
+///
+/// The stream drives its own copy of the application. Windows, queues and
+/// per-window settings are shared with the original, but app-wide settings
+/// such as `controlFlow` or `eventMask` are captured when the stream is
+/// created.
+///
+/// Example:
+/// ```swift
+/// @MainActor
+/// func runLoop(app: some LuminaApp) async throws {
+///     for try await batch in app.events {
+///         for event in batch {
+///             if case .window(.closed) = event {
+///                 return
+///             }
+///             handle(event)
+///         }
+///     }
+/// }
+/// ```
+public struct LuminaEventStream<App: LuminaApp>: AsyncSequence, Sendable {
+    public typealias Element = [Event]
+
+    private let source: EventStreamSource<App>
+
+    @MainActor
+    init(app: App) {
+        source = EventStreamSource(app: app)
+    }
+
+    public func makeAsyncIterator() -> Iterator {
+        Iterator(source: source)
+    }
+
+    public struct Iterator: AsyncIteratorProtocol {
+        fileprivate let source: EventStreamSource<App>
+
+        public mutating func next() async throws -> [Event]? {
+            try await source.nextBatch()
+        }
+    }
+}
+
+/// Main-actor state behind `LuminaEventStream`; iterators hop here to
+/// touch the application.
+@MainActor
+private final class EventStreamSource<App: LuminaApp>: Sendable {
+    private var app: App
+
+    /// Reused between batches; each batch hands out a copy
+    private var batch: [Event] = []
+
+    init(app: App) {
+        self.app = app
+    }
+
+    func nextBatch() async throws -> [Event] {
+        while true {
+            batch.removeAll(keepingCapacity: true)
+            try app.drain(into: &batch)
+            if !batch.isEmpty {
+                return batch
+            }
+            // Wait on a copy: `app` must not stay accessed across the
+            // suspension, where other main-actor work may run
+            let waiter = app
+            try await waiter.waitAsync()
+        }
+    }
+}
+
+@MainActor
+extension LuminaApp {
+    /// Pending events as an `AsyncSequence` of batches.
+    ///
+    /// See `LuminaEventStream`.
+    public var events: LuminaEventStream<Self> {
+        LuminaEventStream(app: self)
+    }
+}
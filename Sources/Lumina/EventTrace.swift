@@ -0,0 +1,486 @@
+#if os(macOS)
+import Darwin
+#elseif os(Windows)
+import WinSDK
+#else
+import Glibc
+#endif
+
+/// Event trace recording and loading.
+///
+/// A trace is a compact binary log of the events an application received,
+/// for reproducing input-driven bugs and performance regressions and for
+/// driving `ReplayApplication` in headless CI runs.
+///
+/// Format (little-endian):
+/// - Header, 16 bytes: magic `LUTR`, version (UInt16), record size
+///   (UInt16, 32), reserved (8 bytes)
+/// - Records, 32 bytes each: timestamp in nanoseconds (UInt64), window
+///   raw ID (UInt64), tag (UInt8), aux (UInt8), text length (UInt16), two
+///   payload words (UInt32), reserved (UInt32); see `EventRecord`
+/// - A `.textInput` record is followed by its UTF-8 text
+///
+/// A zero tag ends the trace, so a file cut short by a crash (whose mapped
+/// tail is zero-filled) still loads up to the last complete record.
+
+// MARK: - Recording
+
+/// Records the events an application delivers to a trace file.
+///
+/// Attach it with `LuminaApp.eventRecorder`; every event returned by
+/// `poll()`/`pollEnvelope()`/`drain(into:)` or passed to the
+/// `run(handler:)` handler is appended with its timestamp. The file is
+/// memory-mapped and grown geometrically, so recording costs a copy into
+/// the mapping per event and no system call in the common case.
+///
+/// User events are not recorded: their payloads are arbitrary `Sendable`
+/// values with no binary form. They are counted in `skippedCount`.
+///
+/// Example:
+/// ```swift
+/// app.eventRecorder = try EventTraceRecorder.create(path: "session.lutr").get()
+/// try app.run { event in handle(event) }
+/// app.eventRecorder?.finish()
+/// ```
+@MainActor
+public final class EventTraceRecorder {
+    private let file: MappedAppendFile
+    private var scratch: [UInt8] = []
+
+    /// Number of events written
+    public private(set) var recordedCount = 0
+
+    /// Number of events that could not be recorded (user events)
+    public private(set) var skippedCount = 0
+
+    private init(file: MappedAppendFile) {
+        self.file = file
+    }
+
+    /// Create (or truncate) a trace file and start recording.
+    ///
+    /// - Parameter path: File system path of the trace
+    /// - Returns: The recorder, or an error if the file could not be created or mapped
+    public static func create(path: String) -> Result<EventTraceRecorder, LuminaError> {
+        MappedAppendFile.create(path: path, initialCapacity: 1 << 16).flatMap { file in
+            var header: [UInt8] = []
+            EventTraceFormat.appendHeader(to: &header)
+            guard file.append(header) else {
+                return .failure(file.lastError)
+            }
+            return .success(EventTraceRecorder(file: file))
+        }
+    }
+
+    /// Append one event.
+    func record(_ envelope: EventEnvelope) {
+        scratch.removeAll(keepingCapacity: true)
+        guard EventTraceFormat.append(envelope, to: &scratch), file.append(scratch) else {
+            skippedCount += 1
+            return
+        }
+        recordedCount += 1
+    }
+
+    /// Write the mapped pages back to the file without closing it.
+    public func flush() {
+        file.sync()
+    }
+
+    /// Trim the file to the recorded length and close it.
+    ///
+    /// Also happens when the recorder is deallocated. Later events are not
+    /// recorded.
+    public func finish() {
+        file.finish()
+    }
+}
+
+// MARK: - Loading
+
+/// A recorded sequence of events.
+///
+/// Example:
+/// ```swift
+/// let trace = try EventTrace.load(path: "session.lutr").get()
+/// print("\(trace.events.count) events over \(trace.duration)")
+/// ```
+public struct EventTrace: Sendable {
+    /// The recorded events with their original timestamps, in delivery order
+    public let events: [EventEnvelope]
+
+    /// Create a trace from events (to replay synthesized input).
+    ///
+    /// - Parameter events: Events in delivery order
+    public init(events: [EventEnvelope]) {
+        self.events = events
+    }
+
+    /// Time between the first and last event.
+    public var duration: Duration {
+        guard let first = events.first, let last = events.last else {
+            return .zero
+        }
+        return first.timestamp.duration(to: last.timestamp)
+    }
+
+    /// Load a trace written by `EventTraceRecorder`.
+    ///
+    /// - Parameter path: File system path of the trace
+    /// - Returns: The trace, or an error if the file is unreadable or not a trace
+    public static func load(path: String) -> Result<EventTrace, LuminaError> {
+        readFile(path: path).flatMap { bytes in
+            bytes.withUnsafeBytes { EventTraceFormat.decode($0) }
+        }.map(EventTrace.init(events:))
+    }
+}
+
+// MARK: - Format
+
+/// Encoding and decoding of the trace format, independent of file I/O.
+internal enum EventTraceFormat {
+    static let magic: [UInt8] = Array("LUTR".utf8)
+    static let version: UInt16 = 1
+    static let headerSize = 16
+    static let recordSize = 32
+
+    static func appendHeader(to bytes: inout [UInt8]) {
+        bytes.append(contentsOf: magic)
+        appendInteger(version, to: &bytes)
+        appendInteger(UInt16(recordSize), to: &bytes)
+        appendInteger(UInt64(0), to: &bytes)
+    }
+
+    /// Append the record (and text) for `envelope`.
+    ///
+    /// - Returns: false if the event has no record encoding (user events)
+    static func append(_ envelope: EventEnvelope, to bytes: inout [UInt8]) -> Bool {
+        guard let encoded = EventRecord.encode(envelope.event) else {
+            return false
+        }
+        let record = encoded.record
+
+        // Longer text is cut at a character boundary to fit the length field
+        var utf8 = Array((encoded.text ?? "").utf8)
+        if utf8.count > Int(UInt16.max) {
+            var end = Int(UInt16.max)
+            while end > 0 && UTF8.isContinuation(utf8[end]) {
+                end -= 1
+            }
+            utf8.removeSubrange(end...)
+        }
+
+        appendInteger(envelope.timestamp.nanoseconds, to: &bytes)
+        appendInteger(record.window, to: &bytes)
+        bytes.append(record.tag.rawValue)
+        bytes.append(record.aux)
+        appendInteger(UInt16(utf8.count), to: &bytes)
+        appendInteger(record.first, to: &bytes)
+        appendInteger(record.second, to: &bytes)
+        appendInteger(UInt32(0), to: &bytes)
+        bytes.append(contentsOf: utf8)
+        return true
+    }
+
+    /// Decode a whole trace.
+    static func decode(_ bytes: UnsafeRawBufferPointer) -> Result<[EventEnvelope], LuminaError> {
+        guard bytes.count >= headerSize, bytes.prefix(4).elementsEqual(magic) else {
+            return .failure(.invalidState("Not an event trace (bad magic)"))
+        }
+        let fileVersion = readInteger(UInt16.self, from: bytes, at: 4)
+        let fileRecordSize = Int(readInteger(UInt16.self, from: bytes, at: 6))
+        guard fileVersion == version, fileRecordSize == recordSize else {
+            return .failure(.invalidState("Unsupported event trace version \(fileVersion)"))
+        }
+
+        var events: [EventEnvelope] = []
+        var offset = headerSize
+        while offset + recordSize <= bytes.count {
+            let rawTag = bytes[offset + 16]
+            guard rawTag != 0 else {
+                break  // Unwritten tail
+            }
+            let textLength = Int(readInteger(UInt16.self, from: bytes, at: offset + 18))
+            guard let tag = EventRecord.Tag(rawValue: rawTag), offset + recordSize + textLength <= bytes.count else {
+                return .failure(.invalidState("Corrupt event trace record at offset \(offset)"))
+            }
+
+            let record = EventRecord(
+                tag: tag,
+                aux: bytes[offset + 17],
+                window: readInteger(UInt64.self, from: bytes, at: offset + 8),
+                first: readInteger(UInt32.self, from: bytes, at: offset + 20),
+                second: readInteger(UInt32.self, from: bytes, at: offset + 24)
+            )
+            let textStart = offset + recordSize
+            let text = textLength == 0 ? "" : String(decoding: bytes[textStart..<(textStart + textLength)], as: UTF8.self)
+
+            guard let event = record.event(text: text) else {
+                return .failure(.invalidState("Corrupt event trace record at offset \(offset)"))
+            }
+            let timestamp = EventTimestamp(nanoseconds: readInteger(UInt64.self, from: bytes, at: offset))
+            events.append(EventEnvelope(event, timestamp: timestamp))
+            offset = textStart + textLength
+        }
+        return .success(events)
+    }
+
+    private static func appendInteger<T: FixedWidthInteger>(_ value: T, to bytes: inout [UInt8]) {
+        withUnsafeBytes(of: value.littleEndian) { bytes.append(contentsOf: $0) }
+    }
+
+    private static func readInteger<T: FixedWidthInteger>(_ type: T.Type, from bytes: UnsafeRawBufferPointer, at offset: Int) -> T {
+        T(littleEndian: bytes.loadUnaligned(fromByteOffset: offset, as: T.self))
+    }
+}
+
+// MARK: - File I/O
+
+/// Append-only file written through a growing memory mapping.
+///
+/// The file is sized to the mapping's capacity while open and trimmed to
+/// the written length by `finish()`.
+internal final class MappedAppendFile {
+    /// Bytes written so far
+    private(set) var length = 0
+    private var capacity = 0
+    private var base: UnsafeMutableRawPointer?
+
+    /// Error of the latest failed operation
+    private(set) var lastError = LuminaError.invalidState("Trace file is closed")
+
+    #if os(Windows)
+    private var file: HANDLE?
+    private var mapping: HANDLE?
+    #else
+    private var descriptor: Int32 = -1
+    #endif
+
+    private init() {}
+
+    deinit {
+        finish()
+    }
+
+    /// Create (or truncate) a file and map its first `initialCapacity` bytes.
+    static func create(path: String, initialCapacity: Int) -> Result<MappedAppendFile, LuminaError> {
+        let mapped = MappedAppendFile()
+        #if os(Windows)
+        let handle = path.withCString(encodedAs: UTF16.self) { pathPtr in
+            CreateFileW(
+                pathPtr,
+                DWORD(GENERIC_READ) | DWORD(GENERIC_WRITE),
+                DWORD(FILE_SHARE_READ),
+                nil,
+                DWORD(CREATE_ALWAYS),
+                DWORD(FILE_ATTRIBUTE_NORMAL),
+                nil
+            )
+        }
+        guard let handle, handle != INVALID_HANDLE_VALUE else {
+            return .failure(platformError("CreateFileW"))
+        }
+        mapped.file = handle
+        #else
+        let descriptor = open(path, O_RDWR | O_CREAT | O_TRUNC, 0o644)
+        guard descriptor >= 0 else {
+            return .failure(platformError("open"))
+        }
+        mapped.descriptor = descriptor
+        #endif
+
+        guard mapped.map(capacity: initialCapacity) else {
+            return .failure(mapped.lastError)
+        }
+        return .success(mapped)
+    }
+
+    /// Append bytes, growing the mapping if needed.
+    ///
+    /// - Returns: false if the file is closed or could not grow
+    func append(_ bytes: [UInt8]) -> Bool {
+        guard base != nil else {
+            return false
+        }
+        if length + bytes.count > capacity {
+            var newCapacity = capacity * 2
+            while length + bytes.count > newCapacity {
+                newCapacity *= 2
+            }
+            unmap()
+            guard map(capacity: newCapacity) else {
+                return false
+            }
+        }
+        guard let base else {
+            return false
+        }
+        bytes.withUnsafeBytes { source in
+            (base + length).copyMemory(from: source.baseAddress!, byteCount: source.count)
+        }
+        length += bytes.count
+        return true
+    }
+
+    /// Write dirty pages back to the file.
+    func sync() {
+        guard let base, length > 0 else {
+            return
+        }
+        #if os(Windows)
+        FlushViewOfFile(base, SIZE_T(length))
+        #else
+        msync(base, length, MS_ASYNC)
+        #endif
+    }
+
+    /// Unmap, trim the file to `length` and close it (idempotent).
+    func finish() {
+        unmap()
+        #if os(Windows)
+        guard let file else {
+            return
+        }
+        var distance = LARGE_INTEGER()
+        distance.QuadPart = LONGLONG(length)
+        SetFilePointerEx(file, distance, nil, DWORD(FILE_BEGIN))
+        SetEndOfFile(file)
+        CloseHandle(file)
+        self.file = nil
+        #else
+        guard descriptor >= 0 else {
+            return
+        }
+        _ = ftruncate(descriptor, off_t(length))
+        _ = close(descriptor)
+        descriptor = -1
+        #endif
+    }
+
+    /// Size the file to `newCapacity` and map all of it.
+    private func map(capacity newCapacity: Int) -> Bool {
+        #if os(Windows)
+        guard let file else {
+            return false
+        }
+        let size = UInt64(newCapacity)
+        guard let newMapping = CreateFileMappingW(
+            file, nil, DWORD(PAGE_READWRITE),
+            DWORD(truncatingIfNeeded: size >> 32), DWORD(truncatingIfNeeded: size), nil
+        ) else {
+            lastError = MappedAppendFile.platformError("CreateFileMappingW")
+            return false
+        }
+        guard let view = MapViewOfFile(newMapping, DWORD(FILE_MAP_WRITE), 0, 0, SIZE_T(newCapacity)) else {
+            lastError = MappedAppendFile.platformError("MapViewOfFile")
+            CloseHandle(newMapping)
+            return false
+        }
+        mapping = newMapping
+        base = view
+        #else
+        guard descriptor >= 0 else {
+            return false
+        }
+        guard ftruncate(descriptor, off_t(newCapacity)) == 0 else {
+            lastError = MappedAppendFile.platformError("ftruncate")
+            return false
+        }
+        let view = mmap(nil, newCapacity, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0)
+        guard let view, view != MAP_FAILED else {
+            lastError = MappedAppendFile.platformError("mmap")
+            return false
+        }
+        base = view
+        #endif
+        capacity = newCapacity
+        return true
+    }
+
+    private func unmap() {
+        guard let base else {
+            return
+        }
+        #if os(Windows)
+        UnmapViewOfFile(base)
+        if let mapping {
+            CloseHandle(mapping)
+        }
+        mapping = nil
+        #else
+        munmap(base, capacity)
+        #endif
+        self.base = nil
+    }
+
+    /// The error of a failed system call.
+    fileprivate static func platformError(_ operation: String) -> LuminaError {
+        #if os(Windows)
+        return .platformError(platform: "Windows", operation: operation, code: Int(GetLastError()))
+        #elseif os(macOS)
+        return .platformError(platform: "macOS", operation: operation, code: Int(errno))
+        #else
+        return .platformError(platform: "Linux", operation: operation, code: Int(errno))
+        #endif
+    }
+}
+
+/// Read a whole file.
+private func readFile(path: String) -> Result<[UInt8], LuminaError> {
+    #if os(Windows)
+    let handle = path.withCString(encodedAs: UTF16.self) { pathPtr in
+        CreateFileW(
+            pathPtr,
+            DWORD(GENERIC_READ),
+            DWORD(FILE_SHARE_READ),
+            nil,
+            DWORD(OPEN_EXISTING),
+            DWORD(FILE_ATTRIBUTE_NORMAL),
+            nil
+        )
+    }
+    guard let handle, handle != INVALID_HANDLE_VALUE else {
+        return .failure(MappedAppendFile.platformError("CreateFileW"))
+    }
+    defer { CloseHandle(handle) }
+
+    var size = LARGE_INTEGER()
+    guard GetFileSizeEx(handle, &size) else {
+        return .failure(MappedAppendFile.platformError("GetFileSizeEx"))
+    }
+    var bytes = [UInt8](repeating: 0, count: Int(size.QuadPart))
+    var total = 0
+    while total < bytes.count {
+        var read: DWORD = 0
+        let remaining = DWORD(min(bytes.count - total, 1 << 30))
+        let ok = bytes.withUnsafeMutableBytes { buffer in
+            ReadFile(handle, buffer.baseAddress! + total, remaining, &read, nil)
+        }
+        guard ok, read > 0 else {
+            return .failure(MappedAppendFile.platformError("ReadFile"))
+        }
+        total += Int(read)
+    }
+    return .success(bytes)
+    #else
+    let descriptor = open(path, O_RDONLY)
+    guard descriptor >= 0 else {
+        return .failure(MappedAppendFile.platformError("open"))
+    }
+    defer { _ = close(descriptor) }
+
+    var bytes: [UInt8] = []
+    var chunk = [UInt8](repeating: 0, count: 1 << 16)
+    while true {
+        let count = chunk.withUnsafeMutableBytes { read(descriptor, $0.baseAddress, $0.count) }
+        guard count >= 0 else {
+            return .failure(MappedAppendFile.platformError("read"))
+        }
+        guard count > 0 else {
+            break
+        }
+        bytes.append(contentsOf: chunk.prefix(count))
+    }
+    return .success(bytes)
+    #endif
+}
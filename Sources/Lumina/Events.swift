@@ -29,6 +29,33 @@ public enum Event: Sendable {
 
     /// User-defined custom event
     case user(UserEvent)
+
+    /// The set of monitors or their geometry/scale changed.
+    ///
+    /// Sent when displays are connected, disconnected, rearranged or
+    /// rescaled. `Monitor.all()` and `Monitor.primary()` return the new
+    /// configuration from then on; previously fetched `Monitor` values are
+    /// stale. Repeated changes before the list is read again are reported
+    /// once.
+    case monitorsChanged
+}
+
+extension Event {
+    /// The window an event belongs to (nil for raw motion, monitor changes
+    /// and user events).
+    internal var windowID: WindowID? {
+        switch self {
+        case .window(let event):
+            return event.windowID
+        case .pointer(let event):
+            return event.windowID
+        case .keyboard(.keyDown(let id, _, _)), .keyboard(.keyUp(let id, _, _)),
+             .keyboard(.textInput(let id, _)):
+            return id
+        case .user, .monitorsChanged:
+            return nil
+        }
+    }
 }
 
 // MARK: - Window Events
@@ -110,6 +137,81 @@ public enum WindowEvent: Sendable {
     ///   - oldFactor: Previous scale factor
     ///   - newFactor: New scale factor
     case scaleFactorChanged(WindowID, oldFactor: Float, newFactor: Float)
+
+    /// Window content should be redrawn.
+    ///
+    /// Sent after `LuminaWindow.requestRedraw()` and when the system needs
+    /// the window's content (for example after it was uncovered). Requests
+    /// are coalesced: any number of calls before the next display refresh
+    /// produce a single event, paced to the refresh of the window's display.
+    /// Render one frame in response and call `requestRedraw()` again to
+    /// keep animating.
+    ///
+    /// - Parameter windowID: ID of the window to redraw
+    case redrawRequested(WindowID)
+
+    /// The user started an interactive resize or move of the window.
+    ///
+    /// Until `.liveResizeEnded`, the window reports every intermediate size
+    /// and position. Enable `.resize` coalescing to receive only the latest
+    /// ones per batch, and defer expensive work (swapchain recreation,
+    /// relayout) until the drag ends.
+    ///
+    /// - Parameter windowID: ID of the window being resized
+    case liveResizeStarted(WindowID)
+
+    /// The user finished an interactive resize or move of the window.
+    ///
+    /// The window's final size and position have been reported before this
+    /// event.
+    ///
+    /// - Parameter windowID: ID of the resized window
+    case liveResizeEnded(WindowID)
+
+    /// The window became entirely hidden from the user, or visible again.
+    ///
+    /// A window is occluded while no part of it can be seen: covered by
+    /// other windows, on another Space or virtual desktop, or ordered out.
+    /// Occluded windows receive no `.redrawRequested` ticks; requests made
+    /// meanwhile are answered once the window is visible again, so an
+    /// animation loop resumes by itself.
+    ///
+    /// Implementation notes:
+    /// - macOS: `windowDidChangeOcclusionState`
+    /// - Windows: DWM cloaking (`EVENT_OBJECT_CLOAKED`); Windows does not
+    ///   report windows covered by others
+    ///
+    /// - Parameters:
+    ///   - windowID: ID of the affected window
+    ///   - isOccluded: Whether the window is now hidden from the user
+    case occlusionChanged(WindowID, isOccluded: Bool)
+
+    /// The window was minimized to the Dock or taskbar.
+    ///
+    /// Its size is not reported as changed. Like occluded windows,
+    /// minimized windows receive no `.redrawRequested` ticks until
+    /// `.restored`.
+    ///
+    /// - Parameter windowID: ID of the minimized window
+    case minimized(WindowID)
+
+    /// The window came back from being minimized.
+    ///
+    /// - Parameter windowID: ID of the restored window
+    case restored(WindowID)
+}
+
+extension WindowEvent {
+    /// The window the event belongs to.
+    internal var windowID: WindowID {
+        switch self {
+        case .created(let id), .closed(let id), .resized(let id, _), .moved(let id, _),
+             .focused(let id), .unfocused(let id), .scaleFactorChanged(let id, _, _),
+             .redrawRequested(let id), .liveResizeStarted(let id), .liveResizeEnded(let id),
+             .occlusionChanged(let id, _), .minimized(let id), .restored(let id):
+            return id
+        }
+    }
 }
 
 // MARK: - Pointer Events
@@ -188,6 +290,19 @@ public enum PointerEvent: Sendable {
     ///   - deltaX: Horizontal scroll amount (positive = right, negative = left)
     ///   - deltaY: Vertical scroll amount (positive = down, negative = up)
     case wheel(WindowID, deltaX: Float, deltaY: Float)
+
+    /// Relative motion reported by the pointing device itself.
+    ///
+    /// Only sent while `LuminaApp.rawPointerInput` is enabled. Unlike
+    /// `.moved`, deltas are not clamped to whole pixels, to the window, or
+    /// to the screen edges, and arrive at the device's polling rate, which
+    /// makes them suitable for FPS-style camera control. Raw motion is
+    /// device-level and not associated with a window.
+    ///
+    /// - Parameters:
+    ///   - dx: Horizontal motion in device units (positive = right)
+    ///   - dy: Vertical motion in device units (positive = down)
+    case rawMotion(dx: Float, dy: Float)
 }
 
 /// Mouse button enumeration.
@@ -205,6 +320,19 @@ public enum MouseButton: Sendable {
     case middle
 }
 
+extension PointerEvent {
+    /// The window the event belongs to (nil for raw motion).
+    internal var windowID: WindowID? {
+        switch self {
+        case .moved(let id, _), .entered(let id), .left(let id),
+             .buttonPressed(let id, _, _), .buttonReleased(let id, _, _), .wheel(let id, _, _):
+            return id
+        case .rawMotion:
+            return nil
+        }
+    }
+}
+
 // MARK: - Keyboard Events
 
 /// Keyboard input events.
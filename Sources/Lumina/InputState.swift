@@ -0,0 +1,180 @@
+/// Snapshot of which keys are held in a window.
+///
+/// Backends keep one per window and update it as key messages are
+/// translated, so `LuminaApp.keyboardState(for:)` answers "is W held right
+/// now?" in O(1) without replaying the event stream.
+///
+/// The state is reset when the window loses focus, since key releases are
+/// delivered to whichever window has focus at the time.
+///
+/// Example:
+/// ```swift
+/// let keyboard = app.keyboardState(for: windowID)
+/// if keyboard.isPressed(KeyCode(rawValue: 0x0D)) {  // W on macOS
+///     player.moveForward()
+/// }
+/// if keyboard.modifiers.contains(.shift) {
+///     player.sprint()
+/// }
+/// ```
+public struct KeyboardState: Sendable, Equatable {
+    /// One bit per key slot (see `slot(for:)`)
+    private var bits = SIMD8<UInt64>()
+
+    /// Modifier keys held as of the latest key event
+    public internal(set) var modifiers: ModifierKeys = []
+
+    /// Create an empty state (no keys held).
+    public init() {}
+
+    /// Whether `key` is currently held.
+    ///
+    /// - Parameter key: Physical key code as reported by `.keyDown`
+    /// - Returns: true between the key's keyDown and keyUp
+    public func isPressed(_ key: KeyCode) -> Bool {
+        guard let slot = KeyboardState.slot(for: key) else {
+            return false
+        }
+        return bits[slot >> 6] & (1 << UInt64(slot & 63)) != 0
+    }
+
+    /// Whether no keys are held.
+    public var isEmpty: Bool {
+        bits == SIMD8()
+    }
+
+    /// Number of keys currently held.
+    public var pressedCount: Int {
+        var count = 0
+        for lane in 0..<bits.scalarCount {
+            count += bits[lane].nonzeroBitCount
+        }
+        return count
+    }
+
+    /// Record a key transition.
+    internal mutating func setPressed(_ key: KeyCode, _ pressed: Bool) {
+        guard let slot = KeyboardState.slot(for: key) else {
+            return
+        }
+        let mask: UInt64 = 1 << UInt64(slot & 63)
+        if pressed {
+            bits[slot >> 6] |= mask
+        } else {
+            bits[slot >> 6] &= ~mask
+        }
+    }
+
+    /// Bit index for a key code.
+    ///
+    /// macOS virtual key codes (< 0x80) and Windows scan codes (< 0x100) map
+    /// to themselves; Windows extended scan codes (0xE0xx) use the upper 256
+    /// slots. Other codes are not tracked.
+    private static func slot(for key: KeyCode) -> Int? {
+        let raw = key.rawValue
+        if raw < 0x100 {
+            return Int(raw)
+        }
+        if raw & 0xFF00 == 0xE000 {
+            return 0x100 | Int(raw & 0xFF)
+        }
+        return nil
+    }
+}
+
+/// Snapshot of the pointer over a window.
+///
+/// Updated as pointer messages are translated; see
+/// `LuminaApp.pointerState(for:)`.
+public struct PointerState: Sendable, Equatable {
+    /// Last pointer position reported in the window (logical coordinates),
+    /// or nil before the first pointer event
+    public internal(set) var position: LogicalPosition?
+
+    /// Whether the pointer is inside the window's content area
+    public internal(set) var isInside = false
+
+    /// One bit per `MouseButton`
+    private var buttons: UInt8 = 0
+
+    /// Create an empty state (pointer outside, no buttons held).
+    public init() {}
+
+    /// Whether `button` is currently held.
+    ///
+    /// - Parameter button: The mouse button to query
+    /// - Returns: true between the button's press and release
+    public func isPressed(_ button: MouseButton) -> Bool {
+        buttons & PointerState.mask(for: button) != 0
+    }
+
+    /// Whether any mouse button is held.
+    public var isAnyButtonPressed: Bool {
+        buttons != 0
+    }
+
+    internal mutating func setPressed(_ button: MouseButton, _ pressed: Bool) {
+        if pressed {
+            buttons |= PointerState.mask(for: button)
+        } else {
+            buttons &= ~PointerState.mask(for: button)
+        }
+    }
+
+    internal mutating func releaseAllButtons() {
+        buttons = 0
+    }
+
+    private static func mask(for button: MouseButton) -> UInt8 {
+        switch button {
+        case .left: return 1 << 0
+        case .right: return 1 << 1
+        case .middle: return 1 << 2
+        }
+    }
+}
+
+/// Per-window keyboard and pointer state kept by the backends.
+internal struct WindowInputState {
+    var keyboard = KeyboardState()
+    var pointer = PointerState()
+
+    /// Fold a translated event into the state.
+    mutating func apply(_ event: Event) {
+        switch event {
+        case .keyboard(.keyDown(_, let key, let modifiers)):
+            keyboard.setPressed(key, true)
+            keyboard.modifiers = modifiers
+
+        case .keyboard(.keyUp(_, let key, let modifiers)):
+            keyboard.setPressed(key, false)
+            keyboard.modifiers = modifiers
+
+        case .pointer(.moved(_, let position)):
+            pointer.position = position
+            pointer.isInside = true
+
+        case .pointer(.entered):
+            pointer.isInside = true
+
+        case .pointer(.left):
+            pointer.isInside = false
+
+        case .pointer(.buttonPressed(_, let button, let position)):
+            pointer.setPressed(button, true)
+            pointer.position = position
+
+        case .pointer(.buttonReleased(_, let button, let position)):
+            pointer.setPressed(button, false)
+            pointer.position = position
+
+        case .window(.unfocused):
+            // Releases go to the newly focused window; don't leave keys stuck
+            keyboard = KeyboardState()
+            pointer.releaseAllButtons()
+
+        default:
+            break
+        }
+    }
+}
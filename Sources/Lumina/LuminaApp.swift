@@ -4,6 +4,21 @@
 /// when a window has been closed, allowing it to clean up the window registry.
 internal typealias WindowCloseCallback = @MainActor (WindowID) -> Void
 
+/// Handler for `LuminaApp.run(handler:)`, called once per event.
+///
+/// Returns how the loop should continue once pending events run out:
+/// `.wait` to sleep until more arrive, `.waitUntil` to also wake at a
+/// deadline (acting like `.wait` after it passes), `.poll` to keep pumping
+/// without sleeping, or `.exit` to make `run(handler:)` return. The handler
+/// is only called for events; drive per-frame work with `requestRedraw()`.
+public typealias EventHandler = @MainActor (Event) -> ControlFlow
+
+/// Handler invoked while the OS runs a modal loop that blocks `poll()`.
+///
+/// Receives the events that arrived since the previous invocation, as
+/// `drain(into:)` would return them. See `LuminaApp.modalLoopHandler`.
+public typealias ModalLoopHandler = @MainActor ([Event]) -> Void
+
 /// Protocol for Lumina applications.
 ///
 /// This is the main entry point for creating Lumina applications. Create an instance
@@ -59,7 +74,8 @@ public protocol LuminaApp: Sendable {
     ///
     /// This method blocks the calling thread and processes events continuously
     /// until quit() is called. It should return when the application is ready
-    /// to terminate.
+    /// to terminate. Events are pumped but not delivered anywhere; use
+    /// `run(handler:)` to receive them.
     ///
     /// The event loop processes:
     /// - Window events (resize, close, focus changes)
@@ -70,6 +86,45 @@ public protocol LuminaApp: Sendable {
     ///           an unrecoverable error
     mutating func run() throws
 
+    /// Run the event loop, handing every event to `handler` (blocking).
+    ///
+    /// Events are dispatched where the backend translates them (WndProc on
+    /// Windows, right after `NSApp.sendEvent` on macOS) rather than queued
+    /// for `poll()`, so the blocking loop needs no polling on top.
+    /// Coalescing does not apply, since events are never batched.
+    ///
+    /// The handler's return value controls the loop: it sleeps as requested
+    /// once no events are pending, and returns after `.exit` or `quit()`.
+    /// The loop starts out with `controlFlow`. Events that arrive after
+    /// `.exit` stay queued for `poll()`.
+    ///
+    /// Example:
+    /// ```swift
+    /// try app.run { event in
+    ///     switch event {
+    ///     case .window(.closed):
+    ///         return .exit
+    ///     case .window(.redrawRequested(let id)):
+    ///         renderer.drawFrame(for: id)
+    ///         windows[id]?.requestRedraw()
+    ///         return .wait
+    ///     default:
+    ///         return .wait
+    ///     }
+    /// }
+    /// ```
+    ///
+    /// Platform Notes:
+    /// - Windows: The handler keeps receiving events during modal
+    ///   size/move loops, since those dispatch through WndProc
+    /// - macOS: During live resize, queued events are delivered from the
+    ///   window's display link
+    ///
+    /// - Parameter handler: Called once per event, in delivery order
+    /// - Throws: `LuminaError.eventLoopFailed` if the event loop encounters
+    ///           an unrecoverable error
+    mutating func run(handler: EventHandler) throws
+
     /// Poll for the next event without blocking.
     ///
     /// Returns the next pending event and removes it from the queue, or returns
@@ -93,6 +148,113 @@ public protocol LuminaApp: Sendable {
     /// - Throws: `LuminaError.eventLoopFailed` if polling fails
     mutating func poll() throws -> Event?
 
+    /// Poll for the next event and the time it occurred, without blocking.
+    ///
+    /// Identical to `poll()`, but returns the event wrapped in an
+    /// `EventEnvelope` carrying the monotonic timestamp captured where the
+    /// OS reported it.
+    ///
+    /// - Returns: The next event with its timestamp, or `nil` if no events are pending
+    /// - Throws: `LuminaError.eventLoopFailed` if polling fails
+    mutating func pollEnvelope() throws -> EventEnvelope?
+
+    /// Drain pending events in one batch without blocking.
+    ///
+    /// Pumps the platform message queue, then appends up to `maxCount`
+    /// pending events to `events` in delivery order. The backend's internal
+    /// queue is locked once for the whole batch rather than once per event,
+    /// which makes this the preferred API for high-frequency input loops.
+    ///
+    /// Events beyond `maxCount` stay queued for the next call to `poll()`
+    /// or `drain(into:maxCount:)`.
+    ///
+    /// Example usage:
+    /// ```swift
+    /// var events: [Event] = []
+    /// while running {
+    ///     events.removeAll(keepingCapacity: true)
+    ///     try app.drain(into: &events)
+    ///     for event in events {
+    ///         // Handle event
+    ///     }
+    ///     // Game logic and rendering
+    /// }
+    /// ```
+    ///
+    /// - Parameters:
+    ///   - events: Destination array; drained events are appended in order
+    ///   - maxCount: Maximum number of events to append
+    /// - Returns: Number of events appended
+    /// - Throws: `LuminaError.eventLoopFailed` if polling fails
+    @discardableResult
+    mutating func drain(into events: inout [Event], maxCount: Int) throws -> Int
+
+    /// Drain pending events with their timestamps in one batch without blocking.
+    ///
+    /// Identical to `drain(into:maxCount:)` for `[Event]`, but appends
+    /// `EventEnvelope` values carrying each event's OS timestamp.
+    ///
+    /// - Parameters:
+    ///   - envelopes: Destination array; drained events are appended in order
+    ///   - maxCount: Maximum number of events to append
+    /// - Returns: Number of events appended
+    /// - Throws: `LuminaError.eventLoopFailed` if polling fails
+    @discardableResult
+    mutating func drain(into envelopes: inout [EventEnvelope], maxCount: Int) throws -> Int
+
+    /// Give a window its own event queue, or return it to the shared stream.
+    ///
+    /// Events of a window with a dedicated queue are no longer returned by
+    /// `poll()` and `drain(into:)`; read them with `poll(window:)` and
+    /// `drain(window:into:maxCount:)` instead, so each subsystem sees only
+    /// its own window's events. Events are routed once, as batches are
+    /// pulled from the OS, whichever consumer pulls them; a window with no
+    /// events costs its consumer one dictionary lookup. Events without a
+    /// window (user events, raw motion, monitor changes) always stay in the
+    /// shared stream. `run(handler:)` still delivers every event to its
+    /// handler.
+    ///
+    /// The queue goes away after it hands out the window's `.closed`.
+    ///
+    /// Example:
+    /// ```swift
+    /// app.setWindowEventQueue(true, for: viewport.id)
+    /// while let event = try app.poll(window: viewport.id) {
+    ///     viewportController.handle(event)
+    /// }
+    /// ```
+    ///
+    /// - Parameters:
+    ///   - enabled: Whether the window gets a dedicated queue; disabling moves
+    ///     its queued events back to the shared stream
+    ///   - windowID: The window to configure
+    mutating func setWindowEventQueue(_ enabled: Bool, for windowID: WindowID)
+
+    /// Whether `windowID` has a dedicated event queue.
+    func hasWindowEventQueue(for windowID: WindowID) -> Bool
+
+    /// Return the next event from a window's dedicated queue without blocking.
+    ///
+    /// Pulls pending OS events only when the queue is empty; events for
+    /// other windows are kept for their own consumers.
+    ///
+    /// - Parameter windowID: Window with a dedicated queue
+    /// - Returns: The window's next event, or nil if none is pending or the
+    ///   window has no dedicated queue
+    /// - Throws: `LuminaError.eventLoopFailed` if polling fails
+    mutating func poll(window windowID: WindowID) throws -> Event?
+
+    /// Drain up to `maxCount` events from a window's dedicated queue without blocking.
+    ///
+    /// - Parameters:
+    ///   - windowID: Window with a dedicated queue
+    ///   - events: Destination array; drained events are appended in order
+    ///   - maxCount: Maximum number of events to append
+    /// - Returns: Number of events appended (0 if the window has no dedicated queue)
+    /// - Throws: `LuminaError.eventLoopFailed` if polling fails
+    @discardableResult
+    mutating func drain(window windowID: WindowID, into events: inout [Event], maxCount: Int) throws -> Int
+
     /// Wait for the next event (low-power sleep).
     ///
     /// Puts the thread to sleep until an event arrives, then returns without
@@ -103,11 +265,49 @@ public protocol LuminaApp: Sendable {
     ///
     /// Platform Notes:
     /// - macOS: Uses CFRunLoop with infinite timeout
-    /// - Windows: Uses WaitMessage() or MsgWaitForMultipleObjects()
+    /// - Windows: Uses MsgWaitForMultipleObjectsEx() with no timeout
     ///
     /// - Throws: `LuminaError.eventLoopFailed` if wait fails
     mutating func wait() throws
 
+    /// Wait for the next event or until a deadline (low-power sleep).
+    ///
+    /// Like `wait()`, but returns no later than `deadline` even if no event
+    /// arrives. Returns immediately if the deadline has already passed or
+    /// events are already pending.
+    ///
+    /// Platform Notes:
+    /// - macOS: Uses CFRunLoop with a finite timeout
+    /// - Windows: Uses MsgWaitForMultipleObjectsEx() on a high-resolution
+    ///   waitable timer, so deadlines are met to well under a millisecond
+    ///
+    /// - Parameter deadline: Latest time to return
+    /// - Throws: `LuminaError.eventLoopFailed` if wait fails
+    mutating func wait(until deadline: ContinuousClock.Instant) throws
+
+    /// Suspend until an event may be pending, without blocking the thread
+    /// where the platform allows it.
+    ///
+    /// The async counterpart of `wait()`, used by `events`. Returns
+    /// immediately if events are already queued. Spurious returns are
+    /// possible; drain or poll afterwards and wait again if nothing came.
+    ///
+    /// Platform Notes:
+    /// - macOS: Suspends while the main run loop sleeps (as it does under
+    ///   an async `main` or `NSApplication.run()`) and resumes when it
+    ///   wakes, so other main-actor work keeps running meanwhile
+    /// - Windows: The main actor has no message pump to suspend into, so
+    ///   this yields once to other main-actor work and then sleeps in
+    ///   MsgWaitForMultipleObjectsEx() like `wait()`
+    ///
+    /// - Throws: `LuminaError.eventLoopFailed` if wait fails
+    func waitAsync() async throws
+
+    /// How `waitForEvents()` sleeps when no events are pending.
+    ///
+    /// Defaults to `.wait`.
+    var controlFlow: ControlFlow { get set }
+
     /// Post a user-defined event to the event queue (thread-safe).
     ///
     /// This method is thread-safe and allows background threads to communicate
@@ -146,6 +346,210 @@ public protocol LuminaApp: Sendable {
         monitor: Monitor?
     ) -> Result<LuminaWindow, LuminaError>
 
+    /// Create several windows in one call.
+    ///
+    /// Cheaper than calling `createWindow` in a loop: the target monitor's
+    /// placement and scale are resolved once per distinct monitor rather
+    /// than once per window, and parked windows are reused where possible
+    /// (see `windowPoolCapacity`). Creation is all or nothing: if any window
+    /// fails, the ones already created are dropped without a `.closed`
+    /// event and the error is returned.
+    ///
+    /// - Parameter descriptors: The windows to create, in order
+    /// - Returns: The created windows, in the order of `descriptors`
+    mutating func createWindows(_ descriptors: [WindowDescriptor]) -> Result<[LuminaWindow], LuminaError>
+
+    /// Maximum number of closed windows kept hidden for reuse.
+    ///
+    /// Defaults to 0 (windows are destroyed on close). With a capacity, a
+    /// closed window is hidden and parked instead, still reporting
+    /// `.closed` with its old ID, and the next `createWindow` with the same
+    /// `resizable` style takes it back under a new ID, re-titled and
+    /// re-sized, skipping native window creation. Lowering the capacity
+    /// destroys the windows that no longer fit.
+    ///
+    /// Example:
+    /// ```swift
+    /// app.windowPoolCapacity = 16
+    /// try app.prewarmWindows(16, resizable: false).get()
+    /// // Later, on a latency-sensitive path:
+    /// let tooltip = try app.createWindow(title: "", size: size, resizable: false, monitor: nil).get()
+    /// ```
+    var windowPoolCapacity: Int { get set }
+
+    /// Fill the window pool ahead of time.
+    ///
+    /// Creates up to `count` hidden windows with the given style, stopping
+    /// early once the pool holds `windowPoolCapacity` windows.
+    ///
+    /// - Parameters:
+    ///   - count: Number of windows to create
+    ///   - resizable: Style of the windows, matching later `createWindow` calls
+    /// - Returns: Success, or the error of the first window that failed
+    mutating func prewarmWindows(_ count: Int, resizable: Bool) -> Result<Void, LuminaError>
+
+    /// Coalescing applied to events returned by `poll()` and `drain(into:)`.
+    ///
+    /// Defaults to no coalescing: every OS sample is delivered as its own
+    /// event. Enable `.pointerMotion`/`.wheel` to merge consecutive motion
+    /// and scroll events for the same window, which keeps high-polling-rate
+    /// mice from flooding game loops.
+    var eventCoalescing: EventCoalescing { get set }
+
+    /// Override `eventCoalescing` for a single window.
+    ///
+    /// For example, enable `.resize` only for the window whose swapchain is
+    /// expensive to recreate. The override is dropped when the window closes.
+    ///
+    /// - Parameters:
+    ///   - options: Coalescing for this window, or nil to use `eventCoalescing`
+    ///   - windowID: The window to configure
+    mutating func setEventCoalescing(_ options: EventCoalescing?, for windowID: WindowID)
+
+    /// Coalescing in effect for a window (its override, or `eventCoalescing`).
+    ///
+    /// - Parameter windowID: The window to query
+    /// - Returns: The options applied to this window's events
+    func eventCoalescing(for windowID: WindowID) -> EventCoalescing
+
+    /// Pointer positions observed for a window in the most recent batch.
+    ///
+    /// Includes the positions merged away by `.pointerMotion` coalescing, in
+    /// the order they were reported. Only populated while `eventCoalescing`
+    /// contains `.pointerSamples`; otherwise returns an empty array.
+    ///
+    /// - Parameter windowID: The window to query
+    /// - Returns: Pointer positions in logical window coordinates
+    func coalescedPointerSamples(for windowID: WindowID) -> [LogicalPosition]
+
+    /// Input categories translated for windows without their own mask.
+    ///
+    /// Defaults to `.all`. See `EventMask`.
+    var eventMask: EventMask { get set }
+
+    /// Override the input categories translated for one window.
+    ///
+    /// - Parameters:
+    ///   - mask: Categories to deliver for this window, or nil to use `eventMask`
+    ///   - windowID: The window to configure
+    mutating func setEventMask(_ mask: EventMask?, for windowID: WindowID)
+
+    /// Input categories translated for a window (its override, or `eventMask`).
+    ///
+    /// - Parameter windowID: The window to query
+    /// - Returns: The mask applied to this window's input
+    func eventMask(for windowID: WindowID) -> EventMask
+
+    /// Keys held in a window right now.
+    ///
+    /// Maintained by the backend as key messages are translated, so game
+    /// loops can poll key state in O(1) instead of tracking keyDown/keyUp
+    /// themselves. State advances as `poll()`/`drain(into:)` pump the
+    /// platform queue, whether or not the events are handled. Unknown or
+    /// closed windows report an empty state.
+    ///
+    /// - Parameter windowID: The window to query
+    /// - Returns: Snapshot of the window's keyboard state
+    func keyboardState(for windowID: WindowID) -> KeyboardState
+
+    /// Pointer position and held buttons for a window right now.
+    ///
+    /// Maintained alongside `keyboardState(for:)`. Unknown or closed
+    /// windows report an empty state.
+    ///
+    /// - Parameter windowID: The window to query
+    /// - Returns: Snapshot of the window's pointer state
+    func pointerState(for windowID: WindowID) -> PointerState
+
+    /// Whether `.pointer(.rawMotion)` events are delivered.
+    ///
+    /// Raw motion carries unaccelerated, sub-pixel device deltas at the
+    /// device's polling rate, for camera control and similar uses where the
+    /// cursor position doesn't matter. Defaults to `false`. Reads `false`
+    /// after setting `true` if the platform refused the registration.
+    ///
+    /// Platform Notes:
+    /// - Windows: Raw Input (RegisterRawInputDevices), read in batches with
+    ///   GetRawInputBuffer once the message pump reaches the first WM_INPUT,
+    ///   so each poll()/drain() costs one read per batch rather than one
+    ///   call per sample, and motion stays behind earlier clicks and keys
+    /// - macOS: NSEvent deltaX/deltaY of mouse motion events, which keep
+    ///   reporting at screen edges
+    var rawPointerInput: Bool { get set }
+
+    /// Recorder that captures every event this application delivers.
+    ///
+    /// Defaults to nil. With a recorder set, each event returned by
+    /// `poll()`/`drain(into:)` or handed to a `run(handler:)` handler is
+    /// appended to its trace with its timestamp, after coalescing, so
+    /// `ReplayApplication` can later reproduce the session exactly. User
+    /// events are not recorded. Call `finish()` on the recorder when done.
+    ///
+    /// Example:
+    /// ```swift
+    /// app.eventRecorder = try EventTraceRecorder.create(path: "session.lutr").get()
+    /// ```
+    var eventRecorder: EventTraceRecorder? { get set }
+
+    /// Whether the event loop collects `statistics()` and emits trace intervals.
+    ///
+    /// When enabled, message dispatch, translation, enqueue/dequeue and
+    /// waits are reported as intervals to the platform tracer, and
+    /// wakeups as point events. Disabled (the default), each instrumented
+    /// site costs one relaxed atomic load.
+    ///
+    /// Platform Notes:
+    /// - macOS: `os_signpost` intervals, subsystem "Lumina", category
+    ///   "EventLoop" (Instruments: os_signpost)
+    /// - Windows: TraceLogging-format ETW events from the "Lumina" provider,
+    ///   {5B1D3C7E-8F2A-4C61-9D0B-3E7A4F6C2915}, with Start/Stop opcodes
+    var instrumentationEnabled: Bool { get set }
+
+    /// Event loop counters collected while `instrumentationEnabled` is true.
+    ///
+    /// Example:
+    /// ```swift
+    /// app.instrumentationEnabled = true
+    /// try app.run(handler: game.handle)
+    /// let stats = app.statistics()
+    /// print("\(stats.eventsCoalesced) coalesced, peak batch \(stats.queueHighWaterMark)")
+    /// ```
+    ///
+    /// - Returns: Counts accumulated since the last `resetStatistics()`
+    func statistics() -> EventLoopStatistics
+
+    /// Zero the counters returned by `statistics()`.
+    mutating func resetStatistics()
+
+    /// Opt-in handler that keeps frames flowing during modal resize/move loops.
+    ///
+    /// While the user drags a window edge or title bar, the OS runs its own
+    /// modal loop and `poll()`/`drain(into:)` get no control back until the
+    /// mouse is released. With a handler set, Lumina calls it from inside
+    /// that loop, periodically and with the events queued meanwhile
+    /// (typically `.resized` followed by `.redrawRequested`), so the
+    /// application can render. Events pass through the same coalescing,
+    /// window queues and `eventRecorder` as `drain(into:)`, and those
+    /// passed to the handler are not returned by `poll()` again. Defaults
+    /// to nil (rendering pauses during the drag).
+    ///
+    /// Example:
+    /// ```swift
+    /// app.modalLoopHandler = { events in
+    ///     for event in events {
+    ///         if case .window(.resized(_, let size)) = event {
+    ///             renderer.resize(to: size)
+    ///         }
+    ///     }
+    ///     renderer.drawFrame()
+    /// }
+    /// ```
+    ///
+    /// Platform Notes:
+    /// - Windows: Driven by a WM_TIMER between WM_ENTERSIZEMOVE and WM_EXITSIZEMOVE
+    /// - macOS: Driven by the window's display link during live resize
+    var modalLoopHandler: ModalLoopHandler? { get set }
+
     /// Whether the application should quit when the last window is closed.
     ///
     /// Defaults to `true`. Set to `false` if you want the application to
@@ -153,12 +557,111 @@ public protocol LuminaApp: Sendable {
     var exitOnLastWindowClosed: Bool { get set }
 }
 
+// MARK: - Batched Polling
+
+@MainActor
+extension LuminaApp {
+    /// Drain every pending event in one batch without blocking.
+    ///
+    /// Equivalent to `drain(into:maxCount:)` with no upper bound.
+    ///
+    /// - Parameter events: Destination array; drained events are appended in order
+    /// - Returns: Number of events appended
+    /// - Throws: `LuminaError.eventLoopFailed` if polling fails
+    @discardableResult
+    public mutating func drain(into events: inout [Event]) throws -> Int {
+        try drain(into: &events, maxCount: .max)
+    }
+
+    /// Drain every pending event with its timestamp in one batch without blocking.
+    ///
+    /// Equivalent to `drain(into:maxCount:)` with no upper bound.
+    ///
+    /// - Parameter envelopes: Destination array; drained events are appended in order
+    /// - Returns: Number of events appended
+    /// - Throws: `LuminaError.eventLoopFailed` if polling fails
+    @discardableResult
+    public mutating func drain(into envelopes: inout [EventEnvelope]) throws -> Int {
+        try drain(into: &envelopes, maxCount: .max)
+    }
+
+    /// Drain every event in a window's dedicated queue without blocking.
+    ///
+    /// Equivalent to `drain(window:into:maxCount:)` with no upper bound.
+    ///
+    /// - Parameters:
+    ///   - windowID: Window with a dedicated queue
+    ///   - events: Destination array; drained events are appended in order
+    /// - Returns: Number of events appended
+    /// - Throws: `LuminaError.eventLoopFailed` if polling fails
+    @discardableResult
+    public mutating func drain(window windowID: WindowID, into events: inout [Event]) throws -> Int {
+        try drain(window: windowID, into: &events, maxCount: .max)
+    }
+
+    /// Return up to `maxCount` pending events without blocking.
+    ///
+    /// - Parameter maxCount: Maximum number of events to return
+    /// - Returns: Pending events in delivery order (empty if none are pending)
+    /// - Throws: `LuminaError.eventLoopFailed` if polling fails
+    public mutating func pollBatch(maxCount: Int = .max) throws -> [Event] {
+        var batch: [Event] = []
+        try drain(into: &batch, maxCount: maxCount)
+        return batch
+    }
+}
+
+// MARK: - Window Creation
+
+@MainActor
+extension LuminaApp {
+    /// Create a window from a descriptor.
+    ///
+    /// Equivalent to `createWindow(title:size:resizable:monitor:)` with the
+    /// descriptor's fields.
+    ///
+    /// - Parameter descriptor: Title, size, style and monitor of the window
+    /// - Returns: The created window, or an error if creation failed
+    public mutating func createWindow(_ descriptor: WindowDescriptor) -> Result<LuminaWindow, LuminaError> {
+        createWindow(
+            title: descriptor.title,
+            size: descriptor.size,
+            resizable: descriptor.resizable,
+            monitor: descriptor.monitor
+        )
+    }
+}
+
+// MARK: - Control Flow
+
+@MainActor
+extension LuminaApp {
+    /// Sleep according to `controlFlow`.
+    ///
+    /// - `.poll`, `.exit`: returns immediately
+    /// - `.wait`: equivalent to `wait()`
+    /// - `.waitUntil(deadline)`: equivalent to `wait(until: deadline)`
+    ///
+    /// - Throws: `LuminaError.eventLoopFailed` if wait fails
+    public mutating func waitForEvents() throws {
+        switch controlFlow {
+        case .poll, .exit:
+            return
+        case .wait:
+            try wait()
+        case .waitUntil(let deadline):
+            try wait(until: deadline)
+        }
+    }
+}
+
 // MARK: - Platform Selection
 
 /// Create a new Lumina application instance.
 ///
 /// This factory method automatically selects the correct platform implementation
-/// without exposing internal types.
+/// without exposing internal types. Platforms without a native backend get a
+/// `HeadlessApplication`, whose windows exist only in memory.
 ///
 /// - Throws: `LuminaError.platformError` if platform initialization fails
 /// - Returns: A new application instance ready to create windows and run the event loop
@@ -169,6 +672,6 @@ public func createLuminaApp() throws -> some LuminaApp {
     #elseif os(Windows)
     return try WinApplication()
     #else
-    #error("Unsupported platform")
+    return HeadlessApplication()
     #endif
 }
\ No newline at end of file
@@ -36,7 +36,9 @@ public protocol LuminaWindow: Sendable {
     /// Close the window and release resources (consumes self).
     ///
     /// After calling this method, the window is no longer valid and should
-    /// not be used. This method consumes ownership of the window.
+    /// not be used. This method consumes ownership of the window. Copies
+    /// made earlier outlive it: their methods do nothing, even once a
+    /// pooled native window was handed to a new window.
     ///
     /// Implementation notes:
     /// - macOS: Call close() on NSWindow, release window delegate
@@ -146,4 +148,53 @@ public protocol LuminaWindow: Sendable {
     ///
     /// - Returns: Current scale factor for this window
     func scaleFactor() -> Float
+
+    /// Thread-safe view of this window's size, scale and visibility.
+    ///
+    /// The proxy may be handed to render threads; its snapshot is kept
+    /// current by the backend, so reading it needs neither the main actor
+    /// nor a lock. Every call returns the same proxy.
+    ///
+    /// Implementation notes:
+    /// - macOS: Published from the window delegate (resize, backing, occlusion)
+    /// - Windows: Published from WM_SIZE, WM_DPICHANGED and WM_SHOWWINDOW
+    ///
+    /// - Returns: The window's proxy
+    func proxy() -> WindowProxy
+
+    /// Request a `.window(.redrawRequested)` event for this window.
+    ///
+    /// Requests are coalesced until the next display refresh, so calling
+    /// this several times per frame still produces one event. A window that
+    /// stops requesting redraws stops ticking and costs no CPU while idle.
+    ///
+    /// Implementation notes:
+    /// - macOS: Unpause the content view's CADisplayLink; emit on the next tick
+    /// - Windows: InvalidateRect once per DWM refresh and emit on WM_PAINT
+    func requestRedraw()
+
+    /// Native handles of this window.
+    ///
+    /// The handles are for interop only; changing the window through them
+    /// bypasses Lumina's state and events.
+    ///
+    /// - Returns: The platform handles, or `.unavailable` once closed
+    func rawWindowHandle() -> RawWindowHandle
+
+    /// Prepare the window for GPU presentation and return the surface.
+    ///
+    /// Takes the window off the system's own painting path, so the
+    /// swapchain is the only thing that fills the client area: no
+    /// background fill on resize and no redundant compositor work. Calling
+    /// it again returns the same surface. Release swapchains when the
+    /// window reports `.closed`; pooled windows are handed to later
+    /// `createWindow` calls.
+    ///
+    /// Implementation notes:
+    /// - macOS: Makes the content view layer-hosting with a `CAMetalLayer`
+    /// - Windows: Stops WM_ERASEBKGND fills and whole-window invalidation
+    ///   on resize; `.redrawRequested` still arrives on request
+    ///
+    /// - Returns: The surface, or an error if the window has no native surface
+    mutating func surface() -> Result<NativeSurface, LuminaError>
 }
@@ -3,6 +3,8 @@
 /// Provides cross-platform access to monitor information including
 /// physical dimensions, position, DPI scaling, and primary monitor detection.
 
+import Synchronization
+
 /// Unique identifier for a monitor.
 public struct MonitorID: Sendable, Hashable, CustomStringConvertible {
     internal let value: UInt64
@@ -63,6 +65,10 @@ public struct Monitor: Sendable, Hashable {
 
     /// Enumerate all available monitors.
     ///
+    /// While an application exists, the list is cached and only rebuilt
+    /// after the OS reports a display change (see `Event.monitorsChanged`),
+    /// so repeated calls are cheap.
+    ///
     /// - Returns: Array of all detected monitors
     /// - Throws: LuminaError if monitor enumeration fails
     ///
@@ -72,13 +78,15 @@ public struct Monitor: Sendable, Hashable {
     /// print("Found \(monitors.count) monitor(s)")
     /// ```
     public static func all() throws -> [Monitor] {
-        #if os(Windows)
-        return try WinMonitor.enumerateMonitors()
-        #elseif os(macOS)
-        return try MacMonitor.enumerateMonitors()
-        #else
-        throw LuminaError.platformNotSupported(operation: "Monitor enumeration")
-        #endif
+        try MonitorCache.shared.monitors {
+            #if os(Windows)
+            return try WinMonitor.enumerateMonitors()
+            #elseif os(macOS)
+            return try MacMonitor.enumerateMonitors()
+            #else
+            throw LuminaError.platformNotSupported(operation: "Monitor enumeration")
+            #endif
+        }
     }
 
     /// Get the primary monitor.
@@ -101,3 +109,83 @@ public struct Monitor: Sendable, Hashable {
         #endif
     }
 }
+
+// MARK: - Monitor Cache
+
+/// Process-wide cache of the monitor list.
+///
+/// Enumeration (NSScreen.screens, EnumDisplayMonitors) is only cached once
+/// an application is tracking display changes; before that every lookup
+/// enumerates, since nothing would invalidate the list. Backends call
+/// `invalidate()` from the OS notification and post `.monitorsChanged` when
+/// it returns true.
+///
+/// Thread Safety: All state is behind a mutex; enumeration runs outside it.
+internal final class MonitorCache: Sendable {
+    static let shared = MonitorCache()
+
+    private struct State {
+        var monitors: [Monitor]?
+        /// Bumped by every invalidation, so a list enumerated across one is dropped
+        var generation: UInt64 = 0
+        /// An invalidation was announced and the list hasn't been read since
+        var changePending = false
+        var isTracking = false
+    }
+
+    private let state = Mutex(State())
+
+    init() {}
+
+    /// Enable caching; called by a backend once it observes display changes.
+    func startTracking() {
+        state.withLock { $0.isTracking = true }
+    }
+
+    /// Disable caching when display changes can no longer be observed.
+    func stopTracking() {
+        state.withLock { state in
+            state.isTracking = false
+            state.monitors = nil
+            state.generation &+= 1
+        }
+    }
+
+    /// The cached monitor list, enumerating it with `enumerate` if needed.
+    func monitors(_ enumerate: () throws -> [Monitor]) rethrows -> [Monitor] {
+        let (cached, generation, isTracking) = state.withLock { state in
+            state.changePending = false
+            return (state.monitors, state.generation, state.isTracking)
+        }
+        if let cached {
+            return cached
+        }
+
+        let monitors = try enumerate()
+        if isTracking {
+            state.withLock { state in
+                if state.generation == generation {
+                    state.monitors = monitors
+                }
+            }
+        }
+        return monitors
+    }
+
+    /// Drop the cached list after a display change.
+    ///
+    /// - Returns: true if the change should be announced with
+    ///   `.monitorsChanged`; false if an earlier change is still unread
+    @discardableResult
+    func invalidate() -> Bool {
+        state.withLock { state in
+            state.monitors = nil
+            state.generation &+= 1
+            guard !state.changePending else {
+                return false
+            }
+            state.changePending = true
+            return true
+        }
+    }
+}
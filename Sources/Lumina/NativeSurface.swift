@@ -0,0 +1,47 @@
+/// Native handles of a window, for libraries that work on platform windows.
+///
+/// Pointers are unretained and stay valid until the window closes. Convert
+/// them back with the platform's types, e.g.
+/// `Unmanaged<NSWindow>.fromOpaque(window).takeUnretainedValue()` on macOS
+/// or `HWND(hwnd)` on Windows.
+public enum RawWindowHandle: @unchecked Sendable {
+    /// macOS: the `NSWindow` and its content `NSView`
+    case appKit(window: UnsafeMutableRawPointer, view: UnsafeMutableRawPointer?)
+
+    /// Windows: the `HWND` and the `HINSTANCE` of the module that created it
+    case win32(hwnd: UnsafeMutableRawPointer, hinstance: UnsafeMutableRawPointer?)
+
+    /// The window has no native handle (it was closed, or belongs to an
+    /// in-memory backend)
+    case unavailable
+}
+
+/// A window prepared for presenting GPU frames directly to the compositor.
+///
+/// Returned by `LuminaWindow.surface()`. Pointers are unretained and stay
+/// valid until the window closes.
+///
+/// Example:
+/// ```swift
+/// switch try window.surface().get() {
+/// case .metalLayer(let pointer):
+///     let layer = Unmanaged<CAMetalLayer>.fromOpaque(pointer).takeUnretainedValue()
+///     layer.device = device
+///     layer.pixelFormat = .bgra8Unorm
+/// case .win32(let hwnd, _):
+///     // IDXGIFactory2::CreateSwapChainForHwnd(queue, HWND(hwnd), ...) with
+///     // DXGI_SWAP_EFFECT_FLIP_DISCARD
+///     renderer.createSwapChain(for: hwnd)
+/// }
+/// ```
+public enum NativeSurface: @unchecked Sendable {
+    /// macOS: a `CAMetalLayer` hosted by the window's content view
+    ///
+    /// Its `contentsScale` follows the window's backing scale factor; set
+    /// `drawableSize` from `.resized` and `scaleFactor()`.
+    case metalLayer(UnsafeMutableRawPointer)
+
+    /// Windows: an `HWND` whose client area is never painted by GDI, for a
+    /// flip-model DXGI swapchain
+    case win32(hwnd: UnsafeMutableRawPointer, hinstance: UnsafeMutableRawPointer?)
+}
@@ -0,0 +1,262 @@
+/// Application with in-memory windows and synthetic input, for running
+/// without a window system.
+///
+/// Windows are plain values: creating one costs a slot in a table, so
+/// thousands can exist at once. Their operations behave like a
+/// native window's and queue the events it would report (`resize` queues
+/// `.resized`, `requestFocus` queues `.unfocused`/`.focused`, `close`
+/// queues `.closed`, `requestRedraw` queues one `.redrawRequested` per
+/// poll). Input comes from `inject(_:timestamp:)`, which applies event
+/// masks and updates `keyboardState(for:)`/`pointerState(for:)` exactly
+/// as the native backends do for OS input.
+///
+/// Nothing is ever presented and there is no vsync, so redraw-driven loops
+/// run as fast as the application renders. Used by `createLuminaApp()` on
+/// platforms without a native backend, and directly by tests, CI and
+/// offscreen rendering.
+///
+/// Example:
+/// ```swift
+/// var app = HeadlessApplication()
+/// let window = try app.createWindow(
+///     title: "Bot", size: LogicalSize(width: 1280, height: 720), resizable: true, monitor: nil
+/// ).get()
+/// app.inject(.keyboard(.keyDown(window.id, key: .space, modifiers: [])))
+/// while let event = try app.poll() {
+///     game.handle(event)
+/// }
+/// ```
+@MainActor
+public struct HeadlessApplication: LuminaApp {
+    private let backend: VirtualBackend
+    private let userEvents: VirtualUserEvents
+
+    /// Create an application with no windows.
+    public init() {
+        let backend = VirtualBackend(emitsWindowEvents: true)
+        self.backend = backend
+        self.userEvents = backend.userEvents
+    }
+
+    /// Number of open windows.
+    public var windowCount: Int {
+        backend.windows.count
+    }
+
+    /// Queue a synthetic event as if the OS had reported it.
+    ///
+    /// Input for a closed or unknown window, input outside the window's
+    /// `eventMask(for:)`, and raw motion while `rawPointerInput` is off is
+    /// dropped. Window events are queued as given without changing the
+    /// window's state; use the `LuminaWindow` methods for that.
+    ///
+    /// - Parameters:
+    ///   - event: The event to deliver
+    ///   - timestamp: When the event occurred (defaults to now)
+    /// - Returns: Whether the event was queued
+    @discardableResult
+    public func inject(_ event: Event, timestamp: EventTimestamp = .now()) -> Bool {
+        backend.inject(EventEnvelope(event, timestamp: timestamp))
+    }
+
+    /// Queue several synthetic events in order.
+    ///
+    /// - Parameter events: Events to deliver, as in `inject(_:timestamp:)`
+    /// - Returns: Number of events queued
+    @discardableResult
+    public func inject<S: Sequence>(contentsOf events: S) -> Int where S.Element == Event {
+        var queued = 0
+        for event in events where backend.inject(EventEnvelope(event)) {
+            queued += 1
+        }
+        return queued
+    }
+
+    /// Minimize or restore a window, as the user would from its title bar.
+    ///
+    /// Queues `.minimized` or `.restored`. Redraw requests of a minimized
+    /// window are held back until it is restored, as on a native backend.
+    ///
+    /// - Parameters:
+    ///   - minimized: Whether the window should be minimized
+    ///   - windowID: The window; unknown IDs are ignored
+    public func setMinimized(_ minimized: Bool, for windowID: WindowID) {
+        backend.setMinimized(minimized, for: windowID)
+    }
+
+    /// Mark a window as covered by others, or visible again.
+    ///
+    /// Queues `.occlusionChanged`. Redraw requests of an occluded window
+    /// are held back until it is uncovered.
+    ///
+    /// - Parameters:
+    ///   - occluded: Whether the window is hidden from the user
+    ///   - windowID: The window; unknown IDs are ignored
+    public func setOccluded(_ occluded: Bool, for windowID: WindowID) {
+        backend.setOccluded(occluded, for: windowID)
+    }
+
+    public mutating func run() throws {
+        try run { _ in .wait }
+    }
+
+    public mutating func run(handler: EventHandler) throws {
+        backend.run(handler: handler)
+    }
+
+    public mutating func poll() throws -> Event? {
+        backend.pollEnvelope()?.event
+    }
+
+    public mutating func pollEnvelope() throws -> EventEnvelope? {
+        backend.pollEnvelope()
+    }
+
+    public mutating func drain(into events: inout [Event], maxCount: Int) throws -> Int {
+        backend.drain(into: &events, maxCount: maxCount, transform: \.event)
+    }
+
+    public mutating func drain(into envelopes: inout [EventEnvelope], maxCount: Int) throws -> Int {
+        backend.drain(into: &envelopes, maxCount: maxCount, transform: { $0 })
+    }
+
+    public mutating func setWindowEventQueue(_ enabled: Bool, for windowID: WindowID) {
+        backend.pipeline.setWindowQueue(enabled, for: windowID)
+    }
+
+    public func hasWindowEventQueue(for windowID: WindowID) -> Bool {
+        backend.pipeline.hasWindowQueue(for: windowID)
+    }
+
+    public mutating func poll(window windowID: WindowID) throws -> Event? {
+        backend.pollEnvelope(for: windowID)?.event
+    }
+
+    public mutating func drain(window windowID: WindowID, into events: inout [Event], maxCount: Int) throws -> Int {
+        backend.drain(for: windowID, into: &events, maxCount: maxCount, transform: \.event)
+    }
+
+    public mutating func wait() throws {
+        backend.wait(until: nil)
+    }
+
+    public mutating func wait(until deadline: ContinuousClock.Instant) throws {
+        backend.wait(until: deadline)
+    }
+
+    public func waitAsync() async throws {
+        // Let main-actor work scheduled meanwhile run before sleeping
+        await Task.yield()
+        backend.wait(until: nil)
+    }
+
+    public var controlFlow: ControlFlow {
+        get { backend.controlFlow }
+        set { backend.controlFlow = newValue }
+    }
+
+    public nonisolated func postUserEvent(_ event: UserEvent) {
+        userEvents.send(event)
+    }
+
+    public func quit() {
+        backend.quit()
+    }
+
+    public mutating func createWindow(
+        title: String,
+        size: LogicalSize,
+        resizable: Bool,
+        monitor: Monitor?
+    ) -> Result<LuminaWindow, LuminaError> {
+        let descriptor = WindowDescriptor(title: title, size: size, resizable: resizable, monitor: monitor)
+        return .success(backend.createWindow(descriptor))
+    }
+
+    public mutating func createWindows(_ descriptors: [WindowDescriptor]) -> Result<[LuminaWindow], LuminaError> {
+        .success(descriptors.map { backend.createWindow($0) })
+    }
+
+    public var windowPoolCapacity: Int {
+        get { backend.windowPoolCapacity }
+        set { backend.windowPoolCapacity = newValue }
+    }
+
+    /// In-memory windows are never pooled, so there is nothing to prewarm.
+    public mutating func prewarmWindows(_ count: Int, resizable: Bool) -> Result<Void, LuminaError> {
+        .success(())
+    }
+
+    public var eventCoalescing: EventCoalescing {
+        get { backend.pipeline.coalescing }
+        set { backend.pipeline.coalescing = newValue }
+    }
+
+    public mutating func setEventCoalescing(_ options: EventCoalescing?, for windowID: WindowID) {
+        backend.pipeline.setCoalescing(options, for: windowID)
+    }
+
+    public func eventCoalescing(for windowID: WindowID) -> EventCoalescing {
+        backend.pipeline.coalescing(for: windowID)
+    }
+
+    public func coalescedPointerSamples(for windowID: WindowID) -> [LogicalPosition] {
+        backend.pipeline.pointerSamples(for: windowID)
+    }
+
+    public var eventMask: EventMask {
+        get { backend.eventMask }
+        set { backend.eventMask = newValue }
+    }
+
+    public mutating func setEventMask(_ mask: EventMask?, for windowID: WindowID) {
+        backend[window: windowID]?.eventMask = mask
+    }
+
+    public func eventMask(for windowID: WindowID) -> EventMask {
+        backend[window: windowID]?.eventMask ?? backend.eventMask
+    }
+
+    public func keyboardState(for windowID: WindowID) -> KeyboardState {
+        backend[window: windowID]?.input.keyboard ?? KeyboardState()
+    }
+
+    public func pointerState(for windowID: WindowID) -> PointerState {
+        backend[window: windowID]?.input.pointer ?? PointerState()
+    }
+
+    /// Whether injected `.pointer(.rawMotion)` events are delivered.
+    public var rawPointerInput: Bool {
+        get { backend.rawPointerInput }
+        set { backend.rawPointerInput = newValue }
+    }
+
+    public var eventRecorder: EventTraceRecorder? {
+        get { backend.pipeline.recorder }
+        set { backend.pipeline.recorder = newValue }
+    }
+
+    public var instrumentationEnabled: Bool {
+        get { backend.instrumentation.isEnabled }
+        set { backend.instrumentation.isEnabled = newValue }
+    }
+
+    public func statistics() -> EventLoopStatistics {
+        backend.instrumentation.snapshot()
+    }
+
+    public mutating func resetStatistics() {
+        backend.instrumentation.reset()
+    }
+
+    /// Stored for API parity; in-memory windows run no modal loops.
+    public var modalLoopHandler: ModalLoopHandler? {
+        get { backend.modalLoopHandler }
+        set { backend.modalLoopHandler = newValue }
+    }
+
+    public var exitOnLastWindowClosed: Bool {
+        get { backend.exitOnLastWindowClosed }
+        set { backend.exitOnLastWindowClosed = newValue }
+    }
+}
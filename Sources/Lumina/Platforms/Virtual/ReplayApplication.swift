@@ -0,0 +1,346 @@
+/// How fast `ReplayApplication` delivers a trace.
+public enum ReplayPace: Sendable, Equatable {
+    /// Each event falls due at its recorded offset from the first event
+    case original
+
+    /// Offsets are divided by the factor (2 = twice as fast); with a factor
+    /// of zero or less every event is due immediately
+    case accelerated(Double)
+
+    /// Every event is due immediately; timestamps keep the recorded spacing
+    case unpaced
+}
+
+/// Application that plays back a recorded `EventTrace` without a window system.
+///
+/// Serves the trace's events through the regular `LuminaApp` API, so the
+/// code that handled a live session can be driven by its recording: in
+/// headless CI, for regression tests of input handling, or to reproduce a
+/// bug report. Events fall due according to `pace`, measured from the
+/// first `poll()`, `drain(into:)`, `wait()` or `run(handler:)` call, and
+/// carry the timestamps they were scheduled for, so the spacing between
+/// them matches the recording (scaled by the pace).
+///
+/// Windows are kept in memory. Their operations update that state but
+/// report no events of their own, since the trace already holds the
+/// `.resized`, `.closed`, `.redrawRequested`, ... events of the recorded
+/// session. The windows the application creates stand in for the recorded
+/// ones in order: events of the first window seen in the trace are
+/// delivered with the ID of the first window created here, and so on.
+/// Events of recorded windows without a stand-in keep their recorded ID.
+///
+/// `run(handler:)` returns once the trace has been delivered and the
+/// queue is empty; `wait()` no longer sleeps after that.
+///
+/// Traces store events after coalescing, so leave `eventCoalescing` off
+/// to reproduce them exactly.
+///
+/// Example:
+/// ```swift
+/// let trace = try EventTrace.load(path: "session.lutr").get()
+/// var app = ReplayApplication(trace: trace, pace: .unpaced)
+/// let window = try app.createWindow(
+///     title: "Replay", size: LogicalSize(width: 800, height: 600), resizable: true, monitor: nil
+/// ).get()
+/// try app.run { event in
+///     game.handle(event)
+///     return .poll
+/// }
+/// ```
+@MainActor
+public struct ReplayApplication: LuminaApp {
+    private let backend: VirtualBackend
+    private let cursor: ReplayCursor
+    private let userEvents: VirtualUserEvents
+
+    /// Create an application that replays an empty trace.
+    public init() throws {
+        self.init(trace: EventTrace(events: []))
+    }
+
+    /// Create an application that replays `trace`.
+    ///
+    /// - Parameters:
+    ///   - trace: The recorded events
+    ///   - pace: How fast to deliver them
+    public init(trace: EventTrace, pace: ReplayPace = .original) {
+        let backend = VirtualBackend(emitsWindowEvents: false)
+        let cursor = ReplayCursor(trace: trace, pace: pace)
+        backend.pump = { cursor.pump(into: $0) }
+        backend.windowCreated = { cursor.windowCreated($0) }
+
+        self.backend = backend
+        self.cursor = cursor
+        self.userEvents = backend.userEvents
+    }
+
+    /// Whether every event of the trace has been delivered to the queue.
+    public var isFinished: Bool {
+        cursor.isFinished
+    }
+
+    /// Number of trace events delivered to the queue so far.
+    public var replayedCount: Int {
+        cursor.replayedCount
+    }
+
+    public mutating func run() throws {
+        try run { _ in .wait }
+    }
+
+    public mutating func run(handler: EventHandler) throws {
+        backend.run(handler: handler)
+    }
+
+    public mutating func poll() throws -> Event? {
+        backend.pollEnvelope()?.event
+    }
+
+    public mutating func pollEnvelope() throws -> EventEnvelope? {
+        backend.pollEnvelope()
+    }
+
+    public mutating func drain(into events: inout [Event], maxCount: Int) throws -> Int {
+        backend.drain(into: &events, maxCount: maxCount, transform: \.event)
+    }
+
+    public mutating func drain(into envelopes: inout [EventEnvelope], maxCount: Int) throws -> Int {
+        backend.drain(into: &envelopes, maxCount: maxCount, transform: { $0 })
+    }
+
+    public mutating func setWindowEventQueue(_ enabled: Bool, for windowID: WindowID) {
+        backend.pipeline.setWindowQueue(enabled, for: windowID)
+    }
+
+    public func hasWindowEventQueue(for windowID: WindowID) -> Bool {
+        backend.pipeline.hasWindowQueue(for: windowID)
+    }
+
+    public mutating func poll(window windowID: WindowID) throws -> Event? {
+        backend.pollEnvelope(for: windowID)?.event
+    }
+
+    public mutating func drain(window windowID: WindowID, into events: inout [Event], maxCount: Int) throws -> Int {
+        backend.drain(for: windowID, into: &events, maxCount: maxCount, transform: \.event)
+    }
+
+    public mutating func wait() throws {
+        backend.wait(until: nil)
+    }
+
+    public mutating func wait(until deadline: ContinuousClock.Instant) throws {
+        backend.wait(until: deadline)
+    }
+
+    public func waitAsync() async throws {
+        // Let main-actor work scheduled meanwhile run before sleeping
+        await Task.yield()
+        backend.wait(until: nil)
+    }
+
+    public var controlFlow: ControlFlow {
+        get { backend.controlFlow }
+        set { backend.controlFlow = newValue }
+    }
+
+    public nonisolated func postUserEvent(_ event: UserEvent) {
+        userEvents.send(event)
+    }
+
+    public func quit() {
+        backend.quit()
+    }
+
+    public mutating func createWindow(
+        title: String,
+        size: LogicalSize,
+        resizable: Bool,
+        monitor: Monitor?
+    ) -> Result<LuminaWindow, LuminaError> {
+        let descriptor = WindowDescriptor(title: title, size: size, resizable: resizable, monitor: monitor)
+        return .success(backend.createWindow(descriptor))
+    }
+
+    public mutating func createWindows(_ descriptors: [WindowDescriptor]) -> Result<[LuminaWindow], LuminaError> {
+        .success(descriptors.map { backend.createWindow($0) })
+    }
+
+    public var windowPoolCapacity: Int {
+        get { backend.windowPoolCapacity }
+        set { backend.windowPoolCapacity = newValue }
+    }
+
+    /// In-memory windows are never pooled, so there is nothing to prewarm.
+    public mutating func prewarmWindows(_ count: Int, resizable: Bool) -> Result<Void, LuminaError> {
+        .success(())
+    }
+
+    public var eventCoalescing: EventCoalescing {
+        get { backend.pipeline.coalescing }
+        set { backend.pipeline.coalescing = newValue }
+    }
+
+    public mutating func setEventCoalescing(_ options: EventCoalescing?, for windowID: WindowID) {
+        backend.pipeline.setCoalescing(options, for: windowID)
+    }
+
+    public func eventCoalescing(for windowID: WindowID) -> EventCoalescing {
+        backend.pipeline.coalescing(for: windowID)
+    }
+
+    public func coalescedPointerSamples(for windowID: WindowID) -> [LogicalPosition] {
+        backend.pipeline.pointerSamples(for: windowID)
+    }
+
+    /// Stored for API parity; the trace was filtered when it was recorded.
+    public var eventMask: EventMask {
+        get { backend.eventMask }
+        set { backend.eventMask = newValue }
+    }
+
+    public mutating func setEventMask(_ mask: EventMask?, for windowID: WindowID) {
+        backend[window: windowID]?.eventMask = mask
+    }
+
+    public func eventMask(for windowID: WindowID) -> EventMask {
+        backend[window: windowID]?.eventMask ?? backend.eventMask
+    }
+
+    public func keyboardState(for windowID: WindowID) -> KeyboardState {
+        backend[window: windowID]?.input.keyboard ?? KeyboardState()
+    }
+
+    public func pointerState(for windowID: WindowID) -> PointerState {
+        backend[window: windowID]?.input.pointer ?? PointerState()
+    }
+
+    /// Stored for API parity; recorded raw motion is replayed regardless.
+    public var rawPointerInput: Bool {
+        get { backend.rawPointerInput }
+        set { backend.rawPointerInput = newValue }
+    }
+
+    /// Records the replayed events, e.g. to check a replay reproduces its trace.
+    public var eventRecorder: EventTraceRecorder? {
+        get { backend.pipeline.recorder }
+        set { backend.pipeline.recorder = newValue }
+    }
+
+    public var instrumentationEnabled: Bool {
+        get { backend.instrumentation.isEnabled }
+        set { backend.instrumentation.isEnabled = newValue }
+    }
+
+    public func statistics() -> EventLoopStatistics {
+        backend.instrumentation.snapshot()
+    }
+
+    public mutating func resetStatistics() {
+        backend.instrumentation.reset()
+    }
+
+    /// Stored for API parity; replay runs no modal loops.
+    public var modalLoopHandler: ModalLoopHandler? {
+        get { backend.modalLoopHandler }
+        set { backend.modalLoopHandler = newValue }
+    }
+
+    public var exitOnLastWindowClosed: Bool {
+        get { backend.exitOnLastWindowClosed }
+        set { backend.exitOnLastWindowClosed = newValue }
+    }
+}
+
+// MARK: - Cursor
+
+/// Position of a replay within its trace, and the recorded-to-live window mapping.
+@MainActor
+internal final class ReplayCursor {
+    private let events: [EventEnvelope]
+    private let pace: ReplayPace
+    private var index = 0
+
+    /// When the first event fell due; set by the first pump
+    private var start: EventTimestamp?
+
+    /// Recorded window IDs in order of first appearance
+    private let recordedWindows: [WindowID]
+    private var windowMap: [WindowID: WindowID] = [:]
+
+    init(trace: EventTrace, pace: ReplayPace) {
+        self.events = trace.events
+        self.pace = pace
+
+        var seen: Set<WindowID> = []
+        var recordedWindows: [WindowID] = []
+        for envelope in trace.events {
+            if let id = envelope.event.windowID, seen.insert(id).inserted {
+                recordedWindows.append(id)
+            }
+        }
+        self.recordedWindows = recordedWindows
+    }
+
+    var isFinished: Bool {
+        index == events.count
+    }
+
+    var replayedCount: Int {
+        index
+    }
+
+    /// Let a newly created window stand in for the next recorded one.
+    func windowCreated(_ id: WindowID) {
+        let slot = windowMap.count
+        if slot < recordedWindows.count {
+            windowMap[recordedWindows[slot]] = id
+        }
+    }
+
+    /// Deliver every event due by now.
+    func pump(into backend: VirtualBackend) -> VirtualBackend.Schedule {
+        let now = EventTimestamp.now()
+        let start = self.start ?? now
+        self.start = start
+
+        while index < events.count {
+            let scheduled = scheduledTime(of: events[index], start: start)
+            if pace != .unpaced && scheduled > now {
+                return .next(scheduled)
+            }
+            deliver(events[index], at: scheduled, to: backend)
+            index += 1
+        }
+        return .finished
+    }
+
+    /// Replay time of an event: its recorded offset, scaled by the pace.
+    private func scheduledTime(of envelope: EventEnvelope, start: EventTimestamp) -> EventTimestamp {
+        let origin = events[0].timestamp.nanoseconds
+        let offset = envelope.timestamp.nanoseconds >= origin ? envelope.timestamp.nanoseconds - origin : 0
+
+        let scaled: UInt64
+        switch pace {
+        case .original, .unpaced:
+            scaled = offset
+        case .accelerated(let factor):
+            scaled = factor > 0 ? UInt64(Double(offset) / factor) : 0
+        }
+        return EventTimestamp(nanoseconds: start.nanoseconds &+ scaled)
+    }
+
+    private func deliver(_ envelope: EventEnvelope, at timestamp: EventTimestamp, to backend: VirtualBackend) {
+        guard let recorded = envelope.event.windowID, let live = windowMap[recorded] else {
+            backend.deliver(EventEnvelope(envelope.event, timestamp: timestamp), to: envelope.event.windowID)
+            return
+        }
+
+        // Re-address the event to the stand-in window via its record encoding
+        let event = EventRecord.encode(envelope.event).flatMap { encoded in
+            var record = encoded.record
+            record.window = live.rawValue
+            return record.event(text: encoded.text ?? "")
+        } ?? envelope.event
+        backend.deliver(EventEnvelope(event, timestamp: timestamp), to: live)
+    }
+}
@@ -0,0 +1,450 @@
+import Dispatch
+
+/// Event loop and window table of the in-memory backends.
+///
+/// Backends without an OS window system (`HeadlessApplication`,
+/// `ReplayApplication`) keep their windows as plain values here and
+/// deliver events from an in-memory queue. The public application types are thin wrappers that
+/// forward the `LuminaApp` requirements to a shared backend, so copies of
+/// an application value see the same windows and queue.
+///
+/// Events enter the queue from two sides: the owner feeds them through
+/// `pump` (recorded events falling due, synthetic input), and window
+/// operations on `VirtualWindow` generate them when `emitsWindowEvents` is
+/// set. User events go through `VirtualUserEvents`, the only part that may
+/// be touched from other threads.
+///
+/// Thread Safety: Must only be accessed from @MainActor.
+@MainActor
+internal final class VirtualBackend {
+    /// State of one in-memory window.
+    struct WindowState {
+        var title: String
+        var size: LogicalSize
+        var position: LogicalPosition
+        var resizable: Bool
+        var scaleFactor: Float
+        let proxy: WindowProxy
+        var isVisible = false
+        var isMinimized = false
+        var isOccluded = false
+        var minSize: LogicalSize?
+        var maxSize: LogicalSize?
+        var input = WindowInputState()
+        var eventMask: EventMask?
+
+        /// Whether nobody can see the window, so it gets no redraws
+        var isHidden: Bool {
+            isMinimized || isOccluded
+        }
+
+        /// The values `proxy` publishes.
+        var snapshot: WindowSnapshot {
+            WindowSnapshot(size: size, scaleFactor: scaleFactor, isVisible: isVisible, isOccluded: isVisible && isHidden)
+        }
+    }
+
+    /// What the owner's `pump` has scheduled after the events it delivered.
+    enum Schedule: Equatable {
+        /// Nothing; only user events or window operations can produce more
+        case idle
+        /// More events become due at the given time
+        case next(EventTimestamp)
+        /// The source has run dry; `run(handler:)` returns once idle
+        case finished
+    }
+
+    private(set) var windows = WindowSlab<WindowState>()
+    private var queue = EventRingBuffer()
+    private var focusedWindow: WindowID?
+    private var redrawRequests: Set<WindowID> = []
+
+    /// Requests of minimized or occluded windows, answered once visible
+    private var parkedRedraws: Set<WindowID> = []
+
+    let userEvents: VirtualUserEvents
+    let pipeline: EventPipeline
+
+    /// Whether window operations queue the events a real window would report.
+    ///
+    /// Off when replaying, where the trace already holds those events.
+    let emitsWindowEvents: Bool
+
+    /// Moves due events into the queue; nil for a purely synthetic source
+    var pump: (@MainActor (VirtualBackend) -> Schedule)?
+
+    /// Called with the ID of every window created, in creation order
+    var windowCreated: (@MainActor (WindowID) -> Void)?
+
+    var controlFlow: ControlFlow = .wait
+    var eventMask: EventMask = .all
+    var rawPointerInput = false
+    var modalLoopHandler: ModalLoopHandler?
+    var exitOnLastWindowClosed = true
+    private(set) var isQuitting = false
+
+    /// Stored for API parity; in-memory windows are cheap enough to never pool
+    var windowPoolCapacity = 0
+
+    init(emitsWindowEvents: Bool) {
+        let instrumentation = EventLoopInstrumentation()
+        self.pipeline = EventPipeline(instrumentation: instrumentation)
+        self.userEvents = VirtualUserEvents(instrumentation: instrumentation)
+        self.emitsWindowEvents = emitsWindowEvents
+    }
+
+    var instrumentation: EventLoopInstrumentation {
+        pipeline.instrumentation
+    }
+
+    // MARK: - Windows
+
+    /// Add a window, placed on `monitor` (or the desktop origin at scale 1).
+    func createWindow(_ descriptor: WindowDescriptor) -> VirtualWindow {
+        let scaleFactor = descriptor.monitor?.scaleFactor ?? 1
+        let id = windows.insert { id in
+            WindowState(
+                title: descriptor.title,
+                size: descriptor.size,
+                position: descriptor.monitor?.position ?? LogicalPosition(x: 0, y: 0),
+                resizable: descriptor.resizable,
+                scaleFactor: scaleFactor,
+                proxy: WindowProxy(id: id, snapshot: WindowSnapshot(size: descriptor.size, scaleFactor: scaleFactor))
+            )
+        }
+        windowCreated?(id)
+        return VirtualWindow(id: id, backend: self, proxy: windows[id]!.proxy)
+    }
+
+    /// Access one window's state (writes through stale IDs are ignored).
+    ///
+    /// Writes publish the new size, scale and visibility to the window's proxy.
+    subscript(window id: WindowID) -> WindowState? {
+        get { windows[id] }
+        set {
+            windows[id] = newValue
+            if let state = windows[id] {
+                state.proxy.publish(state.snapshot)
+            }
+        }
+    }
+
+    /// Remove a window, reporting `.closed` when window events are emitted.
+    func closeWindow(_ id: WindowID) {
+        guard let state = windows.remove(id) else {
+            return
+        }
+        state.proxy.update { $0.isVisible = false }
+        parkedRedraws.remove(id)
+        pipeline.setCoalescing(nil, for: id)
+        if focusedWindow == id {
+            focusedWindow = nil
+        }
+        emit(.window(.closed(id)))
+
+        if exitOnLastWindowClosed && windows.isEmpty {
+            quit()
+        }
+    }
+
+    /// Move keyboard focus to `id`, reporting the change.
+    func focusWindow(_ id: WindowID) {
+        guard windows.contains(id), focusedWindow != id else {
+            return
+        }
+        if let previous = focusedWindow {
+            emit(.window(.unfocused(previous)))
+        }
+        focusedWindow = id
+        emit(.window(.focused(id)))
+    }
+
+    /// Minimize or restore a window, reporting `.minimized`/`.restored`.
+    func setMinimized(_ minimized: Bool, for id: WindowID) {
+        guard var state = windows[id], state.isMinimized != minimized else {
+            return
+        }
+        state.isMinimized = minimized
+        self[window: id] = state
+        emit(.window(minimized ? .minimized(id) : .restored(id)))
+        resumeRedraws(for: id)
+    }
+
+    /// Cover or uncover a window, reporting `.occlusionChanged`.
+    func setOccluded(_ occluded: Bool, for id: WindowID) {
+        guard var state = windows[id], state.isOccluded != occluded else {
+            return
+        }
+        state.isOccluded = occluded
+        self[window: id] = state
+        emit(.window(.occlusionChanged(id, isOccluded: occluded)))
+        resumeRedraws(for: id)
+    }
+
+    /// Queue an event generated by a window operation.
+    func emit(_ event: Event) {
+        guard emitsWindowEvents else {
+            return
+        }
+        deliver(EventEnvelope(event), to: event.windowID)
+    }
+
+    /// Queue an event, folding it into its window's input state first.
+    ///
+    /// - Parameters:
+    ///   - envelope: The event and its timestamp
+    ///   - windowID: The window the event belongs to, if any
+    func deliver(_ envelope: EventEnvelope, to windowID: WindowID?) {
+        if let windowID {
+            windows[windowID]?.input.apply(envelope.event)
+        }
+        queue.append(envelope)
+    }
+
+    /// Queue synthetic input the way a native backend translates OS input.
+    ///
+    /// Events for closed or unknown windows, input outside the window's
+    /// event mask, and raw motion while `rawPointerInput` is off are
+    /// dropped, like the OS messages they stand in for.
+    ///
+    /// - Returns: Whether the event was queued
+    func inject(_ envelope: EventEnvelope) -> Bool {
+        let event = envelope.event
+        if case .pointer(.rawMotion) = event, !rawPointerInput {
+            return false
+        }
+
+        guard let windowID = event.windowID else {
+            queue.append(envelope)
+            instrumentation.count(.eventsTranslated)
+            return true
+        }
+        guard let state = windows[windowID] else {
+            return false
+        }
+        if let category = EventMask.category(of: event), !(state.eventMask ?? eventMask).contains(category) {
+            instrumentation.count(.eventsDropped)
+            return false
+        }
+        deliver(envelope, to: windowID)
+        instrumentation.count(.eventsTranslated)
+        return true
+    }
+
+    /// Record a redraw request; one `.redrawRequested` follows on the next
+    /// poll, however often this is called before it.
+    func requestRedraw(_ id: WindowID) {
+        guard emitsWindowEvents, windows.contains(id), !parkedRedraws.contains(id) else {
+            return
+        }
+        redrawRequests.insert(id)
+    }
+
+    /// Turn pending redraw requests into `.redrawRequested` events, in ID
+    /// order so runs are reproducible. Requests of hidden windows are
+    /// parked instead, like a native window whose display link is paused.
+    private func flushRedraws() {
+        guard !redrawRequests.isEmpty else {
+            return
+        }
+        for id in redrawRequests.sorted(by: { $0.rawValue < $1.rawValue }) {
+            guard let state = windows[id] else {
+                continue
+            }
+            if state.isHidden {
+                parkedRedraws.insert(id)
+            } else {
+                queue.append(EventEnvelope(.window(.redrawRequested(id))))
+            }
+        }
+        redrawRequests.removeAll(keepingCapacity: true)
+    }
+
+    /// Re-queue a parked request once its window can be seen again.
+    private func resumeRedraws(for id: WindowID) {
+        guard let state = windows[id], !state.isHidden, parkedRedraws.remove(id) != nil else {
+            return
+        }
+        redrawRequests.insert(id)
+    }
+
+    // MARK: - Event Loop
+
+    /// Collect everything that has become due into the queue.
+    @discardableResult
+    private func collect() -> Schedule {
+        flushRedraws()
+        return pump?(self) ?? .idle
+    }
+
+    private func pollEvent() -> EventEnvelope? {
+        collect()
+        return queue.popFirst() ?? userEvents.channel.popFirst()
+    }
+
+    private func drainEvents(into events: inout [EventEnvelope], maxCount: Int) -> Int {
+        collect()
+        let queued = queue.drain(into: &events, maxCount: maxCount)
+        return queued + userEvents.channel.drain(into: &events, maxCount: maxCount - queued) { $0 }
+    }
+
+    func pollEnvelope() -> EventEnvelope? {
+        pipeline.next(
+            poll: { pollEvent() },
+            drain: { drainEvents(into: &$0, maxCount: $1) }
+        )
+    }
+
+    func drain<T>(into output: inout [T], maxCount: Int, transform: (EventEnvelope) -> T) -> Int {
+        pipeline.drain(into: &output, maxCount: maxCount, transform: transform) {
+            drainEvents(into: &$0, maxCount: $1)
+        }
+    }
+
+    func pollEnvelope(for windowID: WindowID) -> EventEnvelope? {
+        pipeline.next(for: windowID) {
+            drainEvents(into: &$0, maxCount: $1)
+        }
+    }
+
+    func drain<T>(for windowID: WindowID, into output: inout [T], maxCount: Int, transform: (EventEnvelope) -> T) -> Int {
+        pipeline.drain(for: windowID, into: &output, maxCount: maxCount, transform: transform) {
+            drainEvents(into: &$0, maxCount: $1)
+        }
+    }
+
+    /// Whether an event can be returned without waiting.
+    private var hasPendingEvents: Bool {
+        !queue.isEmpty || !userEvents.channel.isEmpty || !pipeline.isEmpty || !redrawRequests.isEmpty
+    }
+
+    /// Sleep until an event may be pending, `deadline` passes, or the
+    /// source's next event falls due.
+    ///
+    /// Returns at once when the source has finished, so polling loops over
+    /// a drained source spin instead of hanging.
+    func wait(until deadline: ContinuousClock.Instant?) {
+        let schedule = collect()
+        guard !hasPendingEvents && !isQuitting else {
+            return
+        }
+
+        var timeout = deadline?.secondsFromNow
+        switch schedule {
+        case .idle:
+            break
+        case .finished:
+            return
+        case .next(let due):
+            let (seconds, attoseconds) = EventTimestamp.now().duration(to: due).components
+            let untilDue = max(0, Double(seconds) + Double(attoseconds) / 1e18)
+            timeout = min(timeout ?? untilDue, untilDue)
+        }
+
+        if let timeout, timeout <= 0 {
+            return
+        }
+        instrumentation.count(.waits)
+        instrumentation.measure(.wait) {
+            userEvents.wait(timeout: timeout)
+        }
+    }
+
+    /// Run until quit, `.exit`, or (for finite sources) the source runs dry.
+    func run(handler: EventHandler) {
+        isQuitting = false
+
+        withoutActuallyEscaping(handler) { handler in
+            let dispatcher = EventDispatcher(handler: handler, controlFlow: controlFlow)
+            dispatcher.recorder = pipeline.recorder
+
+            var pending: [EventEnvelope] = []
+            pipeline.drainBuffered(into: &pending)
+            requeue(dispatcher.dispatch(pending))
+
+            while !dispatcher.isExiting {
+                pending.removeAll(keepingCapacity: true)
+                let schedule = collect()
+                queue.drain(into: &pending, maxCount: .max)
+                userEvents.channel.drain(into: &pending, maxCount: .max) { $0 }
+                requeue(dispatcher.dispatch(pending))
+
+                if isQuitting {
+                    // Deliver what the handler queued before quitting (e.g.
+                    // the .closed of the last window), then stop
+                    pending.removeAll(keepingCapacity: true)
+                    queue.drain(into: &pending, maxCount: .max)
+                    requeue(dispatcher.dispatch(pending))
+                    return
+                }
+                if schedule == .finished && !hasPendingEvents {
+                    return
+                }
+
+                switch dispatcher.controlFlow {
+                case .poll, .exit:
+                    break
+                case .wait:
+                    wait(until: nil)
+                case .waitUntil(let deadline):
+                    wait(until: deadline)
+                }
+            }
+        }
+    }
+
+    /// Keep events the run(handler:) handler didn't take for the next poll().
+    private func requeue(_ envelopes: ArraySlice<EventEnvelope>) {
+        for envelope in envelopes {
+            pipeline.enqueue(envelope)
+        }
+    }
+
+    func quit() {
+        isQuitting = true
+        userEvents.wake()
+    }
+}
+
+/// User event channel of an in-memory backend, with the semaphore that
+/// wakes its `wait()`.
+///
+/// Thread Safety: `send(_:)` and `wake()` may be called from any thread.
+internal final class VirtualUserEvents: Sendable {
+    let channel = UserEventChannel<EventEnvelope>()
+    private let semaphore = DispatchSemaphore(value: 0)
+    private let instrumentation: EventLoopInstrumentation
+
+    init(instrumentation: EventLoopInstrumentation) {
+        self.instrumentation = instrumentation
+    }
+
+    /// Queue a user event, waking a sleeping `wait()`.
+    func send(_ event: UserEvent) {
+        // Only the first send since the last drain needs a wakeup
+        let needsWakeup = instrumentation.measure(.enqueue) {
+            channel.send(EventEnvelope(.user(event)))
+        }
+        if needsWakeup {
+            instrumentation.count(.wakeups)
+            semaphore.signal()
+        }
+    }
+
+    /// Wake a sleeping `wait()` without an event.
+    func wake() {
+        semaphore.signal()
+    }
+
+    /// Sleep until woken or `timeout` seconds elapse (nil = no timeout).
+    ///
+    /// Wakeups left over from events that were drained meanwhile make this
+    /// return early; callers treat that like any spurious return.
+    func wait(timeout: Double?) {
+        guard let timeout else {
+            semaphore.wait()
+            return
+        }
+        _ = semaphore.wait(timeout: .now() + timeout)
+    }
+}
@@ -0,0 +1,114 @@
+/// Window of an in-memory backend.
+///
+/// A handle to a `VirtualBackend.WindowState`; every operation updates
+/// that state and, when the backend emits window events, queues the event
+/// a native window would report (`.resized`, `.moved`, `.focused`, ...).
+/// Operations on a closed window are ignored and queries return zero
+/// values, mirroring a destroyed native handle.
+@MainActor
+internal struct VirtualWindow: LuminaWindow {
+    let id: WindowID
+    private let backend: VirtualBackend
+    private let stateProxy: WindowProxy
+
+    init(id: WindowID, backend: VirtualBackend, proxy: WindowProxy) {
+        self.id = id
+        self.backend = backend
+        self.stateProxy = proxy
+    }
+
+    mutating func show() {
+        backend[window: id]?.isVisible = true
+    }
+
+    mutating func hide() {
+        backend[window: id]?.isVisible = false
+    }
+
+    consuming func close() {
+        backend.closeWindow(id)
+    }
+
+    mutating func setTitle(_ title: String) {
+        backend[window: id]?.title = title
+    }
+
+    func size() -> LogicalSize {
+        backend[window: id]?.size ?? LogicalSize(width: 0, height: 0)
+    }
+
+    mutating func resize(_ size: LogicalSize) {
+        guard var state = backend[window: id] else {
+            return
+        }
+        let clamped = Self.clamp(size, min: state.minSize, max: state.maxSize)
+        guard clamped != state.size else {
+            return
+        }
+        state.size = clamped
+        backend[window: id] = state
+        backend.emit(.window(.resized(id, clamped)))
+    }
+
+    func position() -> LogicalPosition {
+        backend[window: id]?.position ?? LogicalPosition(x: 0, y: 0)
+    }
+
+    mutating func moveTo(_ position: LogicalPosition) {
+        guard let current = backend[window: id]?.position, current != position else {
+            return
+        }
+        backend[window: id]?.position = position
+        backend.emit(.window(.moved(id, position)))
+    }
+
+    mutating func setMinSize(_ size: LogicalSize?) {
+        backend[window: id]?.minSize = size
+        resize(self.size())
+    }
+
+    mutating func setMaxSize(_ size: LogicalSize?) {
+        backend[window: id]?.maxSize = size
+        resize(self.size())
+    }
+
+    mutating func requestFocus() {
+        backend.focusWindow(id)
+    }
+
+    func scaleFactor() -> Float {
+        backend[window: id]?.scaleFactor ?? 1
+    }
+
+    func proxy() -> WindowProxy {
+        stateProxy
+    }
+
+    func requestRedraw() {
+        backend.requestRedraw(id)
+    }
+
+    func rawWindowHandle() -> RawWindowHandle {
+        .unavailable
+    }
+
+    /// Nothing is presented, so there is no surface to render to.
+    mutating func surface() -> Result<NativeSurface, LuminaError> {
+        .failure(.platformNotSupported(operation: "Native surfaces"))
+    }
+
+    /// Clamp a size to optional per-axis bounds (the minimum wins on conflict).
+    static func clamp(_ size: LogicalSize, min minSize: LogicalSize?, max maxSize: LogicalSize?) -> LogicalSize {
+        var width = size.width
+        var height = size.height
+        if let maxSize {
+            width = Swift.min(width, maxSize.width)
+            height = Swift.min(height, maxSize.height)
+        }
+        if let minSize {
+            width = Swift.max(width, minSize.width)
+            height = Swift.max(height, minSize.height)
+        }
+        return LogicalSize(width: width, height: height)
+    }
+}
@@ -26,31 +26,50 @@ public enum DpiAwarenessLevel: Sendable {
     case unknown
 }
 
-/// Thread-safe user event queue
-private final class UserEventQueue: @unchecked Sendable {
-    private let lock = NSLock()
-    private var events: [UserEvent] = []
+// Custom message ID for user events (WM_USER + 1)
+private let WM_LUMINA_USER_EVENT: UINT = UINT(WM_USER + 1)
 
-    func append(_ event: UserEvent) {
-        lock.lock()
-        defer { lock.unlock() }
-        events.append(event)
-    }
+// CreateWaitableTimerExW flag (Windows 10 1803+); not in all SDK headers
+private let CREATE_WAITABLE_TIMER_HIGH_RESOLUTION: DWORD = 0x0000_0002
 
-    func removeAll() -> [UserEvent] {
-        lock.lock()
-        defer { lock.unlock() }
-        let allEvents = events
-        events.removeAll()
-        return allEvents
+// TIMER_ALL_ACCESS (function-like macro, not imported)
+private let TIMER_ALL_ACCESS_MASK: DWORD = 0x001F_0003
+
+/// Waitable timer used to bound `wait(until:)`.
+///
+/// Prefers a high-resolution timer, which isn't subject to the default
+/// 15.6 ms system timer granularity; falls back to a regular waitable timer
+/// on older systems. Shared by reference so copies of the application use
+/// one kernel object.
+private final class WinDeadlineTimer {
+    let handle: HANDLE?
+
+    init() {
+        let highResolution = CreateWaitableTimerExW(
+            nil, nil, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS_MASK
+        )
+        self.handle = highResolution ?? CreateWaitableTimerExW(nil, nil, 0, TIMER_ALL_ACCESS_MASK)
     }
-}
 
-/// Thread-safe window event queue (removed - using GlobalEventQueue in WinWindow.swift)
-/// This class is no longer needed as we removed the duplicate WindowEventQueue
+    deinit {
+        if let handle {
+            CloseHandle(handle)
+        }
+    }
 
-// Custom message ID for user events (WM_USER + 1)
-private let WM_LUMINA_USER_EVENT: UINT = UINT(WM_USER + 1)
+    /// Arm the timer to fire after `seconds`.
+    ///
+    /// - Returns: false if the timer could not be armed
+    func arm(seconds: Double) -> Bool {
+        guard let handle else {
+            return false
+        }
+        // Negative due time = relative, in 100 ns units
+        var dueTime = LARGE_INTEGER()
+        dueTime.QuadPart = -max(1, Int64(seconds * 10_000_000))
+        return SetWaitableTimer(handle, &dueTime, 0, nil, nil, false)
+    }
+}
 
 /// Windows implementation of LuminaApp.
 ///
@@ -61,7 +80,8 @@ private let WM_LUMINA_USER_EVENT: UINT = UINT(WM_USER + 1)
 @MainActor
 struct WinApplication: LuminaApp {
     private var shouldQuit: Bool = false
-    private let userEventQueue = UserEventQueue()
+    private let userEventChannel = UserEventChannel<EventEnvelope>()
+    private let pipeline = EventPipeline(instrumentation: WinWindowRegistry.shared.instrumentation)
     // Note: Window tracking is handled by WinWindowRegistry in WinWindow.swift
     private var onWindowClosed: WindowCloseCallback?
 
@@ -74,6 +94,48 @@ struct WinApplication: LuminaApp {
     /// Whether the application should quit when the last window is closed.
     var exitOnLastWindowClosed: Bool = true
 
+    /// How waitForEvents() sleeps when idle.
+    var controlFlow: ControlFlow = .wait
+
+    /// Run from WndProc during modal size/move loops, so it lives in the registry.
+    var modalLoopHandler: ModalLoopHandler? {
+        get { WinWindowRegistry.shared.modalLoopHandler }
+        set {
+            WinWindowRegistry.shared.modalLoopHandler = newValue
+            WinWindowRegistry.shared.modalLoopPipeline = newValue == nil ? nil : pipeline
+        }
+    }
+
+    private let deadlineTimer = WinDeadlineTimer()
+
+    private let rawInput = WinRawInputReader()
+
+    /// Receives every event handed to the application.
+    var eventRecorder: EventTraceRecorder? {
+        get { pipeline.recorder }
+        set { pipeline.recorder = newValue }
+    }
+
+    /// Shared with WinWindowRegistry, where WndProc reports translations.
+    var instrumentationEnabled: Bool {
+        get { pipeline.instrumentation.isEnabled }
+        set { pipeline.instrumentation.isEnabled = newValue }
+    }
+
+    func statistics() -> EventLoopStatistics {
+        pipeline.instrumentation.snapshot()
+    }
+
+    mutating func resetStatistics() {
+        pipeline.instrumentation.reset()
+    }
+
+    /// Deliver `.pointer(.rawMotion)` from Raw Input (WM_INPUT).
+    var rawPointerInput: Bool {
+        get { rawInput.isEnabled }
+        set { rawInput.setEnabled(newValue) }
+    }
+
     init() throws {
         // Capture the main thread ID for use in postUserEvent
         self.mainThreadId = GetCurrentThreadId()
@@ -96,27 +158,150 @@ struct WinApplication: LuminaApp {
     }
 
     public mutating func run() throws {
+        try run { _ in .wait }
+    }
+
+    mutating func run(handler: EventHandler) throws {
         shouldQuit = false
 
-        // Windows message pump - blocking until quit
-        var msg = MSG()
-        while true {
-            let hasMessage = GetMessageW(&msg, nil, 0, 0)
-            if !hasMessage || msg.message == UINT(WM_QUIT) {
-                break
-            }
+        try withoutActuallyEscaping(handler) { handler in
+            let dispatcher = EventDispatcher(handler: handler, controlFlow: controlFlow)
+            dispatcher.recorder = pipeline.recorder
 
-            TranslateMessage(&msg)
-            DispatchMessageW(&msg)
+            // Events buffered by earlier poll() calls go first
+            var pending: [EventEnvelope] = []
+            pipeline.drainBuffered(into: &pending)
+            requeue(dispatcher.dispatch(pending))
 
-            // Process user events if we received our custom message
-            if msg.message == WM_LUMINA_USER_EVENT {
-                processUserEvents()
+            // From here on WndProc dispatches directly
+            WinWindowRegistry.shared.dispatcher = dispatcher
+            defer { WinWindowRegistry.shared.dispatcher = nil }
+
+            while !dispatcher.isExiting {
+                WinWindowRegistry.shared.flushRedraws()
+
+                var msg = MSG()
+                while !dispatcher.isExiting, nextMessage(&msg) {
+                    if msg.message == UINT(WM_QUIT) {
+                        return
+                    }
+                    dispatchMessage(&msg)
+                }
+
+                // Events that don't come from WndProc (raw input, user events)
+                pending.removeAll(keepingCapacity: true)
+                GlobalEventQueue.shared.drain(into: &pending)
+                userEventChannel.drain(into: &pending, maxCount: .max) { $0 }
+                requeue(dispatcher.dispatch(pending))
+
+                switch dispatcher.controlFlow {
+                case .poll, .exit:
+                    break
+                case .wait:
+                    waitForMessage(timeout: nil)
+                case .waitUntil(let deadline):
+                    // A passed deadline has nothing left to wake for; wait
+                    let timeout = deadline.secondsFromNow
+                    waitForMessage(timeout: timeout > 0 ? timeout : nil)
+                }
             }
         }
     }
 
+    /// Keep events the run(handler:) handler didn't take for the next poll().
+    private func requeue(_ envelopes: ArraySlice<EventEnvelope>) {
+        for envelope in envelopes {
+            pipeline.enqueue(envelope)
+        }
+    }
+
     mutating func poll() throws -> Event? {
+        try pollEnvelope()?.event
+    }
+
+    mutating func pollEnvelope() throws -> EventEnvelope? {
+        pipeline.next(
+            poll: { pollPlatformEvent() },
+            drain: { drainPlatformEvents(into: &$0, maxCount: $1) }
+        )
+    }
+
+    mutating func drain(into events: inout [Event], maxCount: Int) throws -> Int {
+        pipeline.drain(into: &events, maxCount: maxCount, transform: \.event) {
+            drainPlatformEvents(into: &$0, maxCount: $1)
+        }
+    }
+
+    mutating func drain(into envelopes: inout [EventEnvelope], maxCount: Int) throws -> Int {
+        pipeline.drain(into: &envelopes, maxCount: maxCount, transform: { $0 }) {
+            drainPlatformEvents(into: &$0, maxCount: $1)
+        }
+    }
+
+    mutating func setWindowEventQueue(_ enabled: Bool, for windowID: WindowID) {
+        pipeline.setWindowQueue(enabled, for: windowID)
+    }
+
+    func hasWindowEventQueue(for windowID: WindowID) -> Bool {
+        pipeline.hasWindowQueue(for: windowID)
+    }
+
+    mutating func poll(window windowID: WindowID) throws -> Event? {
+        pipeline.next(for: windowID) {
+            drainPlatformEvents(into: &$0, maxCount: $1)
+        }?.event
+    }
+
+    mutating func drain(window windowID: WindowID, into events: inout [Event], maxCount: Int) throws -> Int {
+        pipeline.drain(for: windowID, into: &events, maxCount: maxCount, transform: \.event) {
+            drainPlatformEvents(into: &$0, maxCount: $1)
+        }
+    }
+
+    var eventCoalescing: EventCoalescing {
+        get { pipeline.coalescing }
+        set { pipeline.coalescing = newValue }
+    }
+
+    mutating func setEventCoalescing(_ options: EventCoalescing?, for windowID: WindowID) {
+        pipeline.setCoalescing(options, for: windowID)
+    }
+
+    func eventCoalescing(for windowID: WindowID) -> EventCoalescing {
+        pipeline.coalescing(for: windowID)
+    }
+
+    func coalescedPointerSamples(for windowID: WindowID) -> [LogicalPosition] {
+        pipeline.pointerSamples(for: windowID)
+    }
+
+    var eventMask: EventMask {
+        get { WinWindowRegistry.shared.eventMask }
+        set { WinWindowRegistry.shared.eventMask = newValue }
+    }
+
+    mutating func setEventMask(_ mask: EventMask?, for windowID: WindowID) {
+        WinWindowRegistry.shared.record(for: windowID)?.eventMask = mask
+    }
+
+    func eventMask(for windowID: WindowID) -> EventMask {
+        WinWindowRegistry.shared.record(for: windowID)?.eventMask ?? eventMask
+    }
+
+    func keyboardState(for windowID: WindowID) -> KeyboardState {
+        WinWindowRegistry.shared.record(for: windowID)?.input.keyboard ?? KeyboardState()
+    }
+
+    func pointerState(for windowID: WindowID) -> PointerState {
+        WinWindowRegistry.shared.record(for: windowID)?.input.pointer ?? PointerState()
+    }
+
+    /// Return the next event straight from the WndProc and user queues.
+    private mutating func pollPlatformEvent() -> EventEnvelope? {
+        // Turn redraw requests into invalidations; WM_PAINT follows once
+        // the message queue is empty
+        WinWindowRegistry.shared.flushRedraws()
+
         // First, check if we have any queued events from WndProc
         if let event = GlobalEventQueue.shared.removeFirst() {
             return event
@@ -127,13 +312,14 @@ struct WinApplication: LuminaApp {
             // Non-blocking message pump
             var msg = MSG()
 
-            guard PeekMessageW(&msg, nil, 0, 0, UINT(PM_REMOVE)) else {
-                // No messages available, check queue one more time
-                return GlobalEventQueue.shared.removeFirst()
+            guard nextMessage(&msg) else {
+                // No messages available, check queues one more time
+                // (user events can outnumber their wake-up messages when the
+                // thread message queue is full)
+                return GlobalEventQueue.shared.removeFirst() ?? pollUserEvent()
             }
 
-            TranslateMessage(&msg)
-            DispatchMessageW(&msg)
+            dispatchMessage(&msg)
 
             // Check for user events
             if msg.message == WM_LUMINA_USER_EVENT {
@@ -152,40 +338,142 @@ struct WinApplication: LuminaApp {
         }
     }
 
-    /// Poll for a single user event from the queue.
-    private mutating func pollUserEvent() -> Event? {
-        let pendingEvents = userEventQueue.removeAll()
-        guard let userEvent = pendingEvents.first else {
-            return nil
-        }
+    /// Pump every pending message, then drain the WndProc and user queues.
+    private mutating func drainPlatformEvents(into events: inout [EventEnvelope], maxCount: Int) -> Int {
+        WinWindowRegistry.shared.flushRedraws()
 
-        // Re-queue remaining events
-        for event in pendingEvents.dropFirst() {
-            userEventQueue.append(event)
+        // Pump every pending message first so WndProc has queued its events
+        var msg = MSG()
+        while nextMessage(&msg) {
+            dispatchMessage(&msg)
         }
 
-        return .user(userEvent)
+        // Window/input events first, then user events, each taken in one batch.
+        // User events are drained regardless of WM_LUMINA_USER_EVENT, since a
+        // flooded thread message queue drops wake-up messages.
+        let windowCount = GlobalEventQueue.shared.drain(into: &events, maxCount: maxCount)
+        let userCount = userEventChannel.drain(into: &events, maxCount: maxCount - windowCount) { $0 }
+        return windowCount + userCount
     }
 
-    public mutating func wait() throws {
-        // Low-power wait for next message
-        WaitMessage()
+    /// Remove the next message from the queue, first reading the raw input
+    /// buffer when that message is WM_INPUT.
+    ///
+    /// GetRawInputBuffer takes every queued sample in one call, so it runs
+    /// when the pump reaches the first WM_INPUT rather than before the
+    /// pump: the samples then follow every message queued ahead of them,
+    /// and one read replaces a GetRawInputData call per sample.
+    private func nextMessage(_ msg: inout MSG) -> Bool {
+        guard PeekMessageW(&msg, nil, 0, 0, UINT(PM_NOREMOVE)) else {
+            return false
+        }
+        if msg.message == UINT(WM_INPUT) && rawInput.isEnabled {
+            rawInput.readBuffer(into: GlobalEventQueue.shared)
+        }
+        return PeekMessageW(&msg, nil, 0, 0, UINT(PM_REMOVE))
+    }
 
-        // After waking, process one message
-        var msg = MSG()
-        if PeekMessageW(&msg, nil, 0, 0, UINT(PM_REMOVE)) {
+    /// Translate and dispatch one message to its WndProc.
+    private func dispatchMessage(_ msg: inout MSG) {
+        let instrumentation = pipeline.instrumentation
+        instrumentation.count(.messagesDispatched)
+        instrumentation.measure(.dispatch) {
             TranslateMessage(&msg)
             DispatchMessageW(&msg)
+        }
+    }
 
-            if msg.message == WM_LUMINA_USER_EVENT {
-                processUserEvents()
+    /// Poll for a single user event from the queue.
+    private mutating func pollUserEvent() -> EventEnvelope? {
+        userEventChannel.popFirst()
+    }
+
+    public mutating func wait() throws {
+        waitForMessage(timeout: nil)
+    }
+
+    public mutating func wait(until deadline: ContinuousClock.Instant) throws {
+        let timeout = deadline.secondsFromNow
+        guard timeout > 0 else {
+            return
+        }
+        waitForMessage(timeout: timeout)
+    }
+
+    func waitAsync() async throws {
+        // Let main-actor work scheduled meanwhile run before sleeping
+        await Task.yield()
+        waitForMessage(timeout: nil)
+    }
+
+    /// Block until a message arrives or `timeout` seconds elapse (nil = no timeout).
+    private func waitForMessage(timeout: Double?) {
+        // Events already collected from the channel, posted by WndProc
+        // outside the pump (ShowWindow, SetWindowPos, DestroyWindow) or
+        // buffered by the pipeline won't trigger another wakeup
+        guard userEventChannel.isEmpty && GlobalEventQueue.shared.isEmpty && pipeline.isEmpty else {
+            return
+        }
+
+        // Animating windows also wake for the next vertical blank, when the
+        // following poll()/drain() flushes their redraws; input, user
+        // events and an earlier deadline still end the wait first
+        var timeout = timeout
+        if WinWindowRegistry.shared.hasPendingRedraws {
+            let untilRedraw = WinWindowRegistry.shared.secondsUntilRedraw
+            guard untilRedraw > 0 else {
+                return
+            }
+            timeout = min(timeout ?? untilRedraw, untilRedraw)
+        }
+
+        let instrumentation = pipeline.instrumentation
+        instrumentation.count(.waits)
+        instrumentation.measure(.wait) {
+            sleepUntilMessage(timeout: timeout)
+        }
+    }
+
+    /// MsgWaitForMultipleObjectsEx part of `waitForMessage(timeout:)`.
+    private func sleepUntilMessage(timeout: Double?) {
+        // Low-power wait for the next message, or for the deadline timer.
+        // MWMO_INPUTAVAILABLE also returns for input that arrived before the
+        // call, which WaitMessage() would sleep through.
+        let wakeMask = DWORD(QS_ALLINPUT)
+        let flags = DWORD(MWMO_INPUTAVAILABLE)
+        if let timeout, deadlineTimer.arm(seconds: timeout) {
+            var handles: [HANDLE?] = [deadlineTimer.handle]
+            let result = MsgWaitForMultipleObjectsEx(1, &handles, DWORD(INFINITE), wakeMask, flags)
+            if result == DWORD(WAIT_OBJECT_0) {
+                // Deadline reached without a message
+                return
             }
+        } else if let timeout {
+            // No waitable timer available; fall back to a millisecond timeout
+            let milliseconds = DWORD(min((timeout * 1000).rounded(.up), Double(DWORD.max - 1)))
+            let result = MsgWaitForMultipleObjectsEx(0, nil, milliseconds, wakeMask, flags)
+            if result == DWORD(WAIT_TIMEOUT) {
+                return
+            }
+        } else {
+            MsgWaitForMultipleObjectsEx(0, nil, DWORD(INFINITE), wakeMask, flags)
         }
+
+        // The message that woke us is left for the next poll()/drain(), so
+        // user events and WM_QUIT are never consumed here
     }
 
     public func postUserEvent(_ event: UserEvent) {
-        // Add event to queue
-        userEventQueue.append(event)
+        // Lock-free enqueue; only the first post since the last drain needs
+        // to wake the message loop, later posts ride on the pending wakeup
+        let instrumentation = pipeline.instrumentation
+        let needsWakeup = instrumentation.measure(.enqueue) {
+            userEventChannel.send(EventEnvelope(.user(event)))
+        }
+        guard needsWakeup else {
+            return
+        }
+        instrumentation.count(.wakeups)
 
         // Wake up the message loop by posting a custom message to the MAIN thread
         // Use the captured mainThreadId, not GetCurrentThreadId() which returns the calling thread
@@ -198,41 +486,97 @@ struct WinApplication: LuminaApp {
         resizable: Bool,
         monitor: Monitor?
     ) -> Result<LuminaWindow, LuminaError> {
+        let descriptor = WindowDescriptor(title: title, size: size, resizable: resizable, monitor: monitor)
+        return WinWindow.create(
+            descriptor,
+            placement: WinWindowPlacement(monitor: monitor),
+            closeCallback: makeCloseCallback()
+        ).map { $0 as LuminaWindow }
+    }
+
+    mutating func createWindows(_ descriptors: [WindowDescriptor]) -> Result<[LuminaWindow], LuminaError> {
+        let closeCallback = makeCloseCallback()
+
+        // Monitor lookup and DPI are resolved once per distinct monitor
+        var placements: [MonitorID?: WinWindowPlacement] = [:]
+        var windows: [WinWindow] = []
+        windows.reserveCapacity(descriptors.count)
+
+        for descriptor in descriptors {
+            let key = descriptor.monitor?.id
+            let placement = placements[key] ?? WinWindowPlacement(monitor: descriptor.monitor)
+            placements[key] = placement
+
+            switch WinWindow.create(descriptor, placement: placement, closeCallback: closeCallback) {
+            case .success(let window):
+                windows.append(window)
+            case .failure(let error):
+                // All or nothing; the discarded windows never report .closed
+                for window in windows {
+                    window.discard()
+                }
+                return .failure(error)
+            }
+        }
+
+        // Note: Windows are registered in WinWindowRegistry by WinWindow.create()
+        return .success(windows.map { $0 as LuminaWindow })
+    }
+
+    /// Close handling shared by every window created by this application.
+    private func makeCloseCallback() -> WindowCloseCallback {
         // Capture values for the close callback
         let threadId = mainThreadId
         let shouldExitOnLastWindow = exitOnLastWindowClosed
 
-        // Create the window using WinWindow
-        let result = WinWindow.create(
-            title: title,
-            size: size,
-            resizable: resizable,
-            monitor: monitor,
-            closeCallback: { [onWindowClosed] windowID in
-                // Note: WinWindowRegistry.unregister() is already called by WndProc on WM_DESTROY
-                // So we don't need to unregister here
-
-                // Post a window closed event for custom event loops
-                GlobalEventQueue.shared.append(.window(.closed(windowID)))
-
-                // Wake up the event loop by posting a user event
-                PostThreadMessageW(threadId, WM_LUMINA_USER_EVENT, 0, 0)
-
-                // Trigger the application's close callback
-                onWindowClosed?(windowID)
-
-                // Check if we should quit (after the callbacks)
-                // WinWindowRegistry already tracks window count
-                if shouldExitOnLastWindow && WinWindowRegistry.shared.windowCount == 0 {
-                    PostQuitMessage(0)
-                }
+        return { [onWindowClosed, pipeline] windowID in
+            // Note: WinWindowRegistry.unregister() is already called by WndProc on WM_DESTROY
+            // So we don't need to unregister here
+            pipeline.setCoalescing(nil, for: windowID)
+
+            // Post a window closed event for custom event loops
+            WinWindowRegistry.shared.post(EventEnvelope(.window(.closed(windowID))))
+
+            // Wake up the event loop by posting a user event
+            PostThreadMessageW(threadId, WM_LUMINA_USER_EVENT, 0, 0)
+
+            // Trigger the application's close callback
+            onWindowClosed?(windowID)
+
+            // Check if we should quit (after the callbacks)
+            // WinWindowRegistry already tracks window count
+            if shouldExitOnLastWindow && WinWindowRegistry.shared.windowCount == 0 {
+                PostQuitMessage(0)
             }
-        )
+        }
+    }
 
-        // Note: Window is registered in WinWindowRegistry by WinWindow.create()
-        // No need for duplicate tracking here
+    var windowPoolCapacity: Int {
+        get { WinWindowRegistry.shared.windowPoolCapacity }
+        set { WinWindowRegistry.shared.windowPoolCapacity = newValue }
+    }
 
-        return result.map { $0 as LuminaWindow }
+    mutating func prewarmWindows(_ count: Int, resizable: Bool) -> Result<Void, LuminaError> {
+        let registry = WinWindowRegistry.shared
+        let placement = WinWindowPlacement(monitor: nil)
+
+        var created = 0
+        while created < count && registry.canPoolWindow {
+            let result = WinWindow.createHiddenWindow(
+                title: "",
+                size: LogicalSize(width: 640, height: 480),
+                resizable: resizable,
+                placement: placement
+            )
+            switch result {
+            case .success(let hwnd):
+                _ = registry.parkWindow(hwnd, resizable: resizable)
+                created += 1
+            case .failure(let error):
+                return .failure(error)
+            }
+        }
+        return .success(())
     }
 
     mutating func setWindowCloseCallback(_ callback: @escaping WindowCloseCallback) {
@@ -248,14 +592,6 @@ struct WinApplication: LuminaApp {
 
     // MARK: - Private Helpers
 
-    private mutating func processUserEvents() {
-        let _ = userEventQueue.removeAll()
-        // In Milestone 0, we don't have a callback mechanism yet
-        // User events are queued but need to be retrieved through
-        // a future API (event handlers/callbacks will be added later)
-        // For now, they're just processed and discarded
-    }
-
     /// Queries the current DPI awareness level from Windows
     private static func queryDpiAwarenessLevel() -> DpiAwarenessLevel {
         // Get the DPI awareness context for the current thread
@@ -17,60 +17,106 @@ import WinSDK
 ///   - msg: The Windows message ID
 ///   - wParam: First message parameter
 ///   - lParam: Second message parameter
-///   - windowID: The WindowID associated with this event
+///   - record: The window receiving the message; key messages read its
+///     keyboard state, which WndProc updates from the returned event
 /// - Returns: Lumina Event, or nil if the event should be ignored
 internal func translateWindowsMessage(
     msg: UINT,
     wParam: WPARAM,
     lParam: LPARAM,
-    for windowID: WindowID
+    for record: WinWindowRecord
 ) -> Event? {
+    let windowID = record.windowID
+
+    // Client coordinates are pixels; the cached metrics hold the conversion
+    let pointsPerPixel = record.metrics.pointsPerPixel
+
+    // Drop unsubscribed input before doing any translation work
+    if let category = inputCategory(of: msg),
+       !(record.eventMask ?? WinWindowRegistry.shared.eventMask).contains(category) {
+        WinWindowRegistry.shared.instrumentation.count(.eventsDropped)
+        return nil
+    }
+
     // Switch on message type
     switch msg {
     case UINT(WM_MOUSEMOVE):
-        return translateMouseMove(wParam, lParam, windowID)
+        return translateMouseMove(wParam, lParam, windowID, pointsPerPixel)
+
+    case UINT(WM_MOUSELEAVE):
+        // Requested with TrackMouseEvent by WndProc on the first move inside
+        return .pointer(.left(windowID))
 
     case UINT(WM_LBUTTONDOWN):
-        return translateMouseDown(.left, wParam, lParam, windowID)
+        return translateMouseDown(.left, wParam, lParam, windowID, pointsPerPixel)
     case UINT(WM_LBUTTONUP):
-        return translateMouseUp(.left, wParam, lParam, windowID)
+        return translateMouseUp(.left, wParam, lParam, windowID, pointsPerPixel)
 
     case UINT(WM_RBUTTONDOWN):
-        return translateMouseDown(.right, wParam, lParam, windowID)
+        return translateMouseDown(.right, wParam, lParam, windowID, pointsPerPixel)
     case UINT(WM_RBUTTONUP):
-        return translateMouseUp(.right, wParam, lParam, windowID)
+        return translateMouseUp(.right, wParam, lParam, windowID, pointsPerPixel)
 
     case UINT(WM_MBUTTONDOWN):
-        return translateMouseDown(.middle, wParam, lParam, windowID)
+        return translateMouseDown(.middle, wParam, lParam, windowID, pointsPerPixel)
     case UINT(WM_MBUTTONUP):
-        return translateMouseUp(.middle, wParam, lParam, windowID)
+        return translateMouseUp(.middle, wParam, lParam, windowID, pointsPerPixel)
+
+    case UINT(WM_INPUT):
+        // Stragglers not already consumed by WinRawInputReader.readBuffer
+        return translateRawInput(lParam)
 
     case UINT(WM_MOUSEWHEEL):
         return translateMouseWheel(wParam, lParam, windowID)
 
     case UINT(WM_KEYDOWN), UINT(WM_SYSKEYDOWN):
-        return translateKeyDown(wParam, lParam, windowID)
+        return translateKeyDown(wParam, lParam, record)
     case UINT(WM_KEYUP), UINT(WM_SYSKEYUP):
-        return translateKeyUp(wParam, lParam, windowID)
+        return translateKeyUp(wParam, lParam, record)
 
-    case UINT(WM_CHAR):
-        return translateChar(wParam, windowID)
+    // WM_CHAR is translated in WndProc, which pairs UTF-16 surrogates per window
 
     case UINT(WM_SIZE):
-        return translateSize(lParam, windowID)
+        return translateSize(lParam, windowID, pointsPerPixel)
 
     case UINT(WM_MOVE):
-        return translateMove(lParam, windowID)
+        return translateMove(lParam, windowID, pointsPerPixel)
+
+    case UINT(WM_ENTERSIZEMOVE):
+        return .window(.liveResizeStarted(windowID))
+
+    case UINT(WM_EXITSIZEMOVE):
+        return .window(.liveResizeEnded(windowID))
 
     case UINT(WM_SETFOCUS):
+        // Modifiers held while focus was elsewhere sent their keyDown to
+        // another window; pick them up once here instead of per key message
+        seedModifierKeys(record)
         return .window(.focused(windowID))
 
     case UINT(WM_KILLFOCUS):
         return .window(.unfocused(windowID))
 
-    case UINT(WM_DPICHANGED):
-        return translateDpiChanged(wParam, windowID)
+    // WM_DPICHANGED is translated in WndProc, which knows the previous DPI
+
+    default:
+        return nil
+    }
+}
 
+/// The EventMask category of an input message, or nil for window messages.
+private func inputCategory(of msg: UINT) -> EventMask? {
+    switch msg {
+    case UINT(WM_MOUSEMOVE), UINT(WM_MOUSELEAVE):
+        return .pointerMotion
+    case UINT(WM_LBUTTONDOWN), UINT(WM_LBUTTONUP),
+         UINT(WM_RBUTTONDOWN), UINT(WM_RBUTTONUP),
+         UINT(WM_MBUTTONDOWN), UINT(WM_MBUTTONUP):
+        return .pointerButtons
+    case UINT(WM_MOUSEWHEEL):
+        return .wheel
+    case UINT(WM_KEYDOWN), UINT(WM_SYSKEYDOWN), UINT(WM_KEYUP), UINT(WM_SYSKEYUP):
+        return .keyboard
     default:
         return nil
     }
@@ -81,9 +127,10 @@ internal func translateWindowsMessage(
 private func translateMouseMove(
     _ wParam: WPARAM,
     _ lParam: LPARAM,
-    _ windowID: WindowID
+    _ windowID: WindowID,
+    _ pointsPerPixel: Float
 ) -> Event? {
-    let position = extractMousePosition(lParam)
+    let position = extractMousePosition(lParam, pointsPerPixel)
     return .pointer(.moved(windowID, position: position))
 }
 
@@ -91,9 +138,10 @@ private func translateMouseDown(
     _ button: MouseButton,
     _ wParam: WPARAM,
     _ lParam: LPARAM,
-    _ windowID: WindowID
+    _ windowID: WindowID,
+    _ pointsPerPixel: Float
 ) -> Event? {
-    let position = extractMousePosition(lParam)
+    let position = extractMousePosition(lParam, pointsPerPixel)
     return .pointer(.buttonPressed(windowID, button: button, position: position))
 }
 
@@ -101,9 +149,10 @@ private func translateMouseUp(
     _ button: MouseButton,
     _ wParam: WPARAM,
     _ lParam: LPARAM,
-    _ windowID: WindowID
+    _ windowID: WindowID,
+    _ pointsPerPixel: Float
 ) -> Event? {
-    let position = extractMousePosition(lParam)
+    let position = extractMousePosition(lParam, pointsPerPixel)
     return .pointer(.buttonReleased(windowID, button: button, position: position))
 }
 
@@ -124,76 +173,86 @@ private func translateMouseWheel(
 private func translateKeyDown(
     _ wParam: WPARAM,
     _ lParam: LPARAM,
-    _ windowID: WindowID
+    _ record: WinWindowRecord
 ) -> Event? {
     let keyCode = translateKeyCode(wParam, lParam)
-    let modifiers = translateModifiers()
-    return .keyboard(.keyDown(windowID, key: keyCode, modifiers: modifiers))
+    let modifiers = translateModifiers(record.input.keyboard, after: keyCode, pressed: true)
+    return .keyboard(.keyDown(record.windowID, key: keyCode, modifiers: modifiers))
 }
 
 private func translateKeyUp(
     _ wParam: WPARAM,
     _ lParam: LPARAM,
-    _ windowID: WindowID
+    _ record: WinWindowRecord
 ) -> Event? {
     let keyCode = translateKeyCode(wParam, lParam)
-    let modifiers = translateModifiers()
-    return .keyboard(.keyUp(windowID, key: keyCode, modifiers: modifiers))
+    let modifiers = translateModifiers(record.input.keyboard, after: keyCode, pressed: false)
+    return .keyboard(.keyUp(record.windowID, key: keyCode, modifiers: modifiers))
 }
 
-private func translateChar(
+/// Translate WM_CHAR to `.keyboard(.textInput)`.
+///
+/// Builds the String straight from the Unicode scalar, which Swift stores
+/// inline (no heap allocation) for anything up to 15 UTF-8 bytes.
+///
+/// - Parameters:
+///   - wParam: UTF-16 code unit of the character
+///   - record: Window receiving the character; holds a pending lead surrogate
+/// - Returns: Text input event, or nil for control characters and lead surrogates
+internal func translateChar(
     _ wParam: WPARAM,
-    _ windowID: WindowID
+    _ record: WinWindowRecord
 ) -> Event? {
-    // wParam contains the UTF-16 character code
-    let utf16Code = UInt16(wParam & 0xFFFF)
+    let unit = UInt16(truncatingIfNeeded: wParam)
 
-    // Convert UTF-16 to String
-    let char = String(utf16CodeUnits: [utf16Code], count: 1)
+    let value: UInt32
+    if UTF16.isLeadSurrogate(unit) {
+        record.pendingHighSurrogate = unit
+        return nil
+    } else if UTF16.isTrailSurrogate(unit) {
+        let lead = record.pendingHighSurrogate
+        record.pendingHighSurrogate = 0
+        guard UTF16.isLeadSurrogate(lead) else {
+            return nil  // Unpaired trail surrogate
+        }
+        value = 0x10000 + ((UInt32(lead) - 0xD800) << 10) + (UInt32(unit) - 0xDC00)
+    } else {
+        record.pendingHighSurrogate = 0
+        value = UInt32(unit)
+    }
 
     // Ignore control characters (ASCII 0-31 and 127)
-    guard !char.isEmpty, let scalar = char.unicodeScalars.first, scalar.value >= 32 && scalar.value != 127 else {
+    guard value >= 32 && value != 127, let scalar = Unicode.Scalar(value) else {
         return nil
     }
 
-    return .keyboard(.textInput(windowID, text: char))
+    return .keyboard(.textInput(record.windowID, text: String(Character(scalar))))
 }
 
 // MARK: - Window Event Translation
 
 private func translateSize(
     _ lParam: LPARAM,
-    _ windowID: WindowID
+    _ windowID: WindowID,
+    _ pointsPerPixel: Float
 ) -> Event? {
-    let width = Float(LOWORD(DWORD(lParam)))
-    let height = Float(HIWORD(DWORD(lParam)))
+    let width = Float(LOWORD(DWORD(lParam))) * pointsPerPixel
+    let height = Float(HIWORD(DWORD(lParam))) * pointsPerPixel
     let size = LogicalSize(width: width, height: height)
     return .window(.resized(windowID, size))
 }
 
 private func translateMove(
     _ lParam: LPARAM,
-    _ windowID: WindowID
+    _ windowID: WindowID,
+    _ pointsPerPixel: Float
 ) -> Event? {
-    let x = Float(Int16(LOWORD(DWORD(lParam))))
-    let y = Float(Int16(HIWORD(DWORD(lParam))))
+    let x = Float(Int16(LOWORD(DWORD(lParam)))) * pointsPerPixel
+    let y = Float(Int16(HIWORD(DWORD(lParam)))) * pointsPerPixel
     let position = LogicalPosition(x: x, y: y)
     return .window(.moved(windowID, position))
 }
 
-private func translateDpiChanged(
-    _ wParam: WPARAM,
-    _ windowID: WindowID
-) -> Event? {
-    // For now, we don't track the old DPI, so we can't provide oldFactor
-    // In a future milestone, we could track this per-window
-    let newDpi = HIWORD(DWORD(wParam))
-    let newFactor = Float(newDpi) / 96.0
-
-    // We use 1.0 as oldFactor since we don't track it yet
-    return .window(.scaleFactorChanged(windowID, oldFactor: 1.0, newFactor: newFactor))
-}
-
 // MARK: - Helper Functions
 
 /// Translate virtual key code to Lumina KeyCode.
@@ -213,34 +272,56 @@ private func translateKeyCode(_ vkCode: WPARAM, _ lParam: LPARAM) -> KeyCode {
     return KeyCode(rawValue: normalizedCode)
 }
 
-/// Translate Windows modifier key state.
-private func translateModifiers() -> ModifierKeys {
+/// Scan codes of the modifier keys (extended keys carry 0xE000).
+private let modifierScanCodes: [(key: KeyCode, modifier: ModifierKeys, virtualKey: Int32)] = [
+    (KeyCode(rawValue: 0x2A), .shift, Int32(VK_LSHIFT)),
+    (KeyCode(rawValue: 0x36), .shift, Int32(VK_RSHIFT)),
+    (KeyCode(rawValue: 0x1D), .control, Int32(VK_LCONTROL)),
+    (KeyCode(rawValue: 0xE01D), .control, Int32(VK_RCONTROL)),
+    (KeyCode(rawValue: 0x38), .alt, Int32(VK_LMENU)),
+    (KeyCode(rawValue: 0xE038), .alt, Int32(VK_RMENU)),
+    (KeyCode(rawValue: 0xE05B), .command, Int32(VK_LWIN)),
+    (KeyCode(rawValue: 0xE05C), .command, Int32(VK_RWIN))
+]
+
+/// Derive modifier state from the window's tracked key state.
+///
+/// Replaces a GetKeyState call per modifier on every key message; the
+/// tracked state is seeded from GetKeyState when the window gains focus.
+private func translateModifiers(_ keyboard: KeyboardState) -> ModifierKeys {
     var modifiers: ModifierKeys = []
-
-    // GetKeyState returns SHORT, high bit set means key is down
-    if GetKeyState(Int32(VK_SHIFT)) < 0 {
-        modifiers.insert(.shift)
-    }
-    if GetKeyState(Int32(VK_CONTROL)) < 0 {
-        modifiers.insert(.control)
-    }
-    if GetKeyState(Int32(VK_MENU)) < 0 {
-        modifiers.insert(.alt)
+    for entry in modifierScanCodes where keyboard.isPressed(entry.key) {
+        modifiers.insert(entry.modifier)
     }
-    if GetKeyState(Int32(VK_LWIN)) < 0 || GetKeyState(Int32(VK_RWIN)) < 0 {
-        modifiers.insert(.command)
-    }
-
     return modifiers
 }
 
-/// Extract mouse position from lParam.
-private func extractMousePosition(_ lParam: LPARAM) -> LogicalPosition {
+/// Modifier state once `key`'s transition is applied.
+///
+/// The window's state itself is updated once, by `WindowInputState.apply`
+/// when the translated event is posted.
+private func translateModifiers(_ keyboard: KeyboardState, after key: KeyCode, pressed: Bool) -> ModifierKeys {
+    var next = keyboard
+    next.setPressed(key, pressed)
+    return translateModifiers(next)
+}
+
+/// Load the current modifier key state into the window's keyboard state.
+private func seedModifierKeys(_ record: WinWindowRecord) {
+    for entry in modifierScanCodes {
+        // GetKeyState returns SHORT, high bit set means key is down
+        record.input.keyboard.setPressed(entry.key, GetKeyState(entry.virtualKey) < 0)
+    }
+    record.input.keyboard.modifiers = translateModifiers(record.input.keyboard)
+}
+
+/// Extract the mouse position from lParam, converted from client pixels.
+private func extractMousePosition(_ lParam: LPARAM, _ pointsPerPixel: Float) -> LogicalPosition {
     // Extract x and y from lParam (low word = x, high word = y)
     let x = Int16(LOWORD(DWORD(lParam)))
     let y = Int16(HIWORD(DWORD(lParam)))
 
-    return LogicalPosition(x: Float(x), y: Float(y))
+    return LogicalPosition(x: Float(x) * pointsPerPixel, y: Float(y) * pointsPerPixel)
 }
 
 // MARK: - Win32 Helper Macros
@@ -0,0 +1,148 @@
+#if os(Windows)
+import WinSDK
+
+/// Raw Input mouse reader for `.pointer(.rawMotion)` events.
+///
+/// Registers the generic mouse (usage page 0x01, usage 0x02) for Raw Input
+/// and reads pending samples in batches with GetRawInputBuffer, which
+/// removes them from the thread's message queue in one call. The batch is
+/// read when the message pump reaches the first WM_INPUT, never before the
+/// pump: GetRawInputBuffer takes every queued sample at once, so reading
+/// early would put motion ahead of earlier clicks and key presses. Samples
+/// that are dispatched as individual WM_INPUT messages anyway (for example
+/// from a modal loop) are handled by `translateRawInput(_:)` in WndProc.
+///
+/// Thread Safety: UI thread only. Raw Input is delivered to the thread that
+/// owns the focused window.
+internal final class WinRawInputReader {
+    /// Whether the mouse is currently registered for Raw Input
+    private(set) var isEnabled = false
+
+    /// Reused read buffer (RAWINPUT records, 8-byte aligned)
+    private var buffer: UnsafeMutableRawPointer
+    private var bufferSize: Int
+
+    init() {
+        bufferSize = 64 * MemoryLayout<RAWINPUT>.stride
+        buffer = UnsafeMutableRawPointer.allocate(byteCount: bufferSize, alignment: 8)
+    }
+
+    deinit {
+        buffer.deallocate()
+    }
+
+    /// Register or unregister the mouse for Raw Input.
+    ///
+    /// - Parameter enabled: Whether raw motion should be delivered
+    /// - Returns: false if Windows refused the registration
+    @discardableResult
+    func setEnabled(_ enabled: Bool) -> Bool {
+        guard enabled != isEnabled else {
+            return true
+        }
+
+        var device = RAWINPUTDEVICE()
+        device.usUsagePage = 0x01  // HID_USAGE_PAGE_GENERIC
+        device.usUsage = 0x02      // HID_USAGE_GENERIC_MOUSE
+        // hwndTarget nil: deliver to the focused window of this thread
+        device.dwFlags = enabled ? 0 : DWORD(RIDEV_REMOVE)
+        device.hwndTarget = nil
+
+        guard RegisterRawInputDevices(&device, 1, UINT(MemoryLayout<RAWINPUTDEVICE>.size)) else {
+            return false
+        }
+        isEnabled = enabled
+        return true
+    }
+
+    /// Read every pending raw mouse sample and append it to `queue`.
+    ///
+    /// - Parameter queue: Destination for the translated events
+    func readBuffer(into queue: EventQueue<EventRingBuffer>) {
+        guard isEnabled else {
+            return
+        }
+
+        let timestamp = EventTimestamp.now()
+        let headerSize = UINT(MemoryLayout<RAWINPUTHEADER>.size)
+        var batch: [EventEnvelope] = []
+
+        while true {
+            var size = UINT(bufferSize)
+            let records = buffer.assumingMemoryBound(to: RAWINPUT.self)
+            let count = GetRawInputBuffer(records, &size, headerSize)
+
+            if count == UINT.max {
+                // Buffer too small for the next record: grow and retry
+                var required: UINT = 0
+                GetRawInputBuffer(nil, &required, headerSize)
+                guard Int(required) * 8 > bufferSize else {
+                    break
+                }
+                growBuffer(to: Int(required) * 8)
+                continue
+            }
+            guard count > 0 else {
+                break
+            }
+
+            var record = buffer
+            for _ in 0..<count {
+                let input = record.assumingMemoryBound(to: RAWINPUT.self)
+                if let event = translateRawMouse(input.pointee) {
+                    batch.append(EventEnvelope(event, timestamp: timestamp))
+                }
+                // NEXTRAWINPUTBLOCK: records are 8-byte aligned on 64-bit Windows
+                let next = Int(bitPattern: record) + Int(input.pointee.header.dwSize)
+                record = UnsafeMutableRawPointer(bitPattern: (next + 7) & ~7)!
+            }
+        }
+
+        if !batch.isEmpty {
+            queue.append(contentsOf: batch)
+        }
+    }
+
+    private func growBuffer(to size: Int) {
+        buffer.deallocate()
+        bufferSize = size
+        buffer = UnsafeMutableRawPointer.allocate(byteCount: bufferSize, alignment: 8)
+    }
+}
+
+/// Translate a single WM_INPUT message to `.pointer(.rawMotion)`.
+///
+/// - Parameter lParam: The WM_INPUT HRAWINPUT handle
+/// - Returns: Raw motion event, or nil for non-mouse or absolute input
+internal func translateRawInput(_ lParam: LPARAM) -> Event? {
+    guard let handle = HRAWINPUT(bitPattern: Int(lParam)) else {
+        return nil
+    }
+
+    var input = RAWINPUT()
+    var size = UINT(MemoryLayout<RAWINPUT>.size)
+    let headerSize = UINT(MemoryLayout<RAWINPUTHEADER>.size)
+    guard GetRawInputData(handle, UINT(RID_INPUT), &input, &size, headerSize) != UINT.max else {
+        return nil
+    }
+    return translateRawMouse(input)
+}
+
+/// Convert a RAWINPUT mouse record with relative motion to an event.
+private func translateRawMouse(_ input: RAWINPUT) -> Event? {
+    guard input.header.dwType == DWORD(RIM_TYPEMOUSE) else {
+        return nil
+    }
+
+    let mouse = input.data.mouse
+    // Absolute devices (pen tablets, remote desktop) report positions, not deltas
+    guard mouse.usFlags & USHORT(MOUSE_MOVE_ABSOLUTE) == 0 else {
+        return nil
+    }
+    guard mouse.lLastX != 0 || mouse.lLastY != 0 else {
+        return nil
+    }
+    return .pointer(.rawMotion(dx: Float(mouse.lLastX), dy: Float(mouse.lLastY)))
+}
+
+#endif
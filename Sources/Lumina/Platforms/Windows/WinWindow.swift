@@ -5,112 +5,580 @@ import Foundation
 /// Global event queue for posting events from WndProc to the application.
 ///
 /// Since WndProc is a static C callback, we need a global queue to communicate
-/// events back to the application's poll() method.
-internal final class GlobalEventQueue: @unchecked Sendable {
-    static let shared = GlobalEventQueue()
-
-    private let lock = NSLock()
-    private var events: [Event] = []
+/// events back to the application's poll() method. The queue is ring-buffer
+/// backed, so dequeuing is O(1) and drain(into:) hands over every pending
+/// event under a single lock acquisition.
+internal enum GlobalEventQueue {
+    static let shared = EventQueue<EventRingBuffer>()
+}
 
-    func append(_ event: Event) {
-        lock.lock()
-        defer { lock.unlock() }
-        events.append(event)
+/// DPI-dependent metrics of one window.
+///
+/// Read once per DPI change, so converting between logical and physical
+/// units and between client and frame sizes is arithmetic instead of
+/// GetDpiForWindow, GetWindowLongPtrW and AdjustWindowRectExForDpi calls.
+internal struct WinWindowMetrics {
+    let dpi: UINT
+    let scaleFactor: Float
+
+    /// Logical points per physical pixel (1 / scaleFactor)
+    let pointsPerPixel: Float
+
+    /// Width and height the frame adds to the client area, in pixels
+    let frameWidth: LONG
+    let frameHeight: LONG
+
+    init(hwnd: HWND, dpi: UINT) {
+        self.dpi = dpi
+        self.scaleFactor = Float(dpi) / 96.0
+        self.pointsPerPixel = 96.0 / Float(dpi)
+
+        // The frame of an empty client rect is the frame alone
+        var frame = RECT()
+        let style = DWORD(GetWindowLongPtrW(hwnd, GWL_STYLE))
+        let exStyle = DWORD(GetWindowLongPtrW(hwnd, GWL_EXSTYLE))
+        AdjustWindowRectExForDpi(&frame, style, false, exStyle, dpi)
+        self.frameWidth = frame.right - frame.left
+        self.frameHeight = frame.bottom - frame.top
     }
 
-    func removeFirst() -> Event? {
-        lock.lock()
-        defer { lock.unlock() }
-        guard !events.isEmpty else { return nil }
-        return events.removeFirst()
+    /// Outer window size for a logical client size.
+    func frameSize(for size: LogicalSize) -> (width: LONG, height: LONG) {
+        let physical = size.toPhysical(scaleFactor: scaleFactor)
+        return (LONG(physical.width) + frameWidth, LONG(physical.height) + frameHeight)
     }
 }
 
-/// Global window registry for HWND -> WindowID mapping.
+/// Per-window record attached to each HWND through `GWLP_USERDATA`.
 ///
-/// Windows requires a static C callback for WndProc, but we need to associate
-/// each HWND with its Lumina WindowID. This registry provides that mapping.
-internal final class WinWindowRegistry: @unchecked Sendable {
-    static let shared = WinWindowRegistry()
+/// Holds the window's Lumina identity and everything WndProc needs, so the
+/// message path resolves a window with a single GetWindowLongPtrW call.
+internal final class WinWindowRecord {
+    let windowID: WindowID
+    let closeCallback: WindowCloseCallback?
+
+    /// Size limits; WM_GETMINMAXINFO reads `trackSizes`, derived from these
+    var constraints = WindowConstraints() {
+        didSet { updateTrackSizes() }
+    }
+
+    /// DPI and frame metrics, refreshed on WM_DPICHANGED
+    private(set) var metrics: WinWindowMetrics
+
+    /// `constraints` as outer window sizes at the current DPI
+    private(set) var trackSizes = TrackSizes()
+
+    /// Whether a redraw was requested and not yet turned into an invalidation
+    var redrawPending = false
+
+    /// Leading UTF-16 surrogate of a WM_CHAR pair awaiting its trail unit
+    var pendingHighSurrogate: UInt16 = 0
+
+    /// Whether TrackMouseEvent is armed to send WM_MOUSELEAVE
+    var tracksMouseLeave = false
+
+    /// Key and pointer state, updated as messages are translated
+    var input = WindowInputState()
+
+    /// Input categories translated for this window (nil: the application's mask)
+    var eventMask: EventMask?
+
+    /// Whether a swapchain presents to this window (see `LuminaWindow.surface()`),
+    /// so GDI never paints its client area
+    var presentsSwapchain = false
+
+    /// Size, scale and visibility published for other threads
+    let proxy: WindowProxy
+
+    /// Whether the window is minimized (reported as `.minimized`)
+    var isMinimized = false
+
+    /// Whether DWM cloaked the window, e.g. on another virtual desktop
+    var isCloaked = false
+
+    /// Whether a redraw request is held back until the window can be seen
+    /// again; `redrawPending` stays set meanwhile
+    var redrawParked = false
 
-    private let lock = NSLock()
-    private var registry: [HWND: WindowID] = [:]
-    private var constraints: [HWND: WindowConstraints] = [:]
-    private var closeCallbacks: [HWND: WindowCloseCallback] = [:]
+    /// Whether nobody can see the window, so it gets no frame ticks
+    var isHidden: Bool {
+        isMinimized || isCloaked
+    }
 
     struct WindowConstraints {
         var minSize: LogicalSize?
         var maxSize: LogicalSize?
     }
 
-    func register(hwnd: HWND, windowID: WindowID, closeCallback: WindowCloseCallback?) {
-        lock.lock()
-        defer { lock.unlock() }
-        registry[hwnd] = windowID
-        constraints[hwnd] = WindowConstraints()
-        if let callback = closeCallback {
-            closeCallbacks[hwnd] = callback
+    struct TrackSizes {
+        var min: (width: LONG, height: LONG)?
+        var max: (width: LONG, height: LONG)?
+    }
+
+    init(windowID: WindowID, closeCallback: WindowCloseCallback?, hwnd: HWND) {
+        let metrics = WinWindowMetrics(hwnd: hwnd, dpi: GetDpiForWindow(hwnd))
+        self.windowID = windowID
+        self.closeCallback = closeCallback
+        self.metrics = metrics
+        self.proxy = WindowProxy(
+            id: windowID,
+            snapshot: Self.snapshot(of: hwnd, metrics: metrics, isVisible: IsWindowVisible(hwnd), isCloaked: false)
+        )
+    }
+
+    /// Re-read the metrics for a new DPI (WM_DPICHANGED).
+    func updateMetrics(of hwnd: HWND, dpi: UINT) {
+        metrics = WinWindowMetrics(hwnd: hwnd, dpi: dpi)
+        updateTrackSizes()
+    }
+
+    private func updateTrackSizes() {
+        trackSizes = TrackSizes(
+            min: constraints.minSize.map(metrics.frameSize(for:)),
+            max: constraints.maxSize.map(metrics.frameSize(for:))
+        )
+    }
+
+    /// Publish the window's client size and DPI to its proxy.
+    ///
+    /// - Parameters:
+    ///   - hwnd: The window
+    ///   - isVisible: The new visibility; WM_SHOWWINDOW arrives before
+    ///     IsWindowVisible changes, so it passes its own flag
+    func publishState(of hwnd: HWND, isVisible: Bool? = nil) {
+        proxy.publish(Self.snapshot(
+            of: hwnd, metrics: metrics, isVisible: isVisible ?? IsWindowVisible(hwnd), isCloaked: isCloaked
+        ))
+    }
+
+    /// Current presentation state of `hwnd`, read from Win32.
+    private static func snapshot(
+        of hwnd: HWND,
+        metrics: WinWindowMetrics,
+        isVisible: Bool,
+        isCloaked: Bool
+    ) -> WindowSnapshot {
+        var rect = RECT()
+        GetClientRect(hwnd, &rect)
+        let physical = PhysicalSize(width: Int(rect.right - rect.left), height: Int(rect.bottom - rect.top))
+        return WindowSnapshot(
+            size: physical.toLogical(scaleFactor: metrics.scaleFactor),
+            physicalSize: physical,
+            scaleFactor: metrics.scaleFactor,
+            isVisible: isVisible,
+            isOccluded: isVisible && (isCloaked || IsIconic(hwnd))
+        )
+    }
+}
+
+/// The compositor's refresh timing, used to pace redraw requests.
+///
+/// DwmGetCompositionTimingInfo reports the last vertical blank DWM
+/// composed and the refresh period; while nothing changes on screen DWM
+/// stops updating them, so the latest blank is extrapolated from the last
+/// reported one. Without DWM timing (some remote sessions) the clock
+/// falls back to 60 Hz on the performance counter.
+internal struct WinFrameClock {
+    /// Performance counter ticks per second
+    private let frequency: Int64
+
+    /// Counter time of the vertical blank redraws were last flushed after
+    private var lastFrame: Int64 = 0
+
+    init() {
+        var frequency = LARGE_INTEGER()
+        QueryPerformanceFrequency(&frequency)
+        self.frequency = max(frequency.QuadPart, 1)
+    }
+
+    /// Start a frame if a vertical blank passed since the last one.
+    ///
+    /// - Returns: false if the current frame was already started
+    mutating func beginFrame() -> Bool {
+        let frame = latestFrame()
+        guard frame.vblank > lastFrame else {
+            return false
         }
+        lastFrame = frame.vblank
+        return true
     }
 
-    func unregister(hwnd: HWND) {
-        lock.lock()
-        defer { lock.unlock() }
+    /// Seconds until `beginFrame()` next succeeds (0 if it would now).
+    func secondsUntilNextFrame() -> Double {
+        let frame = latestFrame()
+        guard frame.vblank <= lastFrame else {
+            return 0
+        }
+        return Double(frame.vblank + frame.period - frame.now) / Double(frequency)
+    }
+
+    /// The latest vertical blank at or before now, in counter ticks.
+    private func latestFrame() -> (vblank: Int64, period: Int64, now: Int64) {
+        var counter = LARGE_INTEGER()
+        QueryPerformanceCounter(&counter)
+        let now = counter.QuadPart
+
+        var info = DWM_TIMING_INFO()
+        info.cbSize = UINT32(MemoryLayout<DWM_TIMING_INFO>.size)
+        var vblank: Int64 = 0
+        var period = frequency / 60
+        if DwmGetCompositionTimingInfo(nil, &info) == S_OK, info.qpcRefreshPeriod > 0 {
+            vblank = Int64(truncatingIfNeeded: info.qpcVBlank)
+            period = Int64(truncatingIfNeeded: info.qpcRefreshPeriod)
+        }
+        period = max(period, 1)
+        if now > vblank {
+            vblank += (now - vblank) / period * period
+        }
+        return (vblank, period, now)
+    }
+}
+
+/// Global window registry for HWND -> WindowID mapping.
+///
+/// Windows requires a static C callback for WndProc, but we need to associate
+/// each HWND with its Lumina WindowID. Each window's `WinWindowRecord` is
+/// stored in its `GWLP_USERDATA` slot, so WndProc finds it without a lookup
+/// table. The registry's slab owns the records (the HWND only holds an
+/// unretained pointer) and allocates the WindowIDs.
+///
+/// Thread Safety: UI thread only. Windows delivers every message for a window
+/// on the thread that created it, and Lumina creates windows on the main
+/// thread, so no locking is needed.
+internal final class WinWindowRegistry: @unchecked Sendable {
+    static let shared = WinWindowRegistry()
+
+    private var records = WindowSlab<WinWindowRecord>()
+
+    /// Windows with a requested redraw, invalidated by `flushRedraws()`
+    private var pendingRedraws: [HWND] = []
 
-        // Get the callback and windowID before removing
-        let callback = closeCallbacks[hwnd]
-        let windowID = registry[hwnd]
+    /// Paces `flushRedraws()` to one flush per display refresh
+    private var frameClock = WinFrameClock()
 
-        registry.removeValue(forKey: hwnd)
-        constraints.removeValue(forKey: hwnd)
-        closeCallbacks.removeValue(forKey: hwnd)
+    /// Input categories translated for windows without their own mask
+    var eventMask: EventMask = .all
 
-        // Release the lock before invoking the callback
-        lock.unlock()
+    /// Counters and trace intervals of the application, shared with its
+    /// pipeline so WndProc can report translations
+    let instrumentation = EventLoopInstrumentation()
+
+    /// Handler of an active run(handler:), fed directly from WndProc
+    var dispatcher: EventDispatcher?
+
+    /// Application handler run from WM_TIMER during modal size/move loops
+    var modalLoopHandler: ModalLoopHandler?
+
+    /// Pipeline of the application that set `modalLoopHandler`, so modal
+    /// ticks coalesce, route and record like its poll()/drain() calls
+    var modalLoopPipeline: EventPipeline?
+
+    /// Scratch batch handed to `modalLoopHandler` (kept for its capacity)
+    private var modalLoopEvents: [Event] = []
+
+    /// Hidden windows parked for reuse by WinWindow.create
+    private var pool = WindowPool<HWND>()
+
+    /// Register a new window, allocating its WindowID.
+    ///
+    /// - Returns: The window's record, attached to `hwnd`
+    func register(hwnd: HWND, closeCallback: WindowCloseCallback?) -> WinWindowRecord {
+        var attached: WinWindowRecord?
+        _ = records.insert { windowID in
+            let record = WinWindowRecord(windowID: windowID, closeCallback: closeCallback, hwnd: hwnd)
+            attached = record
+            return record
+        }
+
+        // The slab's insert always runs the closure
+        let record = attached!
+        let pointer = Unmanaged.passUnretained(record).toOpaque()
+        SetWindowLongPtrW(hwnd, GWLP_USERDATA, LONG_PTR(Int(bitPattern: pointer)))
+        updateMonitorTracking()
+        installCloakHook()
+        return record
+    }
+
+    /// Detach and free the window's record, then invoke its close callback.
+    func unregister(hwnd: HWND) {
+        guard let record = WinWindowRegistry.record(for: hwnd) else {
+            return
+        }
+
+        detach(record, from: hwnd)
 
-        // Invoke the close callback if it exists
         // WndProc runs on the main thread, so we can use assumeIsolated
-        if let callback = callback, let windowID = windowID {
+        if let callback = record.closeCallback {
             MainActor.assumeIsolated {
-                callback(windowID)
+                callback(record.windowID)
             }
         }
+    }
 
-        // Re-acquire the lock for the defer block
-        lock.lock()
+    /// Remove a window's record without destroying the HWND.
+    private func detach(_ record: WinWindowRecord, from hwnd: HWND) {
+        SetWindowLongPtrW(hwnd, GWLP_USERDATA, 0)
+        record.proxy.update { $0.isVisible = false }
+        records.remove(record.windowID)
+        updateMonitorTracking()
     }
 
-    func windowID(for hwnd: HWND) -> WindowID? {
-        lock.lock()
-        defer { lock.unlock() }
-        return registry[hwnd]
+    /// Cache the monitor list while some top-level window exists to
+    /// receive WM_DISPLAYCHANGE (parked windows count; hidden windows get it too).
+    private func updateMonitorTracking() {
+        if records.count == 0 && pool.isEmpty {
+            MonitorCache.shared.stopTracking()
+        } else {
+            MonitorCache.shared.startTracking()
+        }
+    }
+
+    // MARK: - Cloaking
+
+    /// Hook reporting DWM cloak changes of this process's windows
+    private var cloakHook: HWINEVENTHOOK?
+
+    /// Start receiving EVENT_OBJECT_CLOAKED/UNCLOAKED, once.
+    ///
+    /// Windows sends no window message when DWM cloaks a window (virtual
+    /// desktop switches, UWP suspension); an out-of-context WinEvent hook
+    /// delivers the change through this thread's message loop instead.
+    private func installCloakHook() {
+        guard cloakHook == nil else {
+            return
+        }
+        cloakHook = SetWinEventHook(
+            DWORD(EVENT_OBJECT_CLOAKED),
+            DWORD(EVENT_OBJECT_UNCLOAKED),
+            nil,
+            luminaCloakHook,
+            GetCurrentProcessId(),
+            0,
+            DWORD(WINEVENT_OUTOFCONTEXT)
+        )
+    }
+
+    /// Record a cloak change of a registered window and report it.
+    func setCloaked(_ cloaked: Bool, hwnd: HWND, record: WinWindowRecord) {
+        guard record.isCloaked != cloaked else {
+            return
+        }
+        record.isCloaked = cloaked
+        record.publishState(of: hwnd)
+        if !record.isHidden {
+            resumeRedraws(hwnd: hwnd, record: record)
+        }
+        instrumentation.count(.eventsTranslated)
+        post(EventEnvelope(.window(.occlusionChanged(record.windowID, isOccluded: cloaked))))
+    }
+
+    // MARK: - Window Pool
+
+    /// Maximum number of closed windows kept hidden for reuse.
+    ///
+    /// Lowering it destroys the windows that no longer fit.
+    var windowPoolCapacity: Int {
+        get { pool.capacity }
+        set {
+            for hwnd in pool.setCapacity(newValue) {
+                DestroyWindow(hwnd)
+            }
+            updateMonitorTracking()
+        }
+    }
+
+    /// Whether another window can be parked.
+    var canPoolWindow: Bool {
+        pool.hasRoom
+    }
+
+    /// Take a parked window with the given style, if any.
+    func takePooledWindow(resizable: Bool) -> HWND? {
+        pool.take(resizable: resizable)
+    }
+
+    /// Park a hidden, unregistered window (pre-warming).
+    ///
+    /// - Returns: false if the pool is full; the caller destroys the window
+    func parkWindow(_ hwnd: HWND, resizable: Bool) -> Bool {
+        guard pool.offer(hwnd, resizable: resizable) else {
+            return false
+        }
+        updateMonitorTracking()
+        return true
+    }
+
+    /// Close a registered window by parking it instead of destroying it.
+    ///
+    /// The window is hidden and its record detached, and the close callback
+    /// runs as it would on WM_DESTROY, so the application sees an ordinary
+    /// `.closed` event.
+    ///
+    /// - Returns: false if the pool is full; the caller destroys the window
+    func recycle(hwnd: HWND) -> Bool {
+        guard pool.hasRoom, WinWindowRegistry.record(for: hwnd) != nil else {
+            return false
+        }
+        let resizable = DWORD(GetWindowLongPtrW(hwnd, GWL_STYLE)) & DWORD(WS_THICKFRAME) != 0
+
+        // Hiding sends WM_KILLFOCUS while the record is still attached
+        ShowWindow(hwnd, SW_HIDE)
+        KillTimer(hwnd, LUMINA_MODAL_LOOP_TIMER)
+        _ = pool.offer(hwnd, resizable: resizable)
+        unregister(hwnd: hwnd)
+        return true
+    }
+
+    /// Drop a window created by a batch that failed, without a close
+    /// callback; the HWND is parked if possible, otherwise destroyed.
+    func discard(hwnd: HWND) {
+        guard let record = WinWindowRegistry.record(for: hwnd) else {
+            return
+        }
+        let resizable = DWORD(GetWindowLongPtrW(hwnd, GWL_STYLE)) & DWORD(WS_THICKFRAME) != 0
+        detach(record, from: hwnd)
+        if !parkWindow(hwnd, resizable: resizable) {
+            DestroyWindow(hwnd)
+        }
+    }
+
+    /// The record attached to `hwnd`, or nil if it is not a registered Lumina window.
+    static func record(for hwnd: HWND) -> WinWindowRecord? {
+        let value = GetWindowLongPtrW(hwnd, GWLP_USERDATA)
+        guard let pointer = UnsafeRawPointer(bitPattern: Int(value)) else {
+            return nil
+        }
+        return Unmanaged<WinWindowRecord>.fromOpaque(pointer).takeUnretainedValue()
     }
 
     func setMinSize(_ size: LogicalSize?, for hwnd: HWND) {
-        lock.lock()
-        defer { lock.unlock() }
-        constraints[hwnd]?.minSize = size
+        WinWindowRegistry.record(for: hwnd)?.constraints.minSize = size
     }
 
     func setMaxSize(_ size: LogicalSize?, for hwnd: HWND) {
-        lock.lock()
-        defer { lock.unlock() }
-        constraints[hwnd]?.maxSize = size
+        WinWindowRegistry.record(for: hwnd)?.constraints.maxSize = size
     }
 
-    func getConstraints(for hwnd: HWND) -> WindowConstraints? {
-        lock.lock()
-        defer { lock.unlock() }
-        return constraints[hwnd]
+    /// The record of a registered window, by WindowID.
+    func record(for windowID: WindowID) -> WinWindowRecord? {
+        records[windowID]
     }
 
     var windowCount: Int {
-        lock.lock()
-        defer { lock.unlock() }
-        return registry.count
+        records.count
+    }
+
+    /// Deliver a translated event: straight to run(handler:) if it is
+    /// active, otherwise to the queue read by poll().
+    func post(_ envelope: EventEnvelope) {
+        if let dispatcher {
+            let delivered = MainActor.assumeIsolated {
+                dispatcher.dispatch(envelope)
+            }
+            if delivered {
+                return
+            }
+        }
+        instrumentation.measure(.enqueue) {
+            GlobalEventQueue.shared.append(envelope)
+        }
+    }
+
+    // MARK: - Redraw Requests
+
+    /// Whether any window has a redraw request waiting for `flushRedraws()`.
+    var hasPendingRedraws: Bool {
+        !pendingRedraws.isEmpty
+    }
+
+    /// Seconds until `flushRedraws()` invalidates the pending windows.
+    var secondsUntilRedraw: Double {
+        frameClock.secondsUntilNextFrame()
+    }
+
+    /// Record a redraw request for `hwnd` (coalesced until the next flush).
+    func requestRedraw(hwnd: HWND) {
+        guard let record = WinWindowRegistry.record(for: hwnd), !record.redrawPending else {
+            return
+        }
+        record.redrawPending = true
+        pendingRedraws.append(hwnd)
+    }
+
+    /// Invalidate every window with a pending request, at most once per
+    /// display refresh.
+    ///
+    /// Windows delivers WM_PAINT once the message queue is otherwise empty,
+    /// and WndProc turns it into `.redrawRequested`. Requests made after
+    /// this frame's flush wait for the next vertical blank, whichever of
+    /// poll(), drain(), wait() or run() calls in next, so animating windows
+    /// redraw at the refresh rate rather than as fast as they are polled.
+    func flushRedraws() {
+        guard !pendingRedraws.isEmpty, frameClock.beginFrame() else {
+            return
+        }
+        for hwnd in pendingRedraws {
+            // Windows destroyed since the request have no record anymore
+            guard let record = WinWindowRegistry.record(for: hwnd) else {
+                continue
+            }
+            // Nothing to show; resumeRedraws re-queues it later
+            if record.isHidden {
+                record.redrawParked = true
+                continue
+            }
+            record.redrawPending = false
+            InvalidateRect(hwnd, nil, false)
+        }
+        pendingRedraws.removeAll(keepingCapacity: true)
+    }
+
+    /// Re-queue a request parked while the window was minimized or cloaked.
+    func resumeRedraws(hwnd: HWND, record: WinWindowRecord) {
+        guard record.redrawParked else {
+            return
+        }
+        record.redrawParked = false
+        pendingRedraws.append(hwnd)
+    }
+
+    // MARK: - Modal Loop
+
+    /// Deliver queued events to `modalLoopHandler` from inside a modal loop.
+    ///
+    /// Redraw requests are flushed first, so their WM_PAINT (and the
+    /// resulting `.redrawRequested`) arrives by the next tick. Events pass
+    /// through the application's pipeline as a drain(into:) call would.
+    func runModalLoopTick() {
+        guard let handler = modalLoopHandler, let pipeline = modalLoopPipeline else {
+            return
+        }
+
+        flushRedraws()
+
+        // Hand over the batch but keep the buffer's capacity for the next tick
+        var events: [Event] = []
+        swap(&events, &modalLoopEvents)
+        MainActor.assumeIsolated {
+            _ = pipeline.drain(into: &events, maxCount: .max, transform: \.event) {
+                GlobalEventQueue.shared.drain(into: &$0, maxCount: $1)
+            }
+            if !events.isEmpty {
+                handler(events)
+            }
+        }
+        events.removeAll(keepingCapacity: true)
+        swap(&events, &modalLoopEvents)
     }
 }
 
+/// Timer ID used to tick `modalLoopHandler` during modal size/move loops
+private let LUMINA_MODAL_LOOP_TIMER: UINT_PTR = 0x4C55
+
+/// Modal loop tick interval; Windows clamps timers to USER_TIMER_MINIMUM
+/// (10 ms) and rounds to the system timer granularity
+private let MODAL_LOOP_TICK_MS: UINT = 10
+
 /// Windows window class name
 private let LUMINA_WINDOW_CLASS = "LuminaWindow"
 
@@ -120,9 +588,11 @@ private func registerWindowClass() -> Bool {
     return LUMINA_WINDOW_CLASS.withCString(encodedAs: UTF16.self) { classNamePtr in
         var wc = WNDCLASSEXW()
         wc.cbSize = DWORD(MemoryLayout<WNDCLASSEXW>.size)
-        // CS_HREDRAW | CS_VREDRAW: Redraw entire window when resized horizontally or vertically
         // CS_DBLCLKS: Enable double-click events
-        wc.style = UINT(CS_HREDRAW | CS_VREDRAW | CS_DBLCLKS)
+        // No CS_HREDRAW | CS_VREDRAW: they apply to the whole class, and
+        // swapchain windows must not be invalidated on resize; WM_SIZE
+        // invalidates the other windows instead
+        wc.style = UINT(CS_DBLCLKS)
         wc.lpfnWndProc = luminaWndProc
         wc.cbClsExtra = 0
         wc.cbWndExtra = 0
@@ -142,6 +612,24 @@ private func registerWindowClass() -> Bool {
 @MainActor
 private var windowClassRegistered = false
 
+/// WinEvent callback for EVENT_OBJECT_CLOAKED/UNCLOAKED (see `installCloakHook`).
+private func luminaCloakHook(
+    _ hook: HWINEVENTHOOK?,
+    _ event: DWORD,
+    _ hwnd: HWND?,
+    _ idObject: LONG,
+    _ idChild: LONG,
+    _ eventThread: DWORD,
+    _ eventTime: DWORD
+) {
+    // Only top-level changes of Lumina windows; child objects report too
+    guard let hwnd, idObject == LONG(OBJID_WINDOW), idChild == LONG(CHILDID_SELF),
+          let record = WinWindowRegistry.record(for: hwnd) else {
+        return
+    }
+    WinWindowRegistry.shared.setCloaked(event == DWORD(EVENT_OBJECT_CLOAKED), hwnd: hwnd, record: record)
+}
+
 /// Window procedure callback (static C function required by Win32)
 private func luminaWndProc(
     _ hwnd: HWND?,
@@ -153,6 +641,32 @@ private func luminaWndProc(
         return DefWindowProcW(nil, uMsg, wParam, lParam)
     }
 
+    // Capture the event time at WndProc entry (QPC), before any processing
+    let timestamp = EventTimestamp.now()
+
+    // Resolve the Lumina window from GWLP_USERDATA (nil during creation)
+    let record = WinWindowRegistry.record(for: hwnd)
+
+    /// Post an event WndProc built itself
+    func post(_ event: Event) {
+        WinWindowRegistry.shared.instrumentation.count(.eventsTranslated)
+        WinWindowRegistry.shared.post(EventEnvelope(event, timestamp: timestamp))
+    }
+
+    /// Translate this message and post it for poll() or run(handler:)
+    func postTranslatedEvent() {
+        guard let record else {
+            return
+        }
+        let translated = WinWindowRegistry.shared.instrumentation.measure(.translate) {
+            translateWindowsMessage(msg: uMsg, wParam: wParam, lParam: lParam, for: record)
+        }
+        if let event = translated {
+            record.input.apply(event)
+            post(event)
+        }
+    }
+
     // Handle special messages
     switch uMsg {
     case UINT(WM_NCCREATE):
@@ -169,34 +683,35 @@ private func luminaWndProc(
 
     case UINT(WM_CLOSE):
         // Don't destroy automatically - let Lumina handle it
-        // Just translate to a close event
-        DestroyWindow(hwnd)
+        // Just translate to a close event (parking the window if pooling)
+        if !WinWindowRegistry.shared.recycle(hwnd: hwnd) {
+            DestroyWindow(hwnd)
+        }
         return 0
 
     case UINT(WM_GETMINMAXINFO):
-        if let constraints = WinWindowRegistry.shared.getConstraints(for: hwnd) {
-            // lParam contains pointer to MINMAXINFO structure
-            let pMinMaxInfo = UnsafeMutablePointer<MINMAXINFO>(bitPattern: Int(truncatingIfNeeded: lParam))
-            if let info = pMinMaxInfo {
-                let dpi = GetDpiForWindow(hwnd)
-                let scaleFactor = Float(dpi) / 96.0
-
-                if let minSize = constraints.minSize {
-                    let physical = minSize.toPhysical(scaleFactor: scaleFactor)
-                    info.pointee.ptMinTrackSize.x = LONG(physical.width)
-                    info.pointee.ptMinTrackSize.y = LONG(physical.height)
-                }
-
-                if let maxSize = constraints.maxSize {
-                    let physical = maxSize.toPhysical(scaleFactor: scaleFactor)
-                    info.pointee.ptMaxTrackSize.x = LONG(physical.width)
-                    info.pointee.ptMaxTrackSize.y = LONG(physical.height)
-                }
+        // Sent many times per second while dragging; the limits were
+        // converted to frame sizes when they or the DPI last changed
+        if let trackSizes = record?.trackSizes,
+           let info = UnsafeMutablePointer<MINMAXINFO>(bitPattern: Int(truncatingIfNeeded: lParam)) {
+            if let minSize = trackSizes.min {
+                info.pointee.ptMinTrackSize.x = minSize.width
+                info.pointee.ptMinTrackSize.y = minSize.height
+            }
+            if let maxSize = trackSizes.max {
+                info.pointee.ptMaxTrackSize.x = maxSize.width
+                info.pointee.ptMaxTrackSize.y = maxSize.height
             }
         }
         return 0
 
     case UINT(WM_DPICHANGED):
+        // Refresh the cached metrics first: SetWindowPos below sends the
+        // WM_SIZE that converts the new client size with them
+        let oldFactor = record?.metrics.scaleFactor
+        let newDpi = UINT((DWORD(truncatingIfNeeded: wParam) >> 16) & 0xFFFF)
+        record?.updateMetrics(of: hwnd, dpi: newDpi)
+
         // Handle DPI change by using the suggested window rect from Windows
         // lParam contains a pointer to a RECT with the recommended size and position
         let suggestedRect = UnsafePointer<RECT>(bitPattern: Int(truncatingIfNeeded: lParam))
@@ -214,16 +729,55 @@ private func luminaWndProc(
             )
         }
 
-        // Still translate the event for application notification
-        if let windowID = WinWindowRegistry.shared.windowID(for: hwnd) {
-            if let event = translateWindowsMessage(msg: uMsg, wParam: wParam, lParam: lParam, for: windowID) {
-                // Post event to global queue for poll() to retrieve
-                GlobalEventQueue.shared.append(event)
+        // SetWindowPos published the new size; the DPI may be all that changed
+        if let record, let oldFactor {
+            record.publishState(of: hwnd)
+            let newFactor = record.metrics.scaleFactor
+            if newFactor != oldFactor {
+                post(.window(.scaleFactorChanged(record.windowID, oldFactor: oldFactor, newFactor: newFactor)))
             }
         }
         return 0
 
+    case UINT(WM_SIZE):
+        // Redraw entire window when resized, as CS_HREDRAW | CS_VREDRAW
+        // would; a swapchain repaints on its own
+        if let record, !record.presentsSwapchain {
+            InvalidateRect(hwnd, nil, true)
+        }
+        guard let record else {
+            return DefWindowProcW(hwnd, uMsg, wParam, lParam)
+        }
+        if wParam == WPARAM(SIZE_MINIMIZED) {
+            // The client area collapses to 0x0; report .minimized instead of
+            // that size and keep the last one for renderers
+            record.proxy.update { $0.isOccluded = true }
+            if !record.isMinimized {
+                record.isMinimized = true
+                post(.window(.minimized(record.windowID)))
+            }
+        } else {
+            record.publishState(of: hwnd)
+            if record.isMinimized {
+                record.isMinimized = false
+                WinWindowRegistry.shared.resumeRedraws(hwnd: hwnd, record: record)
+                post(.window(.restored(record.windowID)))
+            }
+            postTranslatedEvent()
+        }
+        return DefWindowProcW(hwnd, uMsg, wParam, lParam)
+
+    case UINT(WM_SHOWWINDOW):
+        record?.publishState(of: hwnd, isVisible: wParam != 0)
+        return DefWindowProcW(hwnd, uMsg, wParam, lParam)
+
     case UINT(WM_ERASEBKGND):
+        // The swapchain covers the client area; filling it first would
+        // flicker and cost an extra fill per resize
+        if record?.presentsSwapchain == true {
+            return 1
+        }
+
         // Fill background with white using system color brush
         // wParam contains the HDC (handle to device context)
         // On 64-bit Windows, WPARAM is UInt64, HDC expects Int bitPattern
@@ -238,29 +792,121 @@ private func luminaWndProc(
         }
         return 1  // Background erased
 
+    case UINT(WM_ENTERSIZEMOVE):
+        // DefWindowProc is about to run a modal loop; tick the application's
+        // handler from a timer so it can keep rendering
+        if WinWindowRegistry.shared.modalLoopHandler != nil {
+            SetTimer(hwnd, LUMINA_MODAL_LOOP_TIMER, MODAL_LOOP_TICK_MS, nil)
+        }
+        postTranslatedEvent()
+        return 0
+
+    case UINT(WM_EXITSIZEMOVE):
+        KillTimer(hwnd, LUMINA_MODAL_LOOP_TIMER)
+        postTranslatedEvent()
+        return 0
+
+    case UINT(WM_TIMER) where UINT_PTR(wParam) == LUMINA_MODAL_LOOP_TIMER:
+        WinWindowRegistry.shared.runModalLoopTick()
+        return 0
+
+    case UINT(WM_MOUSEMOVE):
+        // Windows sends WM_MOUSELEAVE only once asked to, and only once per
+        // request; arm it on the first move after the pointer came back
+        if let record, !record.tracksMouseLeave {
+            var tracking = TRACKMOUSEEVENT(
+                cbSize: DWORD(MemoryLayout<TRACKMOUSEEVENT>.size),
+                dwFlags: DWORD(TME_LEAVE),
+                hwndTrack: hwnd,
+                dwHoverTime: 0
+            )
+            record.tracksMouseLeave = TrackMouseEvent(&tracking)
+        }
+        postTranslatedEvent()
+
+    case UINT(WM_MOUSELEAVE):
+        record?.tracksMouseLeave = false
+        postTranslatedEvent()
+        return 0
+
+    case UINT(WM_DISPLAYCHANGE):
+        // Broadcast to every top-level window; the cache reports the change once
+        if MonitorCache.shared.invalidate() {
+            post(.monitorsChanged)
+        }
+        return DefWindowProcW(hwnd, uMsg, wParam, lParam)
+
+    case UINT(WM_CHAR):
+        // Characters outside the BMP arrive as two WM_CHARs; the record
+        // holds the first half until the second one pairs with it
+        if let record,
+           (record.eventMask ?? WinWindowRegistry.shared.eventMask).contains(.text),
+           let event = translateChar(wParam, record) {
+            post(event)
+        }
+        return 0
+
     case UINT(WM_PAINT):
         // Validate the entire client area to prevent infinite paint loops
         var ps = PAINTSTRUCT()
         if BeginPaint(hwnd, &ps) != nil {
-            // In Milestone 0, we don't have a rendering API yet
-            // Just validate the client area
+            // Lumina has no rendering API; the application draws in
+            // response to .redrawRequested
             EndPaint(hwnd, &ps)
         }
+
+        // Windows merges invalidations into one WM_PAINT, so this is
+        // already coalesced per window
+        if let windowID = record?.windowID {
+            post(.window(.redrawRequested(windowID)))
+        }
         return 0
 
     default:
         // Translate other events through WinInput
-        if let windowID = WinWindowRegistry.shared.windowID(for: hwnd) {
-            if let event = translateWindowsMessage(msg: uMsg, wParam: wParam, lParam: lParam, for: windowID) {
-                // Post event to global queue for poll() to retrieve
-                GlobalEventQueue.shared.append(event)
-            }
-        }
+        postTranslatedEvent()
     }
 
     return DefWindowProcW(hwnd, uMsg, wParam, lParam)
 }
 
+/// Where new windows for one monitor go, and at which DPI.
+///
+/// Resolved once per monitor by `createWindows(_:)` rather than per window.
+internal struct WinWindowPlacement {
+    /// Target monitor, or nil if monitor detection failed
+    let monitor: Monitor?
+
+    /// DPI the window frame is computed for
+    let dpi: UINT
+
+    /// Initial window position (CW_USEDEFAULT without a monitor)
+    let x: INT
+    let y: INT
+
+    /// Resolve the placement for `monitor`.
+    ///
+    /// Priority: specified monitor -> primary monitor -> system DPI fallback
+    init(monitor requested: Monitor?) {
+        let target = requested ?? (try? Monitor.primary())
+        monitor = target
+
+        if let target {
+            dpi = UINT((target.scaleFactor * 96).rounded())
+            // Position window on the target monitor (offset from monitor's top-left)
+            // We need an explicit position here to ensure it appears on the correct monitor
+            x = INT(target.physicalPosition.x + 100)
+            y = INT(target.physicalPosition.y + 100)
+        } else {
+            // Fallback to system DPI if monitor detection fails, and let
+            // Windows choose the default position
+            dpi = GetDpiForSystem()
+            x = INT(CW_USEDEFAULT)
+            y = INT(CW_USEDEFAULT)
+        }
+    }
+}
+
 /// Windows implementation of LuminaWindow using HWND.
 ///
 /// This implementation wraps a Windows window handle (HWND) and provides
@@ -271,22 +917,68 @@ internal struct WinWindow: LuminaWindow {
     let id: WindowID
     private var hwnd: HWND?
 
+    /// Outlives the record, so the proxy keeps its last state after close
+    private let stateProxy: WindowProxy
+
+    /// The HWND, if it still belongs to this window.
+    ///
+    /// A closed window's HWND may be parked and handed to a later window,
+    /// so a stale copy of this value must not reach it: every method goes
+    /// through this check and is a no-op once the record changed owner.
+    private var liveHWND: HWND? {
+        guard let hwnd, WinWindowRegistry.record(for: hwnd)?.windowID == id else {
+            return nil
+        }
+        return hwnd
+    }
+
     /// Create a new Windows window.
     ///
+    /// Takes a parked window from the pool when one with the same style is
+    /// available, otherwise creates a new HWND.
+    ///
     /// - Parameters:
-    ///   - title: Window title
-    ///   - size: Initial logical size
-    ///   - resizable: Whether the window can be resized by the user
-    ///   - monitor: Optional monitor to create the window on (uses primary if nil)
+    ///   - descriptor: Title, size, style and monitor of the window
+    ///   - placement: Target monitor and scale, resolved once per monitor
     ///   - closeCallback: Optional callback to invoke when the window closes
     /// - Returns: Result containing WinWindow or LuminaError
     static func create(
+        _ descriptor: WindowDescriptor,
+        placement: WinWindowPlacement,
+        closeCallback: WindowCloseCallback? = nil
+    ) -> Result<WinWindow, LuminaError> {
+        let hwnd: HWND
+        if let pooled = WinWindowRegistry.shared.takePooledWindow(resizable: descriptor.resizable) {
+            reuse(pooled, for: descriptor, placement: placement)
+            hwnd = pooled
+        } else {
+            switch createHiddenWindow(
+                title: descriptor.title,
+                size: descriptor.size,
+                resizable: descriptor.resizable,
+                placement: placement
+            ) {
+            case .success(let created):
+                hwnd = created
+            case .failure(let error):
+                return .failure(error)
+            }
+        }
+
+        let record = WinWindowRegistry.shared.register(hwnd: hwnd, closeCallback: closeCallback)
+
+        return .success(WinWindow(id: record.windowID, hwnd: hwnd, stateProxy: record.proxy))
+    }
+
+    /// Create a hidden, unregistered HWND.
+    ///
+    /// Also used to pre-warm the window pool.
+    static func createHiddenWindow(
         title: String,
         size: LogicalSize,
         resizable: Bool,
-        monitor: Monitor? = nil,
-        closeCallback: WindowCloseCallback? = nil
-    ) -> Result<WinWindow, LuminaError> {
+        placement: WinWindowPlacement
+    ) -> Result<HWND, LuminaError> {
         // Register window class on first call
         if !windowClassRegistered {
             if !registerWindowClass() {
@@ -295,62 +987,14 @@ internal struct WinWindow: LuminaWindow {
             windowClassRegistered = true
         }
 
-        // Configure window style
-        let dwStyle: DWORD = resizable
-            ? DWORD(WS_OVERLAPPEDWINDOW)
-            : DWORD(WS_OVERLAPPED | WS_CAPTION | WS_SYSMENU | WS_MINIMIZEBOX)
-
-        // Determine target monitor with fallback logic
-        // Priority: specified monitor -> primary monitor -> system DPI fallback
-        let targetMonitor: Monitor?
-        if let monitor = monitor {
-            targetMonitor = monitor
-        } else {
-            targetMonitor = try? Monitor.primary()
-        }
-
-        // Extract scale factor from monitor or fallback to system DPI
-        let scaleFactor: Float
-        if let monitor = targetMonitor {
-            scaleFactor = monitor.scaleFactor
-        } else {
-            // Fallback to system DPI if monitor detection fails
-            let systemDPI = GetDpiForSystem()
-            scaleFactor = Float(systemDPI) / 96.0
-        }
-
-        // Determine window position based on whether we have a target monitor
-        let defaultX: INT
-        let defaultY: INT
-        if let monitor = targetMonitor {
-            // Position window on the target monitor (offset from monitor's top-left)
-            // We need an explicit position here to ensure it appears on the correct monitor
-            defaultX = INT(monitor.physicalPosition.x + 100)
-            defaultY = INT(monitor.physicalPosition.y + 100)
-        } else {
-            // Use CW_USEDEFAULT to let Windows choose the default position
-            defaultX = INT(CW_USEDEFAULT)
-            defaultY = INT(CW_USEDEFAULT)
-        }
-
-        // Convert logical size to physical pixels
-        let physical = size.toPhysical(scaleFactor: scaleFactor)
-
-        // Calculate window rect including frame using DPI-aware API
-        // This ensures window borders and title bar are correctly sized for the target DPI
-        let targetDpi = UINT(scaleFactor)
-        var rect = RECT(
-            left: 0,
-            top: 0,
-            right: LONG(physical.width),
-            bottom: LONG(physical.height)
-        )
+        let dwStyle = windowStyle(resizable: resizable)
         // Use 0 for dwExStyle - no extended styles needed for basic window
         let dwExStyle = DWORD(0)
-        AdjustWindowRectExForDpi(&rect, dwStyle, false, dwExStyle, targetDpi)
 
-        let width = rect.right - rect.left
-        let height = rect.bottom - rect.top
+        // Calculate window rect including frame using DPI-aware API
+        // This ensures window borders and title bar are correctly sized for the target DPI
+        let targetDpi = placement.dpi
+        var rect = frameRect(for: size, style: dwStyle, dpi: targetDpi)
 
         // Create window with calculated size
         let hwnd = title.withCString(encodedAs: UTF16.self) { titlePtr in
@@ -360,10 +1004,10 @@ internal struct WinWindow: LuminaWindow {
                     classPtr,                   // Window class
                     titlePtr,                   // Window title
                     dwStyle,                    // Window style
-                    defaultX,                   // x
-                    defaultY,                   // y
-                    width,                      // width
-                    height,                     // height
+                    placement.x,                // x
+                    placement.y,                // y
+                    rect.right - rect.left,     // width
+                    rect.bottom - rect.top,     // height
                     nil,                        // parent
                     nil,                        // menu
                     GetModuleHandleW(nil),      // hInstance
@@ -378,35 +1022,25 @@ internal struct WinWindow: LuminaWindow {
         }
 
         // ALWAYS refresh the window frame at high DPI to fix title bar positioning
-        // Even if DPI matches, the initial frame calculation may be incorrect
+        // Even if DPI matches, the initial frame calculation may be incorrect.
+        // The rect only needs recomputing if Windows placed the window on a
+        // monitor with another DPI than the one we targeted.
         let actualDPI = GetDpiForWindow(validHwnd)
-        let actualScaleFactor = Float(actualDPI) / 96.0
-        let actualPhysical = size.toPhysical(scaleFactor: actualScaleFactor)
-
-        var adjustedRect = RECT(
-            left: 0,
-            top: 0,
-            right: LONG(actualPhysical.width),
-            bottom: LONG(actualPhysical.height)
-        )
-        AdjustWindowRectExForDpi(&adjustedRect, dwStyle, false, 0, actualDPI)
+        var flags = UINT(SWP_NOMOVE | SWP_NOZORDER | SWP_NOACTIVATE | SWP_FRAMECHANGED)
+        if actualDPI != targetDpi {
+            rect = frameRect(for: size, style: dwStyle, dpi: actualDPI)
+        } else {
+            flags |= UINT(SWP_NOSIZE)
+        }
 
-        // Always set the size to ensure proper frame metrics
+        // Set the size (if needed) and force frame recalculation in one call
         SetWindowPos(
             validHwnd,
             nil,
             0, 0,
-            adjustedRect.right - adjustedRect.left,
-            adjustedRect.bottom - adjustedRect.top,
-            UINT(SWP_NOMOVE | SWP_NOZORDER | SWP_NOACTIVATE)
-        )
-
-        // Force frame recalculation to fix title bar positioning at high DPI
-        SetWindowPos(
-            validHwnd,
-            nil,
-            0, 0, 0, 0,
-            UINT(SWP_NOMOVE | SWP_NOSIZE | SWP_NOZORDER | SWP_NOACTIVATE | SWP_FRAMECHANGED)
+            rect.right - rect.left,
+            rect.bottom - rect.top,
+            flags
         )
 
         // Invalidate and immediately redraw the non-client area (title bar)
@@ -420,14 +1054,71 @@ internal struct WinWindow: LuminaWindow {
         // Update the window to process all pending paint messages
         UpdateWindow(validHwnd)
 
-        let windowID = WindowID()
-        WinWindowRegistry.shared.register(hwnd: validHwnd, windowID: windowID, closeCallback: closeCallback)
+        return .success(validHwnd)
+    }
 
-        return .success(WinWindow(id: windowID, hwnd: validHwnd))
+    /// Re-title, move and resize a parked window for a new request.
+    private static func reuse(_ hwnd: HWND, for descriptor: WindowDescriptor, placement: WinWindowPlacement) {
+        _ = descriptor.title.withCString(encodedAs: UTF16.self) { titlePtr in
+            SetWindowTextW(hwnd, titlePtr)
+        }
+
+        // Move first: landing on a monitor with another DPI rescales the
+        // window (WM_DPICHANGED), and the frame below uses the final DPI
+        if placement.monitor != nil {
+            SetWindowPos(
+                hwnd,
+                nil,
+                placement.x,
+                placement.y,
+                0, 0,
+                UINT(SWP_NOSIZE | SWP_NOZORDER | SWP_NOACTIVATE)
+            )
+        }
+
+        let rect = frameRect(
+            for: descriptor.size,
+            style: windowStyle(resizable: descriptor.resizable),
+            dpi: GetDpiForWindow(hwnd)
+        )
+        SetWindowPos(
+            hwnd,
+            nil,
+            0, 0,
+            rect.right - rect.left,
+            rect.bottom - rect.top,
+            UINT(SWP_NOMOVE | SWP_NOZORDER | SWP_NOACTIVATE)
+        )
+    }
+
+    /// Window style for a Lumina window.
+    private static func windowStyle(resizable: Bool) -> DWORD {
+        resizable
+            ? DWORD(WS_OVERLAPPEDWINDOW)
+            : DWORD(WS_OVERLAPPED | WS_CAPTION | WS_SYSMENU | WS_MINIMIZEBOX)
+    }
+
+    /// Outer window rect for a logical content size at `dpi`.
+    private static func frameRect(for size: LogicalSize, style: DWORD, dpi: UINT) -> RECT {
+        let physical = size.toPhysical(scaleFactor: Float(dpi) / 96.0)
+        var rect = RECT(
+            left: 0,
+            top: 0,
+            right: LONG(physical.width),
+            bottom: LONG(physical.height)
+        )
+        AdjustWindowRectExForDpi(&rect, style, false, 0, dpi)
+        return rect
+    }
+
+    /// Drop this window after a failed batch (see `WinWindowRegistry.discard`).
+    internal func discard() {
+        guard let hwnd = liveHWND else { return }
+        WinWindowRegistry.shared.discard(hwnd: hwnd)
     }
 
     mutating func show() {
-        guard let hwnd = hwnd else { return }
+        guard let hwnd = liveHWND else { return }
         ShowWindow(hwnd, SW_SHOW)
         UpdateWindow(hwnd)
 
@@ -450,66 +1141,52 @@ internal struct WinWindow: LuminaWindow {
     }
 
     mutating func hide() {
-        guard let hwnd = hwnd else { return }
+        guard let hwnd = liveHWND else { return }
         ShowWindow(hwnd, SW_HIDE)
     }
 
     consuming func close() {
-        guard let hwnd = hwnd else { return }
-        DestroyWindow(hwnd)
+        guard let hwnd = liveHWND else { return }
+        if !WinWindowRegistry.shared.recycle(hwnd: hwnd) {
+            DestroyWindow(hwnd)
+        }
     }
 
     mutating func setTitle(_ title: borrowing String) {
-        guard let hwnd = hwnd else { return }
+        guard let hwnd = liveHWND else { return }
         _ = title.withCString(encodedAs: UTF16.self) { titlePtr in
             SetWindowTextW(hwnd, titlePtr)
         }
     }
 
-    borrowing func size() -> LogicalSize {
-        guard let hwnd = hwnd else { return LogicalSize(width: 0, height: 0) }
+    /// The cached metrics of a registered window.
+    private var metrics: WinWindowMetrics? {
+        liveHWND.flatMap { WinWindowRegistry.record(for: $0)?.metrics }
+    }
 
-        var rect = RECT()
-        GetClientRect(hwnd, &rect)
-        let scaleFactor = scaleFactor()
-        return PhysicalSize(
-            width: Int(rect.right - rect.left),
-            height: Int(rect.bottom - rect.top)
-        ).toLogical(scaleFactor: scaleFactor)
+    borrowing func size() -> LogicalSize {
+        guard metrics != nil else { return LogicalSize(width: 0, height: 0) }
+        // Published from WM_SIZE, which SetWindowPos sends synchronously
+        return stateProxy.size
     }
 
     mutating func resize(_ size: borrowing LogicalSize) {
-        guard let hwnd = hwnd else { return }
-
-        let currentScaleFactor = scaleFactor()
-        let physical = size.toPhysical(scaleFactor: currentScaleFactor)
-
-        // Get current window style
-        let dwStyle = DWORD(GetWindowLongPtrW(hwnd, GWL_STYLE))
-        let dwExStyle = DWORD(GetWindowLongPtrW(hwnd, GWL_EXSTYLE))
-
-        // Calculate window size including frame using DPI-aware API
-        let dpi = GetDpiForWindow(hwnd)
-        var newRect = RECT(
-            left: 0,
-            top: 0,
-            right: LONG(physical.width),
-            bottom: LONG(physical.height)
-        )
-        AdjustWindowRectExForDpi(&newRect, dwStyle, false, dwExStyle, dpi)
+        guard let hwnd = liveHWND, let metrics else { return }
 
+        // Outer size from the cached frame insets of the current DPI
+        let frame = metrics.frameSize(for: size)
         SetWindowPos(
             hwnd,
             nil,
             0, 0,
-            newRect.right - newRect.left,
-            newRect.bottom - newRect.top,
+            frame.width,
+            frame.height,
             UINT(SWP_NOMOVE | SWP_NOZORDER)
         )
     }
 
     borrowing func position() -> LogicalPosition {
-        guard let hwnd = hwnd else { return LogicalPosition(x: 0, y: 0) }
+        guard let hwnd = liveHWND else { return LogicalPosition(x: 0, y: 0) }
 
         var rect = RECT()
         GetWindowRect(hwnd, &rect)
@@ -521,7 +1198,7 @@ internal struct WinWindow: LuminaWindow {
     }
 
     mutating func moveTo(_ position: borrowing LogicalPosition) {
-        guard let hwnd = hwnd else { return }
+        guard let hwnd = liveHWND else { return }
 
         let physical = position.toPhysical(scaleFactor: scaleFactor())
         SetWindowPos(
@@ -535,25 +1212,47 @@ internal struct WinWindow: LuminaWindow {
     }
 
     mutating func setMinSize(_ size: borrowing LogicalSize?) {
-        guard let hwnd = hwnd else { return }
+        guard let hwnd = liveHWND else { return }
         WinWindowRegistry.shared.setMinSize(size, for: hwnd)
     }
 
     mutating func setMaxSize(_ size: borrowing LogicalSize?) {
-        guard let hwnd = hwnd else { return }
+        guard let hwnd = liveHWND else { return }
         WinWindowRegistry.shared.setMaxSize(size, for: hwnd)
     }
 
     mutating func requestFocus() {
-        guard let hwnd = hwnd else { return }
+        guard let hwnd = liveHWND else { return }
         SetForegroundWindow(hwnd)
         SetFocus(hwnd)
     }
 
     borrowing func scaleFactor() -> Float {
-        guard let hwnd = hwnd else { return 1.0 }
-        let dpi = GetDpiForWindow(hwnd)
-        return Float(dpi) / 96.0
+        metrics?.scaleFactor ?? 1.0
+    }
+
+    func proxy() -> WindowProxy {
+        stateProxy
+    }
+
+    func requestRedraw() {
+        guard let hwnd = liveHWND else { return }
+        WinWindowRegistry.shared.requestRedraw(hwnd: hwnd)
+    }
+
+    func rawWindowHandle() -> RawWindowHandle {
+        guard let hwnd = liveHWND else {
+            return .unavailable
+        }
+        return .win32(hwnd: UnsafeMutableRawPointer(hwnd), hinstance: UnsafeMutableRawPointer(GetModuleHandleW(nil)))
+    }
+
+    mutating func surface() -> Result<NativeSurface, LuminaError> {
+        guard let hwnd = liveHWND, let record = WinWindowRegistry.record(for: hwnd) else {
+            return .failure(.invalidState("Window is closed"))
+        }
+        record.presentsSwapchain = true
+        return .success(.win32(hwnd: UnsafeMutableRawPointer(hwnd), hinstance: UnsafeMutableRawPointer(GetModuleHandleW(nil))))
     }
 }
 
@@ -13,49 +13,42 @@ import Foundation
 private final class MacAppDelegate: NSObject, NSApplicationDelegate {
     var exitOnLastWindowClosed: Bool = true
 
+    /// Set by quit() so a running run(handler:) loop returns. Kept here
+    /// because every copy of the application value shares the delegate.
+    var quitRequested = false
+
+    /// didChangeScreenParametersNotification observer; observed directly
+    /// rather than through the delegate method so it works when the host
+    /// installed its own NSApp.delegate
+    var screenObserver: NSObjectProtocol?
+
+    deinit {
+        if let screenObserver {
+            NotificationCenter.default.removeObserver(screenObserver)
+        }
+    }
+
     func applicationShouldTerminateAfterLastWindowClosed(_ sender: NSApplication) -> Bool {
         return exitOnLastWindowClosed
     }
 }
 
-/// Thread-safe user event queue
-private final class UserEventQueue: @unchecked Sendable {
-    private let lock = NSLock()
-    private var events: [UserEvent] = []
+/// Backend state kept per window in the application's window registry.
+internal struct MacWindowState {
+    /// Whether the pointer is inside the window, used to deduplicate
+    /// enter/exit events. AppKit can spam us with duplicate
+    /// mouseEntered/mouseExited events, similar to SDL's handling in
+    /// SDL_cocoawindow.m
+    var pointerInside = false
 
-    func append(_ event: UserEvent) {
-        lock.lock()
-        defer { lock.unlock() }
-        events.append(event)
-    }
-
-    func removeAll() -> [UserEvent] {
-        lock.lock()
-        defer { lock.unlock() }
-        let allEvents = events
-        events.removeAll()
-        return allEvents
-    }
-}
+    /// Key and pointer state for keyboardState(for:)/pointerState(for:)
+    var input = WindowInputState()
 
-/// Thread-safe window event queue
-private final class WindowEventQueue: @unchecked Sendable {
-    private let lock = NSLock()
-    private var events: [WindowEvent] = []
+    /// Input categories translated for this window (nil: the application's mask)
+    var eventMask: EventMask?
 
-    func append(_ event: WindowEvent) {
-        lock.lock()
-        defer { lock.unlock() }
-        events.append(event)
-    }
-
-    func removeAll() -> [WindowEvent] {
-        lock.lock()
-        defer { lock.unlock() }
-        let allEvents = events
-        events.removeAll()
-        return allEvents
-    }
+    /// Geometry for input translation, shared with the window's delegate
+    var translation: MacTranslationContext?
 }
 
 /// macOS implementation of LuminaApp.
@@ -66,17 +59,66 @@ private final class WindowEventQueue: @unchecked Sendable {
 /// It should be treated as an implementation detail.
 @MainActor
 struct MacApplication: LuminaApp {
-    private var shouldQuit: Bool = false
-    private let userEventQueue = UserEventQueue()
-    private let windowEventQueue = WindowEventQueue()
-    private var windowRegistry = WindowRegistry<Int>()  // NSWindow.windowNumber -> WindowID
+    private let userEventChannel = UserEventChannel<EventEnvelope>()
+    private let windowEventQueue = EventQueue<EventRingBuffer>()
+    private let instrumentation = EventLoopInstrumentation()
+    private let pipeline: EventPipeline
+    private let windowRegistry = WindowRegistry<Int, MacWindowState>()  // NSWindow.windowNumber -> WindowID
+    private let translationCache = MacTranslationCache()
     private var onWindowClosed: WindowCloseCallback?
     private let appDelegate: MacAppDelegate
 
-    /// Track pointer enter/exit state per window to deduplicate events.
-    /// AppKit can spam us with duplicate mouseEntered/mouseExited events,
-    /// similar to SDL's handling in SDL_cocoawindow.m
-    private var pointerInsideWindow: [WindowID: Bool] = [:]
+    /// How waitForEvents() sleeps when idle.
+    var controlFlow: ControlFlow = .wait
+
+    /// Input categories translated for windows without their own mask.
+    var eventMask: EventMask = .all {
+        didSet {
+            guard eventMask.contains(.pointerMotion) != oldValue.contains(.pointerMotion) else {
+                return
+            }
+            for nsWindow in NSApp.windows {
+                guard let id = windowRegistry.windowID(for: nsWindow.windowNumber),
+                      windowRegistry[id]?.eventMask == nil else {
+                    continue
+                }
+                setPointerTracking(eventMask.contains(.pointerMotion), for: nsWindow)
+            }
+        }
+    }
+
+    /// Receives every event handed to the application.
+    var eventRecorder: EventTraceRecorder? {
+        get { pipeline.recorder }
+        set { pipeline.recorder = newValue }
+    }
+
+    var instrumentationEnabled: Bool {
+        get { instrumentation.isEnabled }
+        set { instrumentation.isEnabled = newValue }
+    }
+
+    func statistics() -> EventLoopStatistics {
+        instrumentation.snapshot()
+    }
+
+    mutating func resetStatistics() {
+        instrumentation.reset()
+    }
+
+    /// Whether mouse motion NSEvents also produce .rawMotion events.
+    var rawPointerInput: Bool = false
+
+    /// Shared with every window, whose display link runs it during live resize
+    private let modalLoop: MacModalLoop
+
+    /// Hidden windows parked for reuse, shared with every window's delegate
+    private let windowPool = MacWindowPool()
+
+    var modalLoopHandler: ModalLoopHandler? {
+        get { modalLoop.handler }
+        set { modalLoop.handler = newValue }
+    }
 
     /// Whether the application should quit when the last window is closed.
     var exitOnLastWindowClosed: Bool {
@@ -85,6 +127,9 @@ struct MacApplication: LuminaApp {
     }
 
     init() throws {
+        self.pipeline = EventPipeline(instrumentation: instrumentation)
+        self.modalLoop = MacModalLoop(pipeline: pipeline)
+
         // Ensure NSApplication is initialized
         _ = NSApplication.shared
 
@@ -95,6 +140,28 @@ struct MacApplication: LuminaApp {
             NSApp.delegate = delegate
         }
 
+        // Cache Monitor.all() until the display configuration changes
+        let eventQueue = windowEventQueue
+        delegate.screenObserver = NotificationCenter.default.addObserver(
+            forName: NSApplication.didChangeScreenParametersNotification,
+            object: NSApp,
+            queue: .main
+        ) { _ in
+            guard MonitorCache.shared.invalidate() else {
+                return
+            }
+            eventQueue.append(EventEnvelope(.monitorsChanged))
+            MainActor.assumeIsolated {
+                MacApplication.postWakeupEvent()
+            }
+        }
+        MonitorCache.shared.startTracking()
+
+        // The last window must really close for AppKit to terminate
+        windowPool.allowsRecycling = { [registry = windowRegistry] in
+            !delegate.exitOnLastWindowClosed || registry.count > 1
+        }
+
         // Set activation policy to regular app (shows in Dock)
         NSApp.setActivationPolicy(.regular)
 
@@ -129,197 +196,545 @@ struct MacApplication: LuminaApp {
     }
 
     mutating func run() throws {
-        shouldQuit = false
-
-        while !shouldQuit {
-            // Block waiting for next event
-            guard let nsEvent = NSApp.nextEvent(
-                matching: .any,
-                until: .distantFuture,
-                inMode: .default,
-                dequeue: true
-            ) else {
-                continue
-            }
+        try run { _ in .wait }
+    }
 
-            // Send event to NSApp for standard processing
-            NSApp.sendEvent(nsEvent)
+    mutating func run(handler: EventHandler) throws {
+        appDelegate.quitRequested = false
+
+        try withoutActuallyEscaping(handler) { handler in
+            let dispatcher = EventDispatcher(handler: handler, controlFlow: controlFlow)
+            dispatcher.recorder = pipeline.recorder
+
+            // Events buffered by earlier poll() calls go first
+            var pending: [EventEnvelope] = []
+            pipeline.drainBuffered(into: &pending)
+            requeue(dispatcher.dispatch(pending))
+
+            // Live resize blocks this loop; the display link delivers instead
+            modalLoop.dispatcher = dispatcher
+            defer { modalLoop.dispatcher = nil }
+
+            while !dispatcher.isExiting && !appDelegate.quitRequested {
+                // Don't block while delegate or user events are waiting
+                let idle = windowEventQueue.isEmpty && userEventChannel.isEmpty
+                let deadline: Date
+                switch dispatcher.controlFlow {
+                case .poll, .exit:
+                    deadline = .distantPast
+                case .wait:
+                    deadline = idle ? .distantFuture : .distantPast
+                case .waitUntil(let instant):
+                    // A passed deadline has nothing left to wake for; wait
+                    let timeout = instant.secondsFromNow
+                    deadline = !idle ? .distantPast
+                        : timeout > 0 ? Date(timeIntervalSinceNow: timeout) : .distantFuture
+                }
+
+                let blocks = deadline != .distantPast
+                if blocks {
+                    instrumentation.count(.waits)
+                }
+                let next = instrumentation.measure(blocks ? .wait : .dequeue) {
+                    NSApp.nextEvent(matching: .any, until: deadline, inMode: .default, dequeue: true)
+                }
+                if let nsEvent = next {
+                    send(nsEvent)
+
+                    // Dispatch straight from the sendEvent path, no queue
+                    let timestamp = EventTimestamp(seconds: nsEvent.timestamp)
+                    if rawPointerInput, let raw = translateRawMotion(nsEvent) {
+                        let envelope = EventEnvelope(raw, timestamp: timestamp)
+                        if !dispatcher.dispatch(envelope) {
+                            pipeline.enqueue(envelope)
+                        }
+                    }
+                    if let event = translate(nsEvent) {
+                        let envelope = EventEnvelope(event, timestamp: timestamp)
+                        if !dispatcher.dispatch(envelope) {
+                            pipeline.enqueue(envelope)
+                        }
+                    }
+                }
+
+                // Delegate callbacks (resize, focus, redraw) and user events
+                pending.removeAll(keepingCapacity: true)
+                let windowCount = windowEventQueue.drain(into: &pending)
+                for envelope in pending.prefix(windowCount) {
+                    applyInputState(envelope.event)
+                }
+                userEventChannel.drain(into: &pending, maxCount: .max) { $0 }
+                requeue(dispatcher.dispatch(pending))
+            }
+        }
+    }
 
-            // Process any pending user events
-            processUserEvents()
+    /// Keep events the run(handler:) handler didn't take for the next poll().
+    private func requeue(_ envelopes: ArraySlice<EventEnvelope>) {
+        for envelope in envelopes {
+            pipeline.enqueue(envelope)
         }
     }
 
     mutating func poll() throws -> Event? {
-        // Loop until we find a translatable event or run out of events
-        while true {
-            // Check for pending NSEvents (non-blocking)
-            guard let nsEvent = NSApp.nextEvent(
-                matching: .any,
-                until: .distantPast,  // Non-blocking: return immediately
-                inMode: .default,
-                dequeue: true
-            ) else {
-                // No NSEvents available, check for window events first, then user events
-                if let windowEvent = pollWindowEvent() {
-                    return windowEvent
-                }
-                return pollUserEvent()
-            }
+        try pollEnvelope()?.event
+    }
+
+    mutating func pollEnvelope() throws -> EventEnvelope? {
+        pipeline.next(
+            poll: { pollPlatformEvent() },
+            drain: { drainPlatformEvents(into: &$0, maxCount: $1) }
+        )
+    }
+
+    mutating func drain(into events: inout [Event], maxCount: Int) throws -> Int {
+        pipeline.drain(into: &events, maxCount: maxCount, transform: \.event) {
+            drainPlatformEvents(into: &$0, maxCount: $1)
+        }
+    }
+
+    mutating func drain(into envelopes: inout [EventEnvelope], maxCount: Int) throws -> Int {
+        pipeline.drain(into: &envelopes, maxCount: maxCount, transform: { $0 }) {
+            drainPlatformEvents(into: &$0, maxCount: $1)
+        }
+    }
+
+    mutating func setWindowEventQueue(_ enabled: Bool, for windowID: WindowID) {
+        pipeline.setWindowQueue(enabled, for: windowID)
+    }
+
+    func hasWindowEventQueue(for windowID: WindowID) -> Bool {
+        pipeline.hasWindowQueue(for: windowID)
+    }
+
+    mutating func poll(window windowID: WindowID) throws -> Event? {
+        pipeline.next(for: windowID) {
+            drainPlatformEvents(into: &$0, maxCount: $1)
+        }?.event
+    }
+
+    mutating func drain(window windowID: WindowID, into events: inout [Event], maxCount: Int) throws -> Int {
+        pipeline.drain(for: windowID, into: &events, maxCount: maxCount, transform: \.event) {
+            drainPlatformEvents(into: &$0, maxCount: $1)
+        }
+    }
+
+    var eventCoalescing: EventCoalescing {
+        get { pipeline.coalescing }
+        set { pipeline.coalescing = newValue }
+    }
+
+    mutating func setEventCoalescing(_ options: EventCoalescing?, for windowID: WindowID) {
+        pipeline.setCoalescing(options, for: windowID)
+    }
+
+    func eventCoalescing(for windowID: WindowID) -> EventCoalescing {
+        pipeline.coalescing(for: windowID)
+    }
 
+    func coalescedPointerSamples(for windowID: WindowID) -> [LogicalPosition] {
+        pipeline.pointerSamples(for: windowID)
+    }
+
+    mutating func setEventMask(_ mask: EventMask?, for windowID: WindowID) {
+        guard windowRegistry[windowID] != nil else {
+            return
+        }
+        windowRegistry[windowID]?.eventMask = mask
+
+        if let windowNumber = windowRegistry.handle(for: windowID),
+           let nsWindow = NSApp.window(withWindowNumber: windowNumber) {
+            setPointerTracking((mask ?? eventMask).contains(.pointerMotion), for: nsWindow)
+        }
+    }
+
+    func eventMask(for windowID: WindowID) -> EventMask {
+        windowRegistry[windowID]?.eventMask ?? eventMask
+    }
+
+    func keyboardState(for windowID: WindowID) -> KeyboardState {
+        windowRegistry[windowID]?.input.keyboard ?? KeyboardState()
+    }
+
+    func pointerState(for windowID: WindowID) -> PointerState {
+        windowRegistry[windowID]?.input.pointer ?? PointerState()
+    }
+
+    /// Return the next translated event straight from AppKit and the queues.
+    private mutating func pollPlatformEvent() -> EventEnvelope? {
+        // Loop until we find a translatable event or run out of events
+        while let nsEvent = nextPendingEvent() {
             // Send event to NSApp for standard processing (window management, etc.)
-            NSApp.sendEvent(nsEvent)
+            send(nsEvent)
 
-            // Try to translate to Lumina event if it's associated with a tracked window
-            if let windowNumber = nsEvent.window?.windowNumber,
-               let windowID = windowRegistry.windowID(for: windowNumber) {
-                if let event = translateNSEvent(nsEvent, for: windowID) {
-                    // Handle mouse focus: generate enter on first movement,
-                    // respect exit but filter spurious ones
-                    if case .pointer(let pointerEvent) = event {
-                        switch pointerEvent {
-                        case .moved(let id, _):
-                            // Generate enter event on first movement in window
-                            let wasInside = pointerInsideWindow[id] ?? false
-                            if !wasInside {
-                                pointerInsideWindow[id] = true
-                                return .pointer(.entered(id))
-                            }
-                        case .entered(_):
-                            // Ignore enter events - generate from move instead
-                            continue
-                        case .left(let id):
-                            // Respect exit events, but only if we were inside
-                            if pointerInsideWindow[id] == true {
-                                pointerInsideWindow[id] = false
-                            } else {
-                                // Skip spurious exit
-                                continue
-                            }
-                        default:
-                            break
-                        }
-                    }
-                    return event
+            let timestamp = EventTimestamp(seconds: nsEvent.timestamp)
+            let event = translate(nsEvent)
+
+            // Raw motion goes first; the translated event is returned next
+            if rawPointerInput, let raw = translateRawMotion(nsEvent) {
+                if let event {
+                    pipeline.enqueue(EventEnvelope(event, timestamp: timestamp))
                 }
+                return EventEnvelope(raw, timestamp: timestamp)
+            }
+
+            if let event {
+                return EventEnvelope(event, timestamp: timestamp)
             }
 
             // Event processed but not translatable (e.g., menu events, system events)
             // Continue looping to check for the next event
         }
+
+        // No NSEvents available, check for window events first, then user events
+        if let envelope = windowEventQueue.removeFirst() {
+            applyInputState(envelope.event)
+            return envelope
+        }
+        return userEventChannel.popFirst()
     }
 
-    /// Poll for a single window event from the queue.
-    private mutating func pollWindowEvent() -> Event? {
-        let pendingEvents = windowEventQueue.removeAll()
-        guard let windowEvent = pendingEvents.first else {
-            return nil
+    /// Translate every pending NSEvent, then drain the window and user queues.
+    private mutating func drainPlatformEvents(into events: inout [EventEnvelope], maxCount: Int) -> Int {
+        let startCount = events.count
+
+        // Dispatch and translate every pending NSEvent (non-blocking)
+        while events.count - startCount < maxCount, let nsEvent = nextPendingEvent() {
+            send(nsEvent)
+            let timestamp = EventTimestamp(seconds: nsEvent.timestamp)
+            // Raw motion first; keep both within maxCount, the overflow is returned next
+            if rawPointerInput, let raw = translateRawMotion(nsEvent) {
+                append(EventEnvelope(raw, timestamp: timestamp), to: &events, from: startCount, maxCount: maxCount)
+            }
+            if let event = translate(nsEvent) {
+                append(EventEnvelope(event, timestamp: timestamp), to: &events, from: startCount, maxCount: maxCount)
+            }
         }
 
-        // Re-queue remaining events
-        for event in pendingEvents.dropFirst() {
-            windowEventQueue.append(event)
+        // Then window events, then user events, each taken in one batch
+        let translated = events.count - startCount
+        let windowCount = windowEventQueue.drain(into: &events, maxCount: maxCount - translated)
+        for envelope in events[(startCount + translated)...] {
+            applyInputState(envelope.event)
         }
+        userEventChannel.drain(into: &events, maxCount: maxCount - translated - windowCount) { $0 }
 
-        return .window(windowEvent)
+        return events.count - startCount
+    }
+
+    /// Append `envelope` to a drain batch, or buffer it in the pipeline
+    /// once the batch started at `startCount` holds `maxCount` events.
+    private func append(_ envelope: EventEnvelope, to events: inout [EventEnvelope], from startCount: Int, maxCount: Int) {
+        if events.count - startCount < maxCount {
+            events.append(envelope)
+        } else {
+            pipeline.enqueue(envelope)
+        }
+    }
+
+    /// Dequeue the next pending NSEvent without blocking.
+    private func nextPendingEvent() -> NSEvent? {
+        NSApp.nextEvent(
+            matching: .any,
+            until: .distantPast,  // Non-blocking: return immediately
+            inMode: .default,
+            dequeue: true
+        )
     }
 
-    /// Poll for a single user event from the queue.
-    private mutating func pollUserEvent() -> Event? {
-        let pendingEvents = userEventQueue.removeAll()
-        guard let userEvent = pendingEvents.first else {
+    /// Hand an NSEvent to AppKit for standard processing (window
+    /// management, responder chain, delegates).
+    private func send(_ nsEvent: NSEvent) {
+        instrumentation.count(.messagesDispatched)
+        instrumentation.measure(.dispatch) {
+            NSApp.sendEvent(nsEvent)
+        }
+    }
+
+    /// Translate a dispatched NSEvent to a Lumina event.
+    ///
+    /// - Returns: The translated event, or nil if the event should be skipped
+    private mutating func translate(_ nsEvent: NSEvent) -> Event? {
+        let event = instrumentation.measure(.translate) {
+            translateTracked(nsEvent)
+        }
+        if event != nil {
+            instrumentation.count(.eventsTranslated)
+        }
+        return event
+    }
+
+    /// `translate(_:)` without instrumentation.
+    ///
+    /// Only events associated with a tracked window are translated. Pointer
+    /// enter/exit events are deduplicated here.
+    private mutating func translateTracked(_ nsEvent: NSEvent) -> Event? {
+        guard let nsWindow = nsEvent.window, let context = translationContext(for: nsWindow) else {
+            return nil
+        }
+        let mask = eventMask(for: context.windowID)
+        guard let event = translateNSEvent(nsEvent, in: context, mask: mask) else {
+            if instrumentation.isEnabled, let category = inputCategory(of: nsEvent.type), !mask.contains(category) {
+                instrumentation.count(.eventsDropped)
+            }
             return nil
         }
+        applyInputState(event)
+
+        // Handle mouse focus: generate enter on first movement,
+        // respect exit but filter spurious ones
+        if case .pointer(let pointerEvent) = event {
+            switch pointerEvent {
+            case .moved(let id, _):
+                // Generate enter event on first movement in window
+                let wasInside = windowRegistry[id]?.pointerInside ?? false
+                if !wasInside {
+                    windowRegistry[id]?.pointerInside = true
+                    return .pointer(.entered(id))
+                }
+            case .entered(_):
+                // Ignore enter events - generate from move instead
+                return nil
+            case .left(let id):
+                // Respect exit events, but only if we were inside
+                if windowRegistry[id]?.pointerInside == true {
+                    windowRegistry[id]?.pointerInside = false
+                } else {
+                    // Skip spurious exit
+                    return nil
+                }
+            default:
+                break
+            }
+        }
+        return event
+    }
 
-        // Re-queue remaining events
-        for event in pendingEvents.dropFirst() {
-            userEventQueue.append(event)
+    /// The translation context of a tracked window, nil for other windows
+    /// (panels, menus, windows of other libraries).
+    private func translationContext(for nsWindow: NSWindow) -> MacTranslationContext? {
+        if let cached = translationCache.context(for: nsWindow) {
+            return cached
         }
+        guard let windowID = windowRegistry.windowID(for: nsWindow.windowNumber),
+              let context = windowRegistry[windowID]?.translation else {
+            return nil
+        }
+        translationCache.store(context, for: nsWindow)
+        return context
+    }
 
-        return .user(userEvent)
+    /// Update the window's keyboard/pointer snapshot from a translated event.
+    private func applyInputState(_ event: Event) {
+        let windowID: WindowID
+        switch event {
+        case .keyboard(.keyDown(let id, _, _)), .keyboard(.keyUp(let id, _, _)),
+             .pointer(.moved(let id, _)), .pointer(.entered(let id)), .pointer(.left(let id)),
+             .pointer(.buttonPressed(let id, _, _)), .pointer(.buttonReleased(let id, _, _)),
+             .window(.unfocused(let id)):
+            windowID = id
+        default:
+            return
+        }
+        windowRegistry[windowID]?.input.apply(event)
     }
 
     mutating func wait() throws {
-        // Use CFRunLoop for low-power wait
-        // This will block until an event arrives, then return without processing it
-        CFRunLoopRunInMode(CFRunLoopMode.defaultMode, .infinity, true)
+        waitForEvent(timeout: .infinity)
+    }
 
-        // After waking up, process user events
-        processUserEvents()
+    mutating func wait(until deadline: ContinuousClock.Instant) throws {
+        let timeout = deadline.secondsFromNow
+        guard timeout > 0 else {
+            return
+        }
+        waitForEvent(timeout: timeout)
     }
 
-    func postUserEvent(_ event: UserEvent) {
-        // Thread-safe enqueue
-        userEventQueue.append(event)
-
-        // Wake up the event loop by posting a dummy NSEvent
-        // This ensures wait() wakes up when a user event is posted
-        // Post to MainActor since NSApp.postEvent requires main thread
-        Task { @MainActor in
-            let dummyEvent = NSEvent.otherEvent(
-                with: .applicationDefined,
-                location: .zero,
-                modifierFlags: [],
-                timestamp: ProcessInfo.processInfo.systemUptime,
-                windowNumber: 0,
-                context: nil,
-                subtype: 0,
-                data1: 0,
-                data2: 0
-            )
+    func waitAsync() async throws {
+        guard userEventChannel.isEmpty && windowEventQueue.isEmpty && pipeline.isEmpty else {
+            return
+        }
+        // Something already sits in AppKit's queue; no wakeup will follow
+        if NSApp.nextEvent(matching: .any, until: .distantPast, inMode: .default, dequeue: false) != nil {
+            return
+        }
 
-            if let event = dummyEvent {
-                NSApp.postEvent(event, atStart: false)
+        // One continuation per wakeup: resume the first time the main run
+        // loop wakes from sleep (NSEvent, user event, display link, timer)
+        await withCheckedContinuation { (continuation: CheckedContinuation<Void, Never>) in
+            let mainRunLoop = CFRunLoopGetMain()
+            let observer = CFRunLoopObserverCreateWithHandler(
+                nil,
+                CFRunLoopActivity.afterWaiting.rawValue,
+                false,  // one-shot
+                0
+            ) { observer, _ in
+                CFRunLoopRemoveObserver(mainRunLoop, observer, .commonModes)
+                continuation.resume()
             }
+            CFRunLoopAddObserver(mainRunLoop, observer, .commonModes)
+        }
+    }
+
+    /// Block in the run loop until an event arrives or `timeout` elapses.
+    private mutating func waitForEvent(timeout: CFTimeInterval) {
+        // Events already collected from the channel, queued by window
+        // delegates or buffered by the pipeline won't trigger another wakeup
+        guard userEventChannel.isEmpty && windowEventQueue.isEmpty && pipeline.isEmpty else {
+            return
+        }
+
+        // Use CFRunLoop for low-power wait
+        // This will block until an event arrives (or the timeout passes),
+        // then return without processing it
+        instrumentation.count(.waits)
+        instrumentation.measure(.wait) {
+            _ = CFRunLoopRunInMode(CFRunLoopMode.defaultMode, timeout, true)
         }
     }
 
+    func postUserEvent(_ event: UserEvent) {
+        // Lock-free enqueue; only the first post since the last drain needs
+        // to wake the event loop, later posts ride on the pending wakeup
+        let needsWakeup = instrumentation.measure(.enqueue) {
+            userEventChannel.send(EventEnvelope(.user(event)))
+        }
+        guard needsWakeup else {
+            return
+        }
+        instrumentation.count(.wakeups)
+
+        // Wake up the event loop by posting a dummy NSEvent on the main run loop.
+        // This ensures wait() wakes up when a user event is posted.
+        // CFRunLoopPerformBlock avoids spawning a Task; NSApp.postEvent requires main thread.
+        let mainRunLoop = CFRunLoopGetMain()
+        CFRunLoopPerformBlock(mainRunLoop, CFRunLoopMode.commonModes.rawValue) {
+            MainActor.assumeIsolated {
+                MacApplication.postWakeupEvent()
+            }
+        }
+        CFRunLoopWakeUp(mainRunLoop)
+    }
+
     mutating func createWindow(
         title: String,
         size: LogicalSize,
         resizable: Bool,
         monitor: Monitor?
     ) -> Result<LuminaWindow, LuminaError> {
-        // Capture windowEventQueue for posting close events
-        let eventQueue = windowEventQueue
+        let descriptor = WindowDescriptor(title: title, size: size, resizable: resizable, monitor: monitor)
+        return makeWindow(
+            descriptor,
+            placement: MacWindowPlacement(monitor: monitor),
+            closeCallback: makeCloseCallback()
+        ).map { $0 as LuminaWindow }
+    }
 
-        // Create the window using MacWindow
-        let result = MacWindow.create(
-            title: title,
-            size: size,
-            resizable: resizable,
-            monitor: monitor,
-            closeCallback: { [onWindowClosed] windowID in
-                // Post a window closed event so custom event loops can detect it
-                eventQueue.append(.closed(windowID))
-
-                // Wake up the event loop
-                let dummyEvent = NSEvent.otherEvent(
-                    with: .applicationDefined,
-                    location: .zero,
-                    modifierFlags: [],
-                    timestamp: ProcessInfo.processInfo.systemUptime,
-                    windowNumber: 0,
-                    context: nil,
-                    subtype: 0,
-                    data1: 0,
-                    data2: 0
-                )
-                if let event = dummyEvent {
-                    NSApp.postEvent(event, atStart: false)
+    mutating func createWindows(_ descriptors: [WindowDescriptor]) -> Result<[LuminaWindow], LuminaError> {
+        let closeCallback = makeCloseCallback()
+
+        // Screens are matched once per distinct monitor
+        var placements: [MonitorID?: MacWindowPlacement] = [:]
+        var windows: [MacWindow] = []
+        windows.reserveCapacity(descriptors.count)
+
+        for descriptor in descriptors {
+            let key = descriptor.monitor?.id
+            let placement = placements[key] ?? MacWindowPlacement(monitor: descriptor.monitor)
+            placements[key] = placement
+
+            switch makeWindow(descriptor, placement: placement, closeCallback: closeCallback) {
+            case .success(let window):
+                windows.append(window)
+            case .failure(let error):
+                // All or nothing; the discarded windows never report .closed
+                for window in windows {
+                    window.discard()
+                    windowRegistry.unregister(window.id)
+                    translationCache.invalidate(window.id)
                 }
-
-                // Trigger the application's close callback
-                onWindowClosed?(windowID)
+                return .failure(error)
             }
+        }
+
+        return .success(windows.map { $0 as LuminaWindow })
+    }
+
+    /// Create one window and register it.
+    private func makeWindow(
+        _ descriptor: WindowDescriptor,
+        placement: MacWindowPlacement,
+        closeCallback: @escaping WindowCloseCallback
+    ) -> Result<MacWindow, LuminaError> {
+        let registry = windowRegistry
+
+        // Allocate the window's slot up front; the delegate needs the ID
+        let windowID = registry.reserve(MacWindowState())
+
+        // Create the window using MacWindow
+        let result = MacWindow.create(
+            id: windowID,
+            descriptor: descriptor,
+            placement: placement,
+            eventQueue: windowEventQueue,
+            modalLoop: modalLoop,
+            pool: windowPool,
+            closeCallback: closeCallback
         )
 
         // Register the window if creation succeeded
-        if case .success(let macWindow) = result {
-            windowRegistry.register(macWindow.windowNumber, id: macWindow.id)
+        switch result {
+        case .success(let macWindow):
+            registry.register(macWindow.windowNumber, id: macWindow.id)
+            registry[macWindow.id]?.translation = macWindow.translationContext
+            macWindow.setTracksPointerMotion(eventMask.contains(.pointerMotion))
+        case .failure:
+            registry.unregister(windowID)
         }
 
-        return result.map { $0 as LuminaWindow }
+        return result
+    }
+
+    /// Close handling shared by every window created by this application.
+    private func makeCloseCallback() -> WindowCloseCallback {
+        // Capture windowEventQueue for posting close events
+        let eventQueue = windowEventQueue
+        let registry = windowRegistry
+
+        return { [onWindowClosed, pipeline, translationCache] windowID in
+            // Free the window's slot; late NSEvents for it are dropped
+            registry.unregister(windowID)
+            translationCache.invalidate(windowID)
+            pipeline.setCoalescing(nil, for: windowID)
+
+            // Post a window closed event so custom event loops can detect it
+            eventQueue.append(EventEnvelope(.window(.closed(windowID))))
+
+            // Wake up the event loop
+            MacApplication.postWakeupEvent()
+
+            // Trigger the application's close callback
+            onWindowClosed?(windowID)
+        }
+    }
+
+    var windowPoolCapacity: Int {
+        get { windowPool.capacity }
+        set { windowPool.capacity = newValue }
+    }
+
+    mutating func prewarmWindows(_ count: Int, resizable: Bool) -> Result<Void, LuminaError> {
+        var created = 0
+        while created < count && windowPool.hasRoom {
+            let nsWindow = MacWindow.makeNSWindow(
+                contentSize: NSSize(width: 640, height: 480),
+                resizable: resizable
+            )
+            _ = windowPool.park(nsWindow)
+            created += 1
+        }
+        return .success(())
     }
 
     mutating func setWindowCloseCallback(_ callback: @escaping WindowCloseCallback) {
@@ -330,8 +745,19 @@ struct MacApplication: LuminaApp {
         // Request application termination
         // This will cause the event loop to exit
         NSApp.stop(nil)
+        appDelegate.quitRequested = true
 
         // Post a dummy event to wake up the event loop immediately
+        MacApplication.postWakeupEvent()
+    }
+
+    // MARK: - Private Helpers
+
+    /// Post an application-defined dummy NSEvent to wake the event loop.
+    ///
+    /// nextEvent(matching:until:) and CFRunLoopRunInMode return once the
+    /// event arrives; translate() ignores it since it has no window.
+    static func postWakeupEvent() {
         let dummyEvent = NSEvent.otherEvent(
             with: .applicationDefined,
             location: .zero,
@@ -348,35 +774,12 @@ struct MacApplication: LuminaApp {
             NSApp.postEvent(event, atStart: false)
         }
     }
-
-    // MARK: - Private Helpers
-
-    /// Process all pending user events from the thread-safe queue.
-    ///
-    /// - Returns: true if any user events were processed
-    @discardableResult
-    private mutating func processUserEvents() -> Bool {
-        let pendingEvents = userEventQueue.removeAll()
-
-        guard !pendingEvents.isEmpty else {
-            return false
-        }
-
-        for userEvent in pendingEvents {
-            // In a full implementation, this would dispatch to registered handlers
-            // For now, we just ensure the event is dequeued
-            // The public API layer will handle event callbacks
-            _ = userEvent
-        }
-
-        return true
-    }
 }
 
 // MARK: - Sendable Conformance
 
 // MacApplication is @MainActor isolated, so it's safe to conform to Sendable
-// The userEventLock protects the shared mutable state (userEventQueue)
+// The lock-free userEventChannel protects the state shared with producer threads
 extension MacApplication: @unchecked Sendable {}
 
 #endif
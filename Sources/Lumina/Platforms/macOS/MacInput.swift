@@ -9,6 +9,68 @@ import Foundation
 /// Event types, handling coordinate conversion, modifier key mapping, and
 /// key code normalization.
 
+// MARK: - Translation Context
+
+/// Per-window values needed to translate input, cached so translating a
+/// mouse event is plain arithmetic.
+///
+/// Built when the window is created and kept current by its delegate on
+/// resize, move and backing scale changes, so translation never asks the
+/// NSWindow for its frame or converts rects.
+@MainActor
+internal final class MacTranslationContext {
+    let windowID: WindowID
+
+    /// Content view height in points, for flipping AppKit's bottom-left origin
+    private(set) var contentHeight: CGFloat = 0
+
+    /// Backing scale factor of the window's current screen
+    private(set) var scaleFactor: Float = 1
+
+    init(windowID: WindowID, window: NSWindow) {
+        self.windowID = windowID
+        update(from: window)
+    }
+
+    /// Re-read the geometry after a resize, move or backing change.
+    func update(from window: NSWindow) {
+        contentHeight = window.contentRect(forFrameRect: window.frame).height
+        scaleFactor = Float(window.backingScaleFactor)
+    }
+}
+
+/// Remembers the context of the window the last event went to.
+///
+/// Input arrives in runs for one window, so comparing the event's NSWindow
+/// with the previous one skips the windowNumber-to-WindowID hash lookup for
+/// nearly every event. The entry must be cleared when its window is
+/// unregistered, since a new NSWindow may reuse the address.
+@MainActor
+internal final class MacTranslationCache {
+    private var window: ObjectIdentifier?
+    private var context: MacTranslationContext?
+
+    init() {}
+
+    /// The cached context if `nsWindow` received the previous event.
+    func context(for nsWindow: NSWindow) -> MacTranslationContext? {
+        window == ObjectIdentifier(nsWindow) ? context : nil
+    }
+
+    func store(_ context: MacTranslationContext, for nsWindow: NSWindow) {
+        window = ObjectIdentifier(nsWindow)
+        self.context = context
+    }
+
+    /// Forget the entry if it belongs to `windowID`.
+    func invalidate(_ windowID: WindowID) {
+        if context?.windowID == windowID {
+            window = nil
+            context = nil
+        }
+    }
+}
+
 // MARK: - Event Translation
 
 /// Translate an NSEvent to a Lumina Event.
@@ -18,26 +80,33 @@ import Foundation
 ///
 /// - Parameters:
 ///   - nsEvent: The AppKit event to translate
-///   - windowID: The WindowID associated with this event
+///   - context: Cached state of the window the event was sent to
+///   - mask: Input categories the window subscribes to
 /// - Returns: Lumina Event, or nil if the event should be ignored
 @MainActor
-internal func translateNSEvent(_ nsEvent: NSEvent, for windowID: WindowID) -> Event? {
+internal func translateNSEvent(_ nsEvent: NSEvent, in context: MacTranslationContext, mask: EventMask = .all) -> Event? {
+    // Drop unsubscribed input before doing any translation work
+    if let category = inputCategory(of: nsEvent.type), !mask.contains(category) {
+        return nil
+    }
+
+    let windowID = context.windowID
     switch nsEvent.type {
     // Mouse events
     case .leftMouseDown:
-        return translateMouseDown(nsEvent, button: .left, windowID: windowID)
+        return .pointer(.buttonPressed(windowID, button: .left, position: mousePosition(nsEvent, in: context)))
     case .leftMouseUp:
-        return translateMouseUp(nsEvent, button: .left, windowID: windowID)
+        return .pointer(.buttonReleased(windowID, button: .left, position: mousePosition(nsEvent, in: context)))
     case .rightMouseDown:
-        return translateMouseDown(nsEvent, button: .right, windowID: windowID)
+        return .pointer(.buttonPressed(windowID, button: .right, position: mousePosition(nsEvent, in: context)))
     case .rightMouseUp:
-        return translateMouseUp(nsEvent, button: .right, windowID: windowID)
+        return .pointer(.buttonReleased(windowID, button: .right, position: mousePosition(nsEvent, in: context)))
     case .otherMouseDown:
-        return translateMouseDown(nsEvent, button: .middle, windowID: windowID)
+        return .pointer(.buttonPressed(windowID, button: .middle, position: mousePosition(nsEvent, in: context)))
     case .otherMouseUp:
-        return translateMouseUp(nsEvent, button: .middle, windowID: windowID)
+        return .pointer(.buttonReleased(windowID, button: .middle, position: mousePosition(nsEvent, in: context)))
     case .mouseMoved, .leftMouseDragged, .rightMouseDragged, .otherMouseDragged:
-        return translateMouseMoved(nsEvent, windowID: windowID)
+        return .pointer(.moved(windowID, position: mousePosition(nsEvent, in: context)))
     case .scrollWheel:
         return translateScrollWheel(nsEvent, windowID: windowID)
     case .mouseEntered:
@@ -57,45 +126,46 @@ internal func translateNSEvent(_ nsEvent: NSEvent, for windowID: WindowID) -> Ev
     }
 }
 
-// MARK: - Mouse Event Translation
-
-@MainActor
-private func translateMouseDown(
-    _ nsEvent: NSEvent,
-    button: MouseButton,
-    windowID: WindowID
-) -> Event? {
-    guard let position = translateMousePosition(nsEvent) else {
+/// The EventMask category of an NSEvent type, or nil for non-input events.
+internal func inputCategory(of type: NSEvent.EventType) -> EventMask? {
+    switch type {
+    case .mouseMoved, .leftMouseDragged, .rightMouseDragged, .otherMouseDragged,
+         .mouseEntered, .mouseExited:
+        return .pointerMotion
+    case .leftMouseDown, .leftMouseUp, .rightMouseDown, .rightMouseUp,
+         .otherMouseDown, .otherMouseUp:
+        return .pointerButtons
+    case .scrollWheel:
+        return .wheel
+    case .keyDown, .keyUp:
+        return .keyboard
+    default:
         return nil
     }
-
-    return .pointer(.buttonPressed(windowID, button: button, position: position))
 }
 
-@MainActor
-private func translateMouseUp(
-    _ nsEvent: NSEvent,
-    button: MouseButton,
-    windowID: WindowID
-) -> Event? {
-    guard let position = translateMousePosition(nsEvent) else {
+/// Translate the relative motion of a mouse event to `.pointer(.rawMotion)`.
+///
+/// NSEvent deltas are reported in points with sub-pixel precision and keep
+/// accumulating when the cursor is pinned at a screen edge.
+///
+/// - Parameter nsEvent: The AppKit event to translate
+/// - Returns: Raw motion event, or nil if the event carries no motion
+internal func translateRawMotion(_ nsEvent: NSEvent) -> Event? {
+    switch nsEvent.type {
+    case .mouseMoved, .leftMouseDragged, .rightMouseDragged, .otherMouseDragged:
+        let dx = Float(nsEvent.deltaX)
+        let dy = Float(nsEvent.deltaY)
+        guard dx != 0 || dy != 0 else {
+            return nil
+        }
+        return .pointer(.rawMotion(dx: dx, dy: dy))
+    default:
         return nil
     }
-
-    return .pointer(.buttonReleased(windowID, button: button, position: position))
 }
 
-@MainActor
-private func translateMouseMoved(
-    _ nsEvent: NSEvent,
-    windowID: WindowID
-) -> Event? {
-    guard let position = translateMousePosition(nsEvent) else {
-        return nil
-    }
-
-    return .pointer(.moved(windowID, position: position))
-}
+// MARK: - Mouse Event Translation
 
 private func translateScrollWheel(
     _ nsEvent: NSEvent,
@@ -115,25 +185,14 @@ private func translateScrollWheel(
 /// Translate mouse position from NSEvent to logical coordinates.
 ///
 /// AppKit uses bottom-left origin for window coordinates, but Lumina
-/// uses top-left origin. This function handles the conversion.
+/// uses top-left origin; the Y axis is flipped with the cached content
+/// height.
 @MainActor
-private func translateMousePosition(_ nsEvent: NSEvent) -> LogicalPosition? {
-    guard let window = nsEvent.window else {
-        return nil
-    }
-
-    // Get mouse location in window coordinates (bottom-left origin)
+private func mousePosition(_ nsEvent: NSEvent, in context: MacTranslationContext) -> LogicalPosition {
     let locationInWindow = nsEvent.locationInWindow
-    let windowFrame = window.frame
-
-    // Convert to top-left origin (flip Y axis)
-    let contentHeight = window.contentRect(forFrameRect: windowFrame).size.height
-    let x = locationInWindow.x
-    let y = contentHeight - locationInWindow.y
-
     return LogicalPosition(
-        x: Float(x),
-        y: Float(y)
+        x: Float(locationInWindow.x),
+        y: Float(context.contentHeight - locationInWindow.y)
     )
 }
 
@@ -194,16 +253,33 @@ private func translateModifiers(_ flags: NSEvent.ModifierFlags) -> ModifierKeys
 /// This extracts the character representation of a key press, accounting
 /// for keyboard layout and dead keys.
 internal func translateTextInput(_ nsEvent: NSEvent, windowID: WindowID) -> Event? {
-    guard let characters = nsEvent.characters, !characters.isEmpty else {
+    guard let characters = nsEvent.characters else {
+        return nil
+    }
+
+    // Typing produces one UTF-16 unit per event; the bridged string's
+    // UTF-16 view reads the NSString directly, without transcoding
+    let units = characters.utf16
+    if units.count == 1, let unit = units.first {
+        guard unit >= 0x20 && !(unit >= 0x7F && unit < 0xA0) && unit != 0x2028 && unit != 0x2029 else {
+            return nil
+        }
+        return .keyboard(.textInput(windowID, text: characters))
+    }
+    guard !units.isEmpty else {
         return nil
     }
 
-    // Filter out control characters and modifiers
-    let filteredText = characters.filter { char in
-        !char.isNewline && !char.unicodeScalars.contains { scalar in
+    // Filter out control characters and modifiers. Only build a filtered
+    // copy when something actually has to be removed.
+    let isControl: (Character) -> Bool = { char in
+        char.isNewline || char.unicodeScalars.contains { scalar in
             scalar.value < 0x20 || (scalar.value >= 0x7F && scalar.value < 0xA0)
         }
     }
+    let filteredText = characters.contains(where: isControl)
+        ? characters.filter { !isControl($0) }
+        : characters
 
     guard !filteredText.isEmpty else {
         return nil
@@ -69,7 +69,8 @@ internal struct MacMonitor {
     /// - Returns: The primary monitor
     /// - Throws: LuminaError if no primary monitor is found
     static func primaryMonitor() throws -> Monitor {
-        let monitors = try enumerateMonitors()
+        // Served from the monitor cache while an application tracks changes
+        let monitors = try Monitor.all()
         guard let primary = monitors.first(where: { $0.isPrimary }) else {
             // Fallback to first monitor if no primary flag is set
             if let first = monitors.first {
@@ -1,30 +1,441 @@
 #if os(macOS)
 import AppKit
 import Foundation
+import QuartzCore
 
-/// Window delegate to handle close events
+/// Application-wide modal loop handler, shared with every window.
+///
+/// AppKit runs live resize in its own tracking loop, so poll() gets no
+/// control back until the drag ends. Redraw drivers tick this from their
+/// display link instead, handing the handler whatever was queued.
 @MainActor
-private final class MacWindowDelegate: NSObject, NSWindowDelegate {
+internal final class MacModalLoop {
+    var handler: ModalLoopHandler?
+
+    /// Handler of an active run(handler:), which takes precedence
+    var dispatcher: EventDispatcher?
+
+    /// The application's pipeline, so ticks coalesce, route and record
+    /// like its poll()/drain() calls
+    private let pipeline: EventPipeline
+
+    /// Scratch batch handed to the handler (kept for its capacity)
+    private var events: [Event] = []
+    private var envelopes: [EventEnvelope] = []
+
+    init(pipeline: EventPipeline) {
+        self.pipeline = pipeline
+    }
+
+    /// Whether anything wants events during live resize.
+    var isActive: Bool {
+        handler != nil || dispatcher != nil
+    }
+
+    /// Deliver every queued event to the run(handler:) handler or the
+    /// modal loop handler, if either is set.
+    func tick(draining eventQueue: EventQueue<EventRingBuffer>) {
+        if let dispatcher {
+            eventQueue.drain(into: &envelopes)
+            // Whatever the handler didn't take after .exit waits for poll()
+            for envelope in dispatcher.dispatch(envelopes) {
+                pipeline.enqueue(envelope)
+            }
+            envelopes.removeAll(keepingCapacity: true)
+            return
+        }
+        guard let handler else {
+            return
+        }
+
+        _ = pipeline.drain(into: &events, maxCount: .max, transform: \.event) {
+            eventQueue.drain(into: &$0, maxCount: $1)
+        }
+        guard !events.isEmpty else {
+            return
+        }
+
+        var batch: [Event] = []
+        swap(&batch, &events)
+        handler(batch)
+        batch.removeAll(keepingCapacity: true)
+        swap(&batch, &events)
+    }
+}
+
+/// Hidden NSWindows parked for reuse, shared by the application and its
+/// windows' delegates (see `WindowPool`).
+@MainActor
+internal final class MacWindowPool {
+    private var pool = WindowPool<NSWindow>()
+
+    /// Whether a closing window may be parked. The application vetoes it
+    /// for its last window when it quits on last window close, since AppKit
+    /// only terminates once that window really closes.
+    var allowsRecycling: () -> Bool = { true }
+
+    init() {}
+
+    /// Maximum number of parked windows; lowering it closes the excess.
+    var capacity: Int {
+        get { pool.capacity }
+        set {
+            for nsWindow in pool.setCapacity(newValue) {
+                // The pool held the last reference; close() must not release it too
+                nsWindow.isReleasedWhenClosed = false
+                nsWindow.close()
+            }
+        }
+    }
+
+    /// Whether another window can be parked.
+    var hasRoom: Bool {
+        pool.hasRoom
+    }
+
+    /// Take a parked window with the given style, if any.
+    func take(resizable: Bool) -> NSWindow? {
+        pool.take(resizable: resizable)
+    }
+
+    /// Park a hidden window without a delegate.
+    ///
+    /// - Returns: false if the pool is full; the caller closes the window
+    func park(_ nsWindow: NSWindow) -> Bool {
+        pool.offer(nsWindow, resizable: nsWindow.styleMask.contains(.resizable))
+    }
+
+    /// Hide a closing window and park it, if pooling allows.
+    ///
+    /// - Returns: false if the window should close normally
+    func recycle(_ nsWindow: NSWindow) -> Bool {
+        guard pool.hasRoom, allowsRecycling() else {
+            return false
+        }
+        // Ordering out resigns key status while the delegate is still attached
+        nsWindow.orderOut(nil)
+        return park(nsWindow)
+    }
+}
+
+/// Drives `.redrawRequested` events from the window's display link.
+///
+/// The link is paused while no redraw is pending, so idle windows cost no
+/// CPU. While the application keeps requesting redraws, it fires once per
+/// refresh of the display the window is on, and every request made before
+/// a tick is answered by a single event. While the window is minimized or
+/// occluded the link stays paused; a request made meanwhile is answered on
+/// the first tick after the window is visible again.
+@MainActor
+private final class MacRedrawDriver: NSObject {
     private let windowID: WindowID
-    private let closeCallback: WindowCloseCallback?
+    private let eventQueue: EventQueue<EventRingBuffer>
+    private let modalLoop: MacModalLoop
+    private var displayLink: CADisplayLink?
+    private weak var view: NSView?
+    private var pending = false
+
+    /// Whether ticks are held back because nobody can see the window
+    var isSuspended = false {
+        didSet {
+            displayLink?.isPaused = isSuspended || !pending
+        }
+    }
+
+    init(windowID: WindowID, eventQueue: EventQueue<EventRingBuffer>, modalLoop: MacModalLoop) {
+        self.windowID = windowID
+        self.eventQueue = eventQueue
+        self.modalLoop = modalLoop
+        super.init()
+    }
+
+    /// Create the display link for `view` (paused until the first request).
+    func attach(to view: NSView) {
+        self.view = view
+        let link = view.displayLink(target: self, selector: #selector(step(_:)))
+        link.isPaused = true
+        link.add(to: .main, forMode: .common)
+        displayLink = link
+    }
+
+    func request() {
+        guard !pending else {
+            return
+        }
+        pending = true
+        if !isSuspended {
+            displayLink?.isPaused = false
+        }
+    }
+
+    /// Stop the display link (it retains its target).
+    func invalidate() {
+        displayLink?.invalidate()
+        displayLink = nil
+    }
 
-    init(windowID: WindowID, closeCallback: WindowCloseCallback?) {
+    @objc private func step(_ link: CADisplayLink) {
+        // Pause until the next request; animating apps re-arm every frame
+        link.isPaused = true
+        guard pending else {
+            return
+        }
+        pending = false
+
+        let timestamp = EventTimestamp(seconds: link.timestamp)
+        eventQueue.append(EventEnvelope(.window(.redrawRequested(windowID)), timestamp: timestamp))
+
+        // poll() can't run during live resize; hand the frame to the
+        // application's modal loop handler instead
+        if view?.inLiveResize == true {
+            modalLoop.tick(draining: eventQueue)
+        }
+        MacApplication.postWakeupEvent()
+    }
+}
+
+/// Window delegate to handle close, geometry and live resize events
+@MainActor
+private final class MacWindowDelegate: NSObject, NSWindowDelegate {
+    let windowID: WindowID
+    private let eventQueue: EventQueue<EventRingBuffer>
+    private let modalLoop: MacModalLoop
+    private let pool: MacWindowPool
+    private let closeCallback: WindowCloseCallback?
+    let redrawDriver: MacRedrawDriver
+    let translationContext: MacTranslationContext
+    let proxy: WindowProxy
+
+    /// Last reported occlusion, so repeated notifications post one event
+    private var isOccluded = false
+
+    init(
+        windowID: WindowID,
+        translationContext: MacTranslationContext,
+        proxy: WindowProxy,
+        eventQueue: EventQueue<EventRingBuffer>,
+        modalLoop: MacModalLoop,
+        pool: MacWindowPool,
+        closeCallback: WindowCloseCallback?
+    ) {
         self.windowID = windowID
+        self.translationContext = translationContext
+        self.proxy = proxy
+        self.eventQueue = eventQueue
+        self.modalLoop = modalLoop
+        self.pool = pool
         self.closeCallback = closeCallback
+        self.redrawDriver = MacRedrawDriver(windowID: windowID, eventQueue: eventQueue, modalLoop: modalLoop)
         super.init()
     }
 
     func windowShouldClose(_ sender: NSWindow) -> Bool {
+        // Park the window instead of closing it when pooling
+        return !recycle(sender)
+    }
+
+    /// Close `nsWindow` into the pool: detach this delegate and report the
+    /// close as windowWillClose would.
+    ///
+    /// - Returns: false if the pool can't take it; close the window instead
+    func recycle(_ nsWindow: NSWindow) -> Bool {
+        guard pool.recycle(nsWindow) else {
+            return false
+        }
+        redrawDriver.invalidate()
+        nsWindow.delegate = nil
+        proxy.update { $0.isVisible = false }
+        closeCallback?(windowID)
         return true
     }
 
+    /// Drop the window after a failed batch, without a close callback.
+    func discard(_ nsWindow: NSWindow) {
+        redrawDriver.invalidate()
+        nsWindow.delegate = nil
+        nsWindow.orderOut(nil)
+        proxy.update { $0.isVisible = false }
+        if !pool.park(nsWindow) {
+            nsWindow.isReleasedWhenClosed = false
+            nsWindow.close()
+        }
+    }
+
+    /// Refresh the cached geometry and the proxy's snapshot from `window`.
+    func publishState(of window: NSWindow) {
+        translationContext.update(from: window)
+        proxy.publish(Self.snapshot(of: window))
+    }
+
+    /// Current presentation state of `window`, read from AppKit.
+    static func snapshot(of window: NSWindow) -> WindowSnapshot {
+        let contentSize = window.contentRect(forFrameRect: window.frame).size
+        // AppKit counts minimized windows as not visible; Lumina as occluded
+        let isVisible = window.isVisible || window.isMiniaturized
+        return WindowSnapshot(
+            size: LogicalSize(width: Float(contentSize.width), height: Float(contentSize.height)),
+            scaleFactor: Float(window.backingScaleFactor),
+            isVisible: isVisible,
+            isOccluded: isVisible && !window.occlusionState.contains(.visible)
+        )
+    }
+
+    // Delegate callbacks run inside NSApp.sendEvent during poll()/drain(),
+    // so the queued events are picked up by the same call; no wakeup needed
+
+    func windowDidResize(_ notification: Notification) {
+        guard let window = notification.object as? NSWindow else { return }
+        publishState(of: window)
+        let contentSize = window.contentRect(forFrameRect: window.frame).size
+        let size = LogicalSize(width: Float(contentSize.width), height: Float(contentSize.height))
+        eventQueue.append(EventEnvelope(.window(.resized(windowID, size))))
+
+        // Schedule a frame so the modal loop handler sees the new size
+        if window.inLiveResize && modalLoop.isActive {
+            redrawDriver.request()
+        }
+    }
+
+    func windowDidMove(_ notification: Notification) {
+        guard let window = notification.object as? NSWindow else { return }
+        translationContext.update(from: window)
+        eventQueue.append(EventEnvelope(.window(.moved(windowID, topLeftPosition(of: window)))))
+    }
+
+    func windowWillStartLiveResize(_ notification: Notification) {
+        eventQueue.append(EventEnvelope(.window(.liveResizeStarted(windowID))))
+    }
+
+    func windowDidEndLiveResize(_ notification: Notification) {
+        eventQueue.append(EventEnvelope(.window(.liveResizeEnded(windowID))))
+    }
+
+    func windowDidBecomeKey(_ notification: Notification) {
+        eventQueue.append(EventEnvelope(.window(.focused(windowID))))
+    }
+
+    func windowDidResignKey(_ notification: Notification) {
+        eventQueue.append(EventEnvelope(.window(.unfocused(windowID))))
+    }
+
+    func windowDidChangeBackingProperties(_ notification: Notification) {
+        guard let window = notification.object as? NSWindow else { return }
+        publishState(of: window)
+
+        // Keep a Metal surface's drawable at native resolution
+        guard let layer = window.contentView?.layer as? CAMetalLayer else { return }
+        layer.contentsScale = window.backingScaleFactor
+    }
+
+    // Occlusion and miniaturization change while the application is
+    // inactive too, from notifications outside any sendEvent; wake poll()
+
+    func windowDidChangeOcclusionState(_ notification: Notification) {
+        guard let window = notification.object as? NSWindow else { return }
+        publishState(of: window)
+        let occluded = !window.occlusionState.contains(.visible)
+        redrawDriver.isSuspended = occluded || window.isMiniaturized
+        guard occluded != isOccluded else { return }
+        isOccluded = occluded
+        eventQueue.append(EventEnvelope(.window(.occlusionChanged(windowID, isOccluded: occluded))))
+        MacApplication.postWakeupEvent()
+    }
+
+    func windowDidMiniaturize(_ notification: Notification) {
+        guard let window = notification.object as? NSWindow else { return }
+        publishState(of: window)
+        redrawDriver.isSuspended = true
+        eventQueue.append(EventEnvelope(.window(.minimized(windowID))))
+        MacApplication.postWakeupEvent()
+    }
+
+    func windowDidDeminiaturize(_ notification: Notification) {
+        guard let window = notification.object as? NSWindow else { return }
+        publishState(of: window)
+        redrawDriver.isSuspended = !window.occlusionState.contains(.visible)
+        eventQueue.append(EventEnvelope(.window(.restored(windowID))))
+        MacApplication.postWakeupEvent()
+    }
+
     func windowWillClose(_ notification: Notification) {
+        redrawDriver.invalidate()
+        proxy.update { $0.isVisible = false }
+
         // Notify the application that this window is closing
         // This will unregister the window from the app's registry
         closeCallback?(windowID)
     }
 }
 
+/// userInfo key marking the tracking area installed by `setPointerTracking`
+private let pointerTrackingKey = "LuminaPointerTracking"
+
+/// Enable or disable mouse-moved and enter/exit events for a window.
+///
+/// NSWindow only generates `.mouseMoved` with `acceptsMouseMovedEvents`,
+/// and `.mouseEntered`/`.mouseExited` for a tracking area on the content
+/// view. Both are torn down when pointer motion is masked out, so AppKit
+/// stops producing events nobody reads.
+@MainActor
+internal func setPointerTracking(_ enabled: Bool, for nsWindow: NSWindow) {
+    nsWindow.acceptsMouseMovedEvents = enabled
+
+    guard let contentView = nsWindow.contentView else {
+        return
+    }
+    let existing = contentView.trackingAreas.first { $0.userInfo?[pointerTrackingKey] != nil }
+
+    if enabled, existing == nil {
+        let area = NSTrackingArea(
+            rect: .zero,
+            options: [.mouseEnteredAndExited, .mouseMoved, .activeInKeyWindow, .inVisibleRect],
+            owner: contentView,
+            userInfo: [pointerTrackingKey: true]
+        )
+        contentView.addTrackingArea(area)
+    } else if !enabled, let existing {
+        contentView.removeTrackingArea(existing)
+    }
+}
+
+/// Screen new windows for one monitor are placed on.
+///
+/// Resolved once per monitor by `createWindows(_:)` rather than per window.
+@MainActor
+internal struct MacWindowPlacement {
+    /// Target screen, or nil to center on the main screen
+    let screen: NSScreen?
+
+    /// Resolve the placement for `monitor` (nil: centered on screen).
+    init(monitor: Monitor?) {
+        guard let monitor else {
+            screen = nil
+            return
+        }
+        // Match based on screen frame position
+        let monitorPhysical = monitor.physicalPosition
+        screen = NSScreen.screens.first { screen in
+            let screenFrame = screen.frame
+            return Int(screenFrame.origin.x) == monitorPhysical.x &&
+                   Int(screenFrame.origin.y) == monitorPhysical.y
+        } ?? NSScreen.main
+    }
+
+    /// Move `nsWindow` to its initial position.
+    func position(_ nsWindow: NSWindow) {
+        guard let screen else {
+            nsWindow.center()  // Center on screen initially
+            return
+        }
+        // Position window on the target screen (offset from screen's origin)
+        let screenFrame = screen.frame
+        let windowFrame = nsWindow.frame
+        let x = screenFrame.origin.x + 100
+        let y = screenFrame.origin.y + screenFrame.height - windowFrame.height - 100
+        nsWindow.setFrameOrigin(NSPoint(x: x, y: y))
+    }
+}
+
 /// macOS implementation of PlatformWindow using NSWindow.
 ///
 /// This implementation wraps NSWindow and provides Lumina's cross-platform
@@ -37,34 +448,110 @@ internal struct MacWindow: LuminaWindow {
     private var nsWindow: NSWindow
     private var delegate: MacWindowDelegate
 
+    /// Whether the NSWindow still belongs to this window.
+    ///
+    /// A closed window's NSWindow may be parked and handed to a later
+    /// window, so a stale copy of this value must not reach it: every
+    /// method checks the attached delegate and is a no-op once the NSWindow
+    /// changed owner.
+    private var isLive: Bool {
+        (nsWindow.delegate as? MacWindowDelegate)?.windowID == id
+    }
+
     /// Expose the NSWindow's window number for event routing.
     internal var windowNumber: Int {
         nsWindow.windowNumber
     }
 
+    /// Cached geometry used to translate this window's input.
+    internal var translationContext: MacTranslationContext {
+        delegate.translationContext
+    }
+
+    /// Turn mouse-moved event generation for this window on or off.
+    internal func setTracksPointerMotion(_ enabled: Bool) {
+        guard isLive else { return }
+        setPointerTracking(enabled, for: nsWindow)
+    }
+
     /// Create a new macOS window.
     ///
+    /// Takes a parked window from the pool when one with the same style is
+    /// available, otherwise creates a new NSWindow.
+    ///
     /// - Parameters:
-    ///   - title: Window title
-    ///   - size: Initial logical size
-    ///   - resizable: Whether the window can be resized by the user
-    ///   - monitor: Optional monitor to create the window on (uses primary if nil)
+    ///   - id: Identifier allocated by the application's window registry
+    ///   - descriptor: Title, size, style and monitor of the window
+    ///   - placement: Target screen, resolved once per monitor
+    ///   - eventQueue: Queue receiving the window's delegate and redraw events
+    ///   - modalLoop: Application's live resize handler
+    ///   - pool: Application's window pool
     ///   - closeCallback: Optional callback to invoke when the window closes
     /// - Returns: Result containing MacWindow or LuminaError
     internal static func create(
-        title: String,
-        size: LogicalSize,
-        resizable: Bool,
-        monitor: Monitor? = nil,
+        id windowID: WindowID,
+        descriptor: WindowDescriptor,
+        placement: MacWindowPlacement,
+        eventQueue: EventQueue<EventRingBuffer>,
+        modalLoop: MacModalLoop,
+        pool: MacWindowPool,
         closeCallback: WindowCloseCallback? = nil
     ) -> Result<MacWindow, LuminaError> {
-        // Create content rect for the window
-        let contentRect = NSRect(
-            x: 0,
-            y: 0,
-            width: CGFloat(size.width),
-            height: CGFloat(size.height)
+        let contentSize = NSSize(
+            width: CGFloat(descriptor.size.width),
+            height: CGFloat(descriptor.size.height)
+        )
+
+        let nsWindow: NSWindow
+        if let pooled = pool.take(resizable: descriptor.resizable) {
+            // Undo what the previous owner may have changed
+            nsWindow = pooled
+            nsWindow.setContentSize(contentSize)
+            nsWindow.contentMinSize = NSSize(width: 0, height: 0)
+            nsWindow.contentMaxSize = NSSize(
+                width: CGFloat.greatestFiniteMagnitude,
+                height: CGFloat.greatestFiniteMagnitude
+            )
+            // A Metal surface of the previous owner would keep showing its last frame
+            if nsWindow.contentView?.layer is CAMetalLayer {
+                nsWindow.contentView = NSView(frame: NSRect(origin: .zero, size: contentSize))
+            }
+        } else {
+            nsWindow = makeNSWindow(contentSize: contentSize, resizable: descriptor.resizable)
+        }
+
+        nsWindow.title = descriptor.title
+        placement.position(nsWindow)
+
+        // Create and set delegate to handle close events
+        let delegate = MacWindowDelegate(
+            windowID: windowID,
+            translationContext: MacTranslationContext(windowID: windowID, window: nsWindow),
+            proxy: WindowProxy(id: windowID, snapshot: MacWindowDelegate.snapshot(of: nsWindow)),
+            eventQueue: eventQueue,
+            modalLoop: modalLoop,
+            pool: pool,
+            closeCallback: closeCallback
         )
+        nsWindow.delegate = delegate
+
+        // Redraws are paced by the content view's display link
+        if let contentView = nsWindow.contentView {
+            delegate.redrawDriver.attach(to: contentView)
+        }
+
+        // Create window wrapper
+        let macWindow = MacWindow(id: windowID, nsWindow: nsWindow, delegate: delegate)
+
+        return .success(macWindow)
+    }
+
+    /// Create a hidden NSWindow without a delegate.
+    ///
+    /// Also used to pre-warm the window pool.
+    internal static func makeNSWindow(contentSize: NSSize, resizable: Bool) -> NSWindow {
+        // Create content rect for the window
+        let contentRect = NSRect(origin: .zero, size: contentSize)
 
         // Configure window style mask
         var styleMask: NSWindow.StyleMask = [
@@ -85,74 +572,49 @@ internal struct MacWindow: LuminaWindow {
             defer: false
         )
 
-        nsWindow.title = title
-
-        // Position the window based on monitor parameter or center it
-        if let monitor = monitor {
-            // Position window on the specified monitor
-            let targetScreen = NSScreen.screens.first { screen in
-                // Match based on screen frame position
-                let screenFrame = screen.frame
-                let monitorPhysical = monitor.physicalPosition
-                return Int(screenFrame.origin.x) == monitorPhysical.x &&
-                       Int(screenFrame.origin.y) == monitorPhysical.y
-            } ?? NSScreen.main
-
-            if let screen = targetScreen {
-                // Position window on the target screen (offset from screen's origin)
-                let screenFrame = screen.frame
-                let windowFrame = nsWindow.frame
-                let x = screenFrame.origin.x + 100
-                let y = screenFrame.origin.y + screenFrame.height - windowFrame.height - 100
-                nsWindow.setFrameOrigin(NSPoint(x: x, y: y))
-            } else {
-                nsWindow.center()
-            }
-        } else {
-            nsWindow.center()  // Center on screen initially
-        }
-
         // Enable automatic background color (system-appropriate)
         nsWindow.backgroundColor = .windowBackgroundColor
 
-        // Create window ID first (needed for delegate)
-        let windowID = WindowID()
-
-        // Create and set delegate to handle close events
-        let delegate = MacWindowDelegate(windowID: windowID, closeCallback: closeCallback)
-        nsWindow.delegate = delegate
-
-        // Create window wrapper
-        let macWindow = MacWindow(id: windowID, nsWindow: nsWindow, delegate: delegate)
+        return nsWindow
+    }
 
-        return .success(macWindow)
+    /// Drop this window after a failed batch (see `MacWindowDelegate.discard`).
+    internal func discard() {
+        guard isLive else { return }
+        delegate.discard(nsWindow)
     }
 
     mutating func show() {
+        guard isLive else { return }
         nsWindow.makeKeyAndOrderFront(nil)
+        delegate.publishState(of: nsWindow)
     }
 
     mutating func hide() {
+        guard isLive else { return }
         nsWindow.orderOut(nil)
+        delegate.publishState(of: nsWindow)
     }
 
     consuming func close() {
-        nsWindow.close()
+        guard isLive else { return }
+        if !delegate.recycle(nsWindow) {
+            nsWindow.close()
+        }
     }
 
     mutating func setTitle(_ title: String) {
+        guard isLive else { return }
         nsWindow.title = title
     }
 
     func size() -> LogicalSize {
-        let contentSize = nsWindow.contentRect(forFrameRect: nsWindow.frame).size
-        return LogicalSize(
-            width: Float(contentSize.width),
-            height: Float(contentSize.height)
-        )
+        // Kept current by windowDidResize, which AppKit sends synchronously
+        delegate.proxy.size
     }
 
     mutating func resize(_ size: LogicalSize) {
+        guard isLive else { return }
         let currentFrame = nsWindow.frame
         let currentContentRect = nsWindow.contentRect(forFrameRect: currentFrame)
 
@@ -172,27 +634,12 @@ internal struct MacWindow: LuminaWindow {
     }
 
     func position() -> LogicalPosition {
-        // AppKit uses bottom-left origin, Lumina uses top-left
-        // Convert from AppKit screen coordinates to top-left origin
-
-        let frame = nsWindow.frame
-        let screen = nsWindow.screen ?? NSScreen.main!
-        let screenFrame = screen.frame
-
-        // Get top-left corner in AppKit coordinates
-        let topLeftY = frame.origin.y + frame.size.height
-
-        // Convert to top-left origin coordinate system
-        let x = frame.origin.x
-        let y = screenFrame.size.height - topLeftY
-
-        return LogicalPosition(
-            x: Float(x),
-            y: Float(y)
-        )
+        guard isLive else { return LogicalPosition(x: 0, y: 0) }
+        topLeftPosition(of: nsWindow)
     }
 
     mutating func moveTo(_ position: LogicalPosition) {
+        guard isLive else { return }
         // Convert from Lumina's top-left origin to AppKit's bottom-left origin
 
         let screen = nsWindow.screen ?? NSScreen.main!
@@ -212,6 +659,7 @@ internal struct MacWindow: LuminaWindow {
     }
 
     mutating func setMinSize(_ size: LogicalSize?) {
+        guard isLive else { return }
         if let size = size {
             nsWindow.contentMinSize = NSSize(
                 width: CGFloat(size.width),
@@ -224,6 +672,7 @@ internal struct MacWindow: LuminaWindow {
     }
 
     mutating func setMaxSize(_ size: LogicalSize?) {
+        guard isLive else { return }
         if let size = size {
             nsWindow.contentMaxSize = NSSize(
                 width: CGFloat(size.width),
@@ -239,12 +688,78 @@ internal struct MacWindow: LuminaWindow {
     }
 
     mutating func requestFocus() {
+        guard isLive else { return }
         nsWindow.makeKeyAndOrderFront(nil)
     }
 
     func scaleFactor() -> Float {
-        Float(nsWindow.backingScaleFactor)
+        delegate.translationContext.scaleFactor
+    }
+
+    func proxy() -> WindowProxy {
+        delegate.proxy
+    }
+
+    func requestRedraw() {
+        guard isLive else { return }
+        delegate.redrawDriver.request()
     }
+
+    func rawWindowHandle() -> RawWindowHandle {
+        guard isLive else { return .unavailable }
+        return .appKit(
+            window: Unmanaged.passUnretained(nsWindow).toOpaque(),
+            view: nsWindow.contentView.map { Unmanaged.passUnretained($0).toOpaque() }
+        )
+    }
+
+    mutating func surface() -> Result<NativeSurface, LuminaError> {
+        guard isLive else {
+            return .failure(.invalidState("Window is closed"))
+        }
+        guard let contentView = nsWindow.contentView else {
+            return .failure(.invalidState("Window has no content view"))
+        }
+
+        let layer: CAMetalLayer
+        if let existing = contentView.layer as? CAMetalLayer {
+            layer = existing
+        } else {
+            // Layer-hosting: setting the layer before wantsLayer keeps AppKit
+            // from drawing into the view, so the layer is its only content
+            layer = CAMetalLayer()
+            contentView.layer = layer
+            contentView.wantsLayer = true
+            contentView.layerContentsRedrawPolicy = .never
+        }
+        layer.contentsScale = nsWindow.backingScaleFactor
+        return .success(.metalLayer(Unmanaged.passUnretained(layer).toOpaque()))
+    }
+}
+
+// MARK: - Coordinate Conversion
+
+/// Position of a window's top-left corner in Lumina screen coordinates.
+@MainActor
+private func topLeftPosition(of nsWindow: NSWindow) -> LogicalPosition {
+    // AppKit uses bottom-left origin, Lumina uses top-left
+    // Convert from AppKit screen coordinates to top-left origin
+
+    let frame = nsWindow.frame
+    let screen = nsWindow.screen ?? NSScreen.main!
+    let screenFrame = screen.frame
+
+    // Get top-left corner in AppKit coordinates
+    let topLeftY = frame.origin.y + frame.size.height
+
+    // Convert to top-left origin coordinate system
+    let x = frame.origin.x
+    let y = screenFrame.size.height - topLeftY
+
+    return LogicalPosition(
+        x: Float(x),
+        y: Float(y)
+    )
 }
 
 // MARK: - Sendable Conformance
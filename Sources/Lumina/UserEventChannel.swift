@@ -0,0 +1,139 @@
+import Synchronization
+
+/// Lock-free multi-producer/single-consumer channel for user events.
+///
+/// Producers push onto an atomic intrusive stack with a single
+/// compare-and-swap; they never take a lock or allocate beyond their node.
+/// The consumer detaches the whole stack with one atomic exchange and
+/// reverses it into FIFO order, so draining N events costs one atomic
+/// operation rather than N lock round-trips.
+///
+/// Wakeup coalescing: `send(_:)` reports whether the caller must wake the
+/// event loop. Only the first send after the consumer last collected the
+/// stack returns `true`, so a burst of 10k posts produces a single wakeup
+/// (one dummy NSEvent or one `PostThreadMessageW`) instead of 10k.
+///
+/// Thread Safety: `send(_:)` may be called from any thread. All other
+/// methods are consumer-side and must only be called from the thread that
+/// runs the event loop (the main thread).
+internal final class UserEventChannel<Element>: @unchecked Sendable {
+    private final class Node {
+        let value: Element
+        var next: UnsafeMutableRawPointer?
+
+        init(_ value: Element) {
+            self.value = value
+        }
+    }
+
+    /// Top of the producer stack (most recently sent element first)
+    private let head = Atomic<UnsafeMutableRawPointer?>(nil)
+
+    /// Set by the first send after a collect; cleared by the consumer
+    private let wakeupPending = Atomic<Bool>(false)
+
+    /// Consumer-owned FIFO holding collected elements not yet handed out
+    private var pending = RingBuffer<Element>()
+
+    init() {}
+
+    deinit {
+        var node = head.exchange(nil, ordering: .acquiring)
+        while let current = node {
+            let unmanaged = Unmanaged<Node>.fromOpaque(current)
+            node = unmanaged.takeUnretainedValue().next
+            unmanaged.release()
+        }
+    }
+
+    // MARK: - Producer Side
+
+    /// Send an element to the consumer (thread-safe, lock-free).
+    ///
+    /// - Parameter element: The element to enqueue
+    /// - Returns: `true` if the caller must wake the consumer; `false` if a
+    ///   wakeup is already pending
+    func send(_ element: Element) -> Bool {
+        let node = Unmanaged.passRetained(Node(element))
+        let pointer = node.toOpaque()
+
+        var current = head.load(ordering: .relaxed)
+        while true {
+            node.takeUnretainedValue().next = current
+            let (exchanged, original) = head.compareExchange(
+                expected: current,
+                desired: pointer,
+                successOrdering: .sequentiallyConsistent,
+                failureOrdering: .relaxed
+            )
+            if exchanged {
+                break
+            }
+            current = original
+        }
+
+        // Only the first send after a collect needs to wake the consumer
+        return !wakeupPending.exchange(true, ordering: .sequentiallyConsistent)
+    }
+
+    // MARK: - Consumer Side
+
+    /// Whether no elements are buffered or in flight.
+    var isEmpty: Bool {
+        pending.isEmpty && head.load(ordering: .acquiring) == nil
+    }
+
+    /// Remove and return the oldest element, or nil if the channel is empty.
+    func popFirst() -> Element? {
+        if pending.isEmpty {
+            collect()
+        }
+        return pending.popFirst()
+    }
+
+    /// Move up to `maxCount` elements, oldest first, onto the end of `array`,
+    /// converting each one with `transform`.
+    ///
+    /// - Returns: Number of elements moved
+    @discardableResult
+    func drain<T>(
+        into array: inout [T],
+        maxCount: Int = .max,
+        transform: (Element) -> T
+    ) -> Int {
+        collect()
+        return pending.drain(into: &array, maxCount: maxCount, transform: transform)
+    }
+
+    /// Discard every buffered and in-flight element.
+    ///
+    /// - Returns: Number of elements discarded
+    @discardableResult
+    func removeAll() -> Int {
+        collect()
+        let discarded = pending.count
+        pending.removeAll()
+        return discarded
+    }
+
+    /// Detach the producer stack and append it to `pending` in FIFO order.
+    private func collect() {
+        // Clear the flag before detaching so a concurrent send either lands in
+        // this batch or observes `false` and issues a fresh wakeup
+        wakeupPending.store(false, ordering: .sequentiallyConsistent)
+
+        var node = head.exchange(nil, ordering: .sequentiallyConsistent)
+        guard node != nil else {
+            return
+        }
+
+        // The stack is newest-first; reverse it while taking back ownership
+        var batch: [Element] = []
+        while let current = node {
+            let detached = Unmanaged<Node>.fromOpaque(current).takeRetainedValue()
+            batch.append(detached.value)
+            node = detached.next
+        }
+        pending.append(contentsOf: batch.reversed())
+    }
+}
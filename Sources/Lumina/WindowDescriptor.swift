@@ -0,0 +1,44 @@
+/// Parameters of a window to create.
+///
+/// Used by `LuminaApp.createWindows(_:)` to create many windows in one
+/// call, and by `createWindow(_:)` for a single one.
+///
+/// Example:
+/// ```swift
+/// let palettes = (0..<8).map { index in
+///     WindowDescriptor(title: "Palette \(index)", size: LogicalSize(width: 240, height: 320))
+/// }
+/// let windows = try app.createWindows(palettes).get()
+/// ```
+public struct WindowDescriptor: Sendable {
+    /// Window title
+    public var title: String
+
+    /// Initial content size in logical pixels
+    public var size: LogicalSize
+
+    /// Whether the window can be resized by the user
+    public var resizable: Bool
+
+    /// Monitor to place the window on (nil: the primary monitor)
+    public var monitor: Monitor?
+
+    /// Describe a window.
+    ///
+    /// - Parameters:
+    ///   - title: Window title
+    ///   - size: Initial content size in logical pixels
+    ///   - resizable: Whether the window can be resized by the user
+    ///   - monitor: Monitor to place the window on (nil: the primary monitor)
+    public init(
+        title: String,
+        size: LogicalSize,
+        resizable: Bool = true,
+        monitor: Monitor? = nil
+    ) {
+        self.title = title
+        self.size = size
+        self.resizable = resizable
+        self.monitor = monitor
+    }
+}
@@ -1,4 +1,4 @@
-import Foundation
+import Synchronization
 
 /// Unique identifier for a window.
 ///
@@ -9,6 +9,12 @@ import Foundation
 /// WindowID is used throughout the event system to track which window
 /// generated or should handle a specific event.
 ///
+/// Internally a WindowID is a generational index: a slot number in the
+/// platform's window table plus a generation counter that is bumped each
+/// time the slot is reused. This keeps the identifier to 8 bytes, makes
+/// per-window lookups a plain array access, and still guarantees that an
+/// ID held after its window closed never resolves to a newer window.
+///
 /// Example:
 /// ```swift
 /// let window1 = try Window.create(title: "Window 1", size: LogicalSize(width: 800, height: 600)).get()
@@ -25,30 +31,55 @@ import Foundation
 /// }
 /// ```
 public struct WindowID: Identifiable, Sendable, Hashable {
+    /// Packed identifier: generation in the high 32 bits, slot index in the low 32 bits
+    public let rawValue: UInt64
+
     /// The unique identifier value
-    public let id: UUID
+    public var id: UInt64 {
+        rawValue
+    }
 
     /// Create a new unique window identifier.
     ///
-    /// Each call to this initializer generates a new, globally unique ID.
-    /// This is typically called internally by the window creation system.
+    /// Identifiers created this way are not backed by a window table slot
+    /// (generation 0), so they never compare equal to the ID of a real
+    /// window. Windows receive their IDs from the platform's registry.
     public init() {
-        self.id = UUID()
+        let index = detachedIndexCounter.wrappingAdd(1, ordering: .relaxed).newValue
+        self.init(index: index, generation: 0)
     }
 
-    /// Create a window identifier from an existing UUID.
+    /// Create a window identifier from its raw value.
     ///
     /// This initializer is primarily used for testing or when deserializing
     /// window identifiers from persistent storage.
     ///
-    /// - Parameter id: The UUID to use as the identifier
-    public init(id: UUID) {
-        self.id = id
+    /// - Parameter rawValue: A value previously read from `rawValue`
+    public init(rawValue: UInt64) {
+        self.rawValue = rawValue
+    }
+
+    /// Create a window identifier for a window table slot.
+    internal init(index: UInt32, generation: UInt32) {
+        self.rawValue = UInt64(generation) << 32 | UInt64(index)
+    }
+
+    /// Slot number in the window table
+    internal var index: UInt32 {
+        UInt32(truncatingIfNeeded: rawValue)
+    }
+
+    /// Reuse counter of the slot (0 for identifiers not backed by a slot)
+    internal var generation: UInt32 {
+        UInt32(truncatingIfNeeded: rawValue >> 32)
     }
 }
 
+/// Source of slot numbers for `WindowID()`.
+private let detachedIndexCounter = Atomic<UInt32>(0)
+
 extension WindowID: CustomStringConvertible {
     public var description: String {
-        "WindowID(\(id.uuidString.prefix(8))...)"
+        "WindowID(\(index)v\(generation))"
     }
 }
@@ -0,0 +1,69 @@
+/// Hidden native windows kept for reuse by `createWindow`.
+///
+/// Creating a native window (CreateWindowExW, NSWindow's initializer) is
+/// by far the most expensive part of `createWindow`. With a non-zero
+/// `capacity`, backends park closed windows here instead of destroying
+/// them and hand them out again, re-titled and re-sized, to later
+/// requests with the same style.
+///
+/// The pool is LIFO, so the most recently used (warmest) window is reused
+/// first, and evicts its oldest entries when the capacity shrinks.
+internal struct WindowPool<Handle> {
+    private struct Entry {
+        var handle: Handle
+        var resizable: Bool
+    }
+
+    private var entries: [Entry] = []
+
+    /// Maximum number of parked windows (0 disables pooling)
+    private(set) var capacity = 0
+
+    init() {}
+
+    /// Number of parked windows.
+    var count: Int {
+        entries.count
+    }
+
+    var isEmpty: Bool {
+        entries.isEmpty
+    }
+
+    /// Whether another window can be parked.
+    var hasRoom: Bool {
+        entries.count < capacity
+    }
+
+    /// Change the capacity.
+    ///
+    /// - Returns: Windows evicted by a smaller capacity; the caller destroys them
+    mutating func setCapacity(_ newCapacity: Int) -> [Handle] {
+        capacity = max(0, newCapacity)
+        guard entries.count > capacity else {
+            return []
+        }
+        let evicted = entries.prefix(entries.count - capacity).map(\.handle)
+        entries.removeFirst(entries.count - capacity)
+        return evicted
+    }
+
+    /// Park a hidden window.
+    ///
+    /// - Returns: false if the pool is full; the caller destroys the window
+    mutating func offer(_ handle: Handle, resizable: Bool) -> Bool {
+        guard hasRoom else {
+            return false
+        }
+        entries.append(Entry(handle: handle, resizable: resizable))
+        return true
+    }
+
+    /// Take the most recently parked window with the given style.
+    mutating func take(resizable: Bool) -> Handle? {
+        guard let index = entries.lastIndex(where: { $0.resizable == resizable }) else {
+            return nil
+        }
+        return entries.remove(at: index).handle
+    }
+}
@@ -0,0 +1,199 @@
+import Synchronization
+
+/// Presentation state of a window at one point in time.
+///
+/// Read through `WindowProxy` from any thread; the backend publishes a
+/// new snapshot whenever one of the values changes.
+public struct WindowSnapshot: Sendable, Hashable {
+    /// Client area size in logical points.
+    public var size: LogicalSize
+
+    /// Client area size in pixels, the size a swapchain should match.
+    public var physicalSize: PhysicalSize
+
+    /// Ratio of physical pixels to logical points.
+    public var scaleFactor: Float
+
+    /// Whether the window is shown.
+    public var isVisible: Bool
+
+    /// Whether the window is shown but entirely hidden from the user
+    /// (covered, minimized or on another space).
+    public var isOccluded: Bool
+
+    public init(
+        size: LogicalSize,
+        physicalSize: PhysicalSize,
+        scaleFactor: Float,
+        isVisible: Bool = false,
+        isOccluded: Bool = false
+    ) {
+        self.size = size
+        self.physicalSize = physicalSize
+        self.scaleFactor = scaleFactor
+        self.isVisible = isVisible
+        self.isOccluded = isOccluded
+    }
+
+    /// Snapshot of a window of `size`, deriving the physical size.
+    public init(size: LogicalSize, scaleFactor: Float, isVisible: Bool = false, isOccluded: Bool = false) {
+        self.init(
+            size: size,
+            physicalSize: size.toPhysical(scaleFactor: scaleFactor),
+            scaleFactor: scaleFactor,
+            isVisible: isVisible,
+            isOccluded: isOccluded
+        )
+    }
+}
+
+/// Thread-safe view of a window's size, scale and visibility.
+///
+/// `LuminaWindow` is main-actor bound, so a render thread can neither call
+/// `size()` nor wait for the main thread every frame. A proxy is the
+/// window's state published for such readers: the backend stores a new
+/// `WindowSnapshot` on the main thread whenever the window resizes,
+/// changes scale or is shown and hidden, and `snapshot()` reads it from
+/// any thread without locks or thread hops.
+///
+/// ```swift
+/// let proxy = window.proxy()
+/// renderQueue.async {
+///     let state = proxy.snapshot()
+///     if state.physicalSize != swapchainSize { resizeSwapchain(state.physicalSize) }
+/// }
+/// ```
+///
+/// The values trail the main thread by at most one event: a render thread
+/// sees the new size as soon as the backend has handled the resize, before
+/// the application polls the `.resized` event. After the window closes,
+/// the proxy keeps its last snapshot with `isVisible` false.
+///
+/// Thread Safety: `snapshot()` and the accessors may be called from any
+/// thread. Only the backend writes, from the thread running the event
+/// loop; `publish` and `update` assume that single writer.
+public final class WindowProxy: Sendable {
+    /// The window this proxy describes.
+    public let id: WindowID
+
+    // Sequence lock: the writer makes `sequence` odd while it stores the
+    // fields and even again afterwards, readers retry when the sequence
+    // was odd or moved during their read. Each field packs two 32-bit
+    // values so a snapshot is three words.
+    private let sequence = Atomic<UInt64>(0)
+    private let logicalBits = Atomic<UInt64>(0)
+    private let physicalBits = Atomic<UInt64>(0)
+    private let scaleBits = Atomic<UInt64>(0)
+
+    private static let visibleFlag: UInt64 = 1 << 32
+    private static let occludedFlag: UInt64 = 1 << 33
+
+    init(id: WindowID, snapshot: WindowSnapshot) {
+        self.id = id
+        store(snapshot)
+    }
+
+    /// The latest published state.
+    public func snapshot() -> WindowSnapshot {
+        while true {
+            let before = sequence.load(ordering: .acquiring)
+            if before & 1 == 0 {
+                let logical = logicalBits.load(ordering: .relaxed)
+                let physical = physicalBits.load(ordering: .relaxed)
+                let scale = scaleBits.load(ordering: .relaxed)
+                atomicMemoryFence(ordering: .acquiring)
+                if sequence.load(ordering: .relaxed) == before {
+                    return Self.unpack(logical: logical, physical: physical, scale: scale)
+                }
+            }
+            // The writer is between its first and last store, a handful of
+            // instructions on the main thread; try again.
+        }
+    }
+
+    /// Client area size in logical points.
+    public var size: LogicalSize {
+        snapshot().size
+    }
+
+    /// Client area size in pixels.
+    public var physicalSize: PhysicalSize {
+        snapshot().physicalSize
+    }
+
+    /// Ratio of physical pixels to logical points.
+    public var scaleFactor: Float {
+        snapshot().scaleFactor
+    }
+
+    /// Whether the window is shown.
+    public var isVisible: Bool {
+        snapshot().isVisible
+    }
+
+    /// Whether the window is shown but hidden from the user.
+    public var isOccluded: Bool {
+        snapshot().isOccluded
+    }
+
+    // MARK: - Publishing
+
+    /// Publish `snapshot` if it differs from the current one.
+    func publish(_ snapshot: WindowSnapshot) {
+        guard snapshot != self.snapshot() else {
+            return
+        }
+        store(snapshot)
+    }
+
+    /// Change some values of the current snapshot and publish the result.
+    func update(_ body: (inout WindowSnapshot) -> Void) {
+        var snapshot = snapshot()
+        body(&snapshot)
+        publish(snapshot)
+    }
+
+    /// Write all fields under the sequence lock (single writer).
+    private func store(_ snapshot: WindowSnapshot) {
+        let (logical, physical, scale) = Self.pack(snapshot)
+        let start = sequence.load(ordering: .relaxed)
+        sequence.store(start &+ 1, ordering: .relaxed)
+        atomicMemoryFence(ordering: .releasing)
+        logicalBits.store(logical, ordering: .relaxed)
+        physicalBits.store(physical, ordering: .relaxed)
+        scaleBits.store(scale, ordering: .relaxed)
+        sequence.store(start &+ 2, ordering: .releasing)
+    }
+
+    // MARK: - Packing
+
+    static func pack(_ snapshot: WindowSnapshot) -> (logical: UInt64, physical: UInt64, scale: UInt64) {
+        let logical = UInt64(snapshot.size.width.bitPattern) | UInt64(snapshot.size.height.bitPattern) << 32
+        let physical = UInt64(UInt32(clamping: max(snapshot.physicalSize.width, 0)))
+            | UInt64(UInt32(clamping: max(snapshot.physicalSize.height, 0))) << 32
+        var scale = UInt64(snapshot.scaleFactor.bitPattern)
+        if snapshot.isVisible {
+            scale |= visibleFlag
+        }
+        if snapshot.isOccluded {
+            scale |= occludedFlag
+        }
+        return (logical, physical, scale)
+    }
+
+    static func unpack(logical: UInt64, physical: UInt64, scale: UInt64) -> WindowSnapshot {
+        WindowSnapshot(
+            size: LogicalSize(
+                width: Float(bitPattern: UInt32(truncatingIfNeeded: logical)),
+                height: Float(bitPattern: UInt32(truncatingIfNeeded: logical >> 32))
+            ),
+            physicalSize: PhysicalSize(
+                width: Int(UInt32(truncatingIfNeeded: physical)),
+                height: Int(UInt32(truncatingIfNeeded: physical >> 32))
+            ),
+            scaleFactor: Float(bitPattern: UInt32(truncatingIfNeeded: scale)),
+            isVisible: scale & visibleFlag != 0,
+            isOccluded: scale & occludedFlag != 0
+        )
+    }
+}
@@ -1,28 +1,161 @@
+/// Slab of per-window values addressed by generational WindowIDs.
+///
+/// Each live window occupies one slot; the WindowID encodes the slot index
+/// and the slot's generation at insertion time. Lookups are an array access
+/// plus a generation compare, with no hashing. Freed slots are reused LIFO
+/// with a bumped generation, so stale IDs miss instead of aliasing a new
+/// window.
+///
+/// Thread Safety: Not synchronized. Owners provide their own isolation.
+internal struct WindowSlab<Value> {
+    private struct Slot {
+        /// Generation of the current (or next) occupant; never 0
+        var generation: UInt32
+        var value: Value?
+    }
+
+    private var slots: [Slot] = []
+    private var freeSlots: [UInt32] = []
+
+    /// Number of occupied slots
+    private(set) var count = 0
+
+    init() {}
+
+    /// Whether no slots are occupied.
+    var isEmpty: Bool {
+        count == 0
+    }
+
+    /// Store a value in a free slot.
+    ///
+    /// - Parameter value: Per-window value to store
+    /// - Returns: ID addressing the new slot occupant
+    mutating func insert(_ value: Value) -> WindowID {
+        insert { _ in value }
+    }
+
+    /// Store a value that needs to know its own ID.
+    ///
+    /// - Parameter makeValue: Builds the value from the ID it will be stored under
+    /// - Returns: ID addressing the new slot occupant
+    mutating func insert(_ makeValue: (WindowID) -> Value) -> WindowID {
+        count += 1
+        if let index = freeSlots.popLast() {
+            let id = WindowID(index: index, generation: slots[Int(index)].generation)
+            slots[Int(index)].value = makeValue(id)
+            return id
+        }
+
+        let id = WindowID(index: UInt32(slots.count), generation: 1)
+        slots.append(Slot(generation: 1, value: makeValue(id)))
+        return id
+    }
+
+    /// Free the slot addressed by `id`.
+    ///
+    /// - Parameter id: ID returned by `insert`
+    /// - Returns: The removed value, or nil if `id` is stale or unknown
+    @discardableResult
+    mutating func remove(_ id: WindowID) -> Value? {
+        guard let index = liveIndex(of: id) else {
+            return nil
+        }
+
+        let value = slots[index].value
+        slots[index].value = nil
+        // Generation 0 is reserved for IDs not backed by a slot
+        let next = slots[index].generation &+ 1
+        slots[index].generation = next == 0 ? 1 : next
+        freeSlots.append(UInt32(index))
+        count -= 1
+        return value
+    }
+
+    /// Access the value for `id`.
+    ///
+    /// Reading a stale or unknown ID yields nil; writing through one is a no-op.
+    /// Assigning nil does not free the slot (use `remove`).
+    subscript(id: WindowID) -> Value? {
+        get {
+            liveIndex(of: id).flatMap { slots[$0].value }
+        }
+        set {
+            guard let index = liveIndex(of: id), let newValue else {
+                return
+            }
+            slots[index].value = newValue
+        }
+    }
+
+    /// Whether `id` addresses an occupied slot.
+    func contains(_ id: WindowID) -> Bool {
+        liveIndex(of: id) != nil
+    }
+
+    private func liveIndex(of id: WindowID) -> Int? {
+        let index = Int(id.index)
+        guard index < slots.count,
+              slots[index].generation == id.generation,
+              slots[index].value != nil else {
+            return nil
+        }
+        return index
+    }
+}
+
 /// Internal window registry for mapping platform-specific window handles to WindowIDs.
 ///
-/// This generic helper is used by platform implementations to track active windows
-/// and resolve WindowIDs when processing events. Each platform uses a different
-/// handle type (NSWindow.windowNumber on macOS, HWND on Windows).
+/// This generic helper is used by platform implementations to allocate
+/// WindowIDs, resolve them when processing events, and keep per-window
+/// backend state. Each platform uses a different handle type
+/// (NSWindow.windowNumber on macOS, HWND on Windows).
+///
+/// Per-window state lives in a `WindowSlab`, so once an event's WindowID is
+/// known every further lookup is an array access. The registry is a
+/// reference type so window close callbacks can unregister windows.
 ///
 /// Thread Safety: Must only be accessed from @MainActor.
 @MainActor
-internal struct WindowRegistry<PlatformHandle: Hashable> {
-    private var mapping: [PlatformHandle: WindowID] = [:]
+internal final class WindowRegistry<PlatformHandle: Hashable, State> {
+    private struct Entry {
+        var handle: PlatformHandle?
+        var state: State
+    }
+
+    private var entries = WindowSlab<Entry>()
+    private var handles: [PlatformHandle: WindowID] = [:]
+
+    init() {}
 
-    /// Register a new window with its platform handle.
+    /// Allocate a WindowID for a window that is about to be created.
+    ///
+    /// - Parameter state: Initial per-window state
+    /// - Returns: The new window's identifier
+    func reserve(_ state: State) -> WindowID {
+        entries.insert(Entry(handle: nil, state: state))
+    }
+
+    /// Associate a platform handle with a reserved WindowID.
     ///
     /// - Parameters:
     ///   - handle: Platform-specific window handle
-    ///   - id: Lumina WindowID to associate with this handle
-    mutating func register(_ handle: PlatformHandle, id: WindowID) {
-        mapping[handle] = id
+    ///   - id: WindowID returned by `reserve`
+    func register(_ handle: PlatformHandle, id: WindowID) {
+        guard entries.contains(id) else {
+            return
+        }
+        entries[id]?.handle = handle
+        handles[handle] = id
     }
 
-    /// Unregister a window by its platform handle.
+    /// Unregister a window and free its slot.
     ///
-    /// - Parameter handle: Platform-specific window handle to remove
-    mutating func unregister(_ handle: PlatformHandle) {
-        mapping.removeValue(forKey: handle)
+    /// - Parameter id: WindowID of the window to remove
+    func unregister(_ id: WindowID) {
+        if let entry = entries.remove(id), let handle = entry.handle {
+            handles.removeValue(forKey: handle)
+        }
     }
 
     /// Look up the WindowID for a platform handle.
@@ -30,11 +163,35 @@ internal struct WindowRegistry<PlatformHandle: Hashable> {
     /// - Parameter handle: Platform-specific window handle
     /// - Returns: The associated WindowID, or nil if not registered
     func windowID(for handle: PlatformHandle) -> WindowID? {
-        mapping[handle]
+        handles[handle]
+    }
+
+    /// Look up the platform handle registered for a WindowID.
+    ///
+    /// - Parameter id: WindowID of the window
+    /// - Returns: The platform handle, or nil if not registered
+    func handle(for id: WindowID) -> PlatformHandle? {
+        entries[id]?.handle
+    }
+
+    /// Per-window state for `id`, or nil if the window is not registered.
+    subscript(id: WindowID) -> State? {
+        get { entries[id]?.state }
+        set {
+            guard let newValue else {
+                return
+            }
+            entries[id]?.state = newValue
+        }
+    }
+
+    /// Number of registered windows.
+    var count: Int {
+        entries.count
     }
 
     /// Check if the registry is empty (no windows registered).
     var isEmpty: Bool {
-        mapping.isEmpty
+        entries.isEmpty
     }
 }
@@ -0,0 +1,226 @@
+import Foundation
+import Lumina
+
+/// The benchmark groups, run in order by main.swift.
+@MainActor
+enum Benchmarks {
+    /// Title of the window that receives synthesized input
+    static let hostTitle = "LuminaBenchmarks Host"
+
+    // MARK: - Monitors
+
+    /// `Monitor.all()` before any application exists (always enumerates).
+    static func monitorsUncached(_ runner: BenchmarkRunner) throws {
+        try runner.measure("monitor.all.uncached", warmup: 10, iterations: 200) {
+            _ = try Monitor.all()
+        }
+    }
+
+    /// `Monitor.all()` while an application tracks display changes.
+    static func monitors(_ runner: BenchmarkRunner) throws {
+        try runner.measure("monitor.all", warmup: 10, iterations: 1000) {
+            _ = try Monitor.all()
+        }
+        try runner.measure("monitor.primary", warmup: 10, iterations: 1000) {
+            _ = try Monitor.primary()
+        }
+    }
+
+    // MARK: - Windows
+
+    /// Create and destroy a window, with and without the window pool.
+    static func windows<App: LuminaApp>(_ runner: BenchmarkRunner, app: inout App) throws {
+        let descriptor = WindowDescriptor(title: "Benchmark", size: LogicalSize(width: 400, height: 300))
+        let warmup = 3
+        let iterations = runner.iterations(50)
+
+        for pooled in [false, true] {
+            let suffix = pooled ? ".pooled" : ""
+            app.windowPoolCapacity = pooled ? 1 : 0
+            if pooled {
+                try app.prewarmWindows(1, resizable: descriptor.resizable).get()
+            }
+
+            var creates: [Double] = []
+            var destroys: [Double] = []
+            for iteration in 0..<(warmup + iterations) {
+                let start = runner.clock.now
+                let window = try app.createWindow(descriptor).get()
+                let created = runner.clock.now
+                let id = window.id
+                window.close()
+                try pumpUntilClosed(id, app: &app)
+                let destroyed = runner.clock.now
+
+                if iteration >= warmup {
+                    creates.append(microseconds(start.duration(to: created)))
+                    destroys.append(microseconds(created.duration(to: destroyed)))
+                }
+            }
+            runner.record("window.create" + suffix, unit: "us", warmup: warmup, samples: creates)
+            runner.record("window.destroy" + suffix, unit: "us", warmup: warmup, samples: destroys)
+        }
+        app.windowPoolCapacity = 0
+
+        let batch = (0..<16).map { index in
+            WindowDescriptor(title: "Batch \(index)", size: LogicalSize(width: 200, height: 150))
+        }
+        try runner.sample("window.create.batch16", unit: "us/window", warmup: 1, iterations: 10) {
+            let start = runner.clock.now
+            let windows = try app.createWindows(batch).get()
+            let elapsed = microseconds(start.duration(to: runner.clock.now))
+            for window in windows {
+                let id = window.id
+                window.close()
+                try pumpUntilClosed(id, app: &app)
+            }
+            return elapsed / Double(batch.count)
+        }
+    }
+
+    /// Pump events until `.closed` arrives for `id`.
+    ///
+    /// - Throws: `BenchmarkSkipped` if it doesn't arrive within 2 s, which
+    ///   would otherwise be recorded as a 2 s destroy time
+    private static func pumpUntilClosed<App: LuminaApp>(_ id: WindowID, app: inout App) throws {
+        let deadline = ContinuousClock.now.advanced(by: .seconds(2))
+        while ContinuousClock.now < deadline {
+            while let event = try app.poll() {
+                if case .window(.closed(id)) = event {
+                    return
+                }
+            }
+            try app.wait(until: ContinuousClock.now.advanced(by: .milliseconds(1)))
+        }
+        throw BenchmarkSkipped(reason: "no .closed event for window \(id) within 2 s")
+    }
+
+    // MARK: - Input
+
+    /// Drain throughput of synthesized pointer motion through `drain(into:)`.
+    static func pollThroughput<App: LuminaApp>(_ runner: BenchmarkRunner, app: inout App) throws {
+        let count = 5_000  // Below the Win32 posted message limit (10,000)
+        var events: [Event] = []
+        events.reserveCapacity(count)
+
+        try runner.sample("poll.drain.pointerMotion", unit: "events/s", warmup: 2, iterations: 20) {
+            guard synthesizePointerMotion(count: count, windowTitle: hostTitle) else {
+                throw BenchmarkSkipped(reason: "could not synthesize pointer motion for \"\(hostTitle)\"")
+            }
+            var received = 0
+            let start = runner.clock.now
+            let deadline = start.advanced(by: .seconds(5))
+            while received < count && runner.clock.now < deadline {
+                events.removeAll(keepingCapacity: true)
+                try app.drain(into: &events)
+                for event in events {
+                    if case .pointer(.moved) = event {
+                        received += 1
+                    }
+                }
+            }
+            guard received == count else {
+                throw BenchmarkSkipped(reason: "only \(received) of \(count) synthesized events arrived")
+            }
+            let seconds = microseconds(start.duration(to: runner.clock.now)) / 1e6
+            return Double(received) / seconds
+        }
+    }
+
+    // MARK: - User Events
+
+    /// `postUserEvent` cost under contention from 1 to 8 producer threads.
+    static func userEvents<App: LuminaApp>(_ runner: BenchmarkRunner, app: inout App) throws {
+        let totalEvents = 100_000
+        var events: [Event] = []
+        events.reserveCapacity(totalEvents)
+
+        for producers in [1, 2, 4, 8] {
+            let perProducer = totalEvents / producers
+            let poster = app
+            var posts: [Double] = []
+            var drains: [Double] = []
+            let warmup = 1
+
+            for iteration in 0..<(warmup + runner.iterations(10)) {
+                let postDuration = runner.clock.measure {
+                    DispatchQueue.concurrentPerform(iterations: producers) { @Sendable producer in
+                        for index in 0..<perProducer {
+                            poster.postUserEvent(UserEvent(producer * perProducer + index))
+                        }
+                    }
+                }
+
+                var received = 0
+                let drainStart = runner.clock.now
+                let deadline = drainStart.advanced(by: .seconds(10))
+                while received < perProducer * producers && runner.clock.now < deadline {
+                    events.removeAll(keepingCapacity: true)
+                    try app.drain(into: &events)
+                    for event in events {
+                        if case .user = event {
+                            received += 1
+                        }
+                    }
+                }
+                let drainSeconds = microseconds(drainStart.duration(to: runner.clock.now)) / 1e6
+                guard received == perProducer * producers else {
+                    throw BenchmarkSkipped(reason: "only \(received) of \(perProducer * producers) user events arrived")
+                }
+
+                if iteration >= warmup {
+                    posts.append(microseconds(postDuration) * 1000 / Double(perProducer * producers))
+                    drains.append(Double(received) / drainSeconds)
+                }
+            }
+            runner.record("userEvent.post.\(producers)threads", unit: "ns/event", warmup: warmup, samples: posts)
+            runner.record("userEvent.drain.\(producers)threads", unit: "events/s", warmup: warmup, samples: drains)
+        }
+    }
+
+    /// Time from `postUserEvent` on a background thread to delivery by
+    /// `poll()` on a main thread blocked in `wait()`.
+    static func latency<App: LuminaApp>(_ runner: BenchmarkRunner, app: inout App) throws {
+        let poster = app
+
+        try runner.sample("latency.userEvent", unit: "us", warmup: 10, iterations: 200) {
+            // Post once the main thread is asleep, so the sample includes the wakeup
+            DispatchQueue.global().asyncAfter(deadline: .now() + .milliseconds(2)) {
+                poster.postUserEvent(UserEvent(ContinuousClock.now))
+            }
+
+            let deadline = ContinuousClock.now.advanced(by: .seconds(1))
+            while ContinuousClock.now < deadline {
+                try app.wait(until: deadline)
+                while let event = try app.poll() {
+                    if case .user(let userEvent) = event, let sent = userEvent.data as? ContinuousClock.Instant {
+                        return microseconds(sent.duration(to: ContinuousClock.now))
+                    }
+                }
+            }
+            throw BenchmarkSkipped(reason: "user event not delivered within 1 s")
+        }
+    }
+
+    // MARK: - Idle
+
+    /// CPU used while `wait(until:)` sleeps with nothing to deliver.
+    static func idleWait<App: LuminaApp>(_ runner: BenchmarkRunner, app: inout App) throws {
+        var events: [Event] = []
+        try app.drain(into: &events)
+
+        try runner.sample("idle.wait.cpu", unit: "% of one core", warmup: 1, iterations: 10) {
+            let wallStart = runner.clock.now
+            let cpuStart = processCPUTime()
+            let deadline = wallStart.advanced(by: .milliseconds(250))
+            while runner.clock.now < deadline {
+                try app.wait(until: deadline)
+                events.removeAll(keepingCapacity: true)
+                try app.drain(into: &events)
+            }
+            let cpu = microseconds(processCPUTime() - cpuStart)
+            let wall = microseconds(wallStart.duration(to: runner.clock.now))
+            return wall > 0 ? cpu / wall * 100 : 0
+        }
+    }
+}
@@ -0,0 +1,203 @@
+import Foundation
+
+/// Summary statistics of one benchmark's samples.
+///
+/// Percentiles use the nearest rank over the sorted samples, so p50 of an
+/// even-sized run is the upper middle sample rather than an interpolation.
+struct BenchmarkResult: Codable {
+    let name: String
+    let unit: String
+    let warmup: Int
+    let samples: Int
+    let min: Double
+    let mean: Double
+    let p50: Double
+    let p90: Double
+    let p99: Double
+    let max: Double
+
+    init(name: String, unit: String, warmup: Int, samples values: [Double]) {
+        let sorted = values.sorted()
+        self.name = name
+        self.unit = unit
+        self.warmup = warmup
+        self.samples = sorted.count
+        self.min = sorted.first ?? 0
+        self.max = sorted.last ?? 0
+        self.mean = sorted.isEmpty ? 0 : sorted.reduce(0, +) / Double(sorted.count)
+        self.p50 = BenchmarkResult.percentile(0.50, of: sorted)
+        self.p90 = BenchmarkResult.percentile(0.90, of: sorted)
+        self.p99 = BenchmarkResult.percentile(0.99, of: sorted)
+    }
+
+    /// Nearest-rank percentile of already sorted samples.
+    static func percentile(_ fraction: Double, of sorted: [Double]) -> Double {
+        guard !sorted.isEmpty else {
+            return 0
+        }
+        let rank = Int((fraction * Double(sorted.count)).rounded(.up))
+        return sorted[Swift.min(Swift.max(rank, 1), sorted.count) - 1]
+    }
+}
+
+/// Command line options.
+///
+/// ```
+/// swift run -c release LuminaBenchmarks [--filter <group>] [--json <path>] [--quick]
+/// ```
+struct BenchmarkOptions {
+    /// Only run groups whose name contains this string
+    var filter: String?
+
+    /// Write the results as JSON to this path ("-" for stdout)
+    var jsonPath: String?
+
+    /// Run a tenth of the iterations (smoke test)
+    var quick = false
+
+    init(arguments: [String]) {
+        var iterator = arguments.dropFirst().makeIterator()
+        while let argument = iterator.next() {
+            switch argument {
+            case "--filter":
+                filter = iterator.next()
+            case "--json":
+                jsonPath = iterator.next()
+            case "--quick":
+                quick = true
+            default:
+                FileHandle.standardError.write(Data("Ignoring unknown argument \(argument)\n".utf8))
+            }
+        }
+    }
+}
+
+/// Thrown by a benchmark that can't produce real samples on this machine
+/// (for example when input synthesis fails), so its group is skipped
+/// instead of recording made-up values.
+struct BenchmarkSkipped: Error {
+    let reason: String
+}
+
+/// Runs benchmarks and collects their results.
+///
+/// Every benchmark runs its warmup iterations first (discarded), then its
+/// measured iterations, timed with `ContinuousClock` (monotonic).
+@MainActor
+final class BenchmarkRunner {
+    let options: BenchmarkOptions
+    private(set) var results: [BenchmarkResult] = []
+    let clock = ContinuousClock()
+
+    init(options: BenchmarkOptions) {
+        self.options = options
+    }
+
+    /// Whether a benchmark group passes `--filter`.
+    func includes(_ group: String) -> Bool {
+        options.filter.map { group.contains($0) } ?? true
+    }
+
+    /// Run a benchmark group if it passes `--filter`.
+    ///
+    /// A group that throws `BenchmarkSkipped` is reported on stderr and
+    /// the run continues; the samples it recorded before are kept.
+    func group(_ name: String, _ body: () throws -> Void) throws {
+        guard includes(name) else {
+            return
+        }
+        do {
+            try body()
+        } catch let skipped as BenchmarkSkipped {
+            FileHandle.standardError.write(Data("Skipping \(name): \(skipped.reason)\n".utf8))
+        }
+    }
+
+    /// Iteration count after `--quick` scaling.
+    func iterations(_ count: Int) -> Int {
+        options.quick ? Swift.max(1, count / 10) : count
+    }
+
+    /// Time `body` per iteration, in microseconds.
+    func measure(
+        _ name: String,
+        warmup: Int,
+        iterations: Int,
+        _ body: () throws -> Void
+    ) rethrows {
+        try sample(name, unit: "us", warmup: warmup, iterations: iterations) {
+            let duration = try clock.measure(body)
+            return microseconds(duration)
+        }
+    }
+
+    /// Collect the value `body` returns per iteration.
+    func sample(
+        _ name: String,
+        unit: String,
+        warmup: Int,
+        iterations: Int,
+        _ body: () throws -> Double
+    ) rethrows {
+        for _ in 0..<warmup {
+            _ = try body()
+        }
+        var values: [Double] = []
+        let count = self.iterations(iterations)
+        values.reserveCapacity(count)
+        for _ in 0..<count {
+            values.append(try body())
+        }
+        record(name, unit: unit, warmup: warmup, samples: values)
+    }
+
+    /// Add samples collected by the benchmark itself.
+    func record(_ name: String, unit: String, warmup: Int, samples: [Double]) {
+        let result = BenchmarkResult(name: name, unit: unit, warmup: warmup, samples: samples)
+        results.append(result)
+        let line = name.padding(toLength: 36, withPad: " ", startingAt: 0)
+            + " p50 " + format(result.p50)
+            + "  p90 " + format(result.p90)
+            + "  p99 " + format(result.p99)
+            + "  max " + format(result.max)
+            + "  \(unit) (n=\(result.samples))\n"
+        // Keep stdout clean for `--json -`
+        let output = options.jsonPath == "-" ? FileHandle.standardError : FileHandle.standardOutput
+        output.write(Data(line.utf8))
+    }
+
+    /// Write the results as JSON.
+    func writeJSON(to path: String) throws {
+        struct Report: Codable {
+            let platform: String
+            let date: Date
+            let results: [BenchmarkResult]
+        }
+        #if os(macOS)
+        let platform = "macOS"
+        #elseif os(Windows)
+        let platform = "Windows"
+        #else
+        let platform = "unknown"
+        #endif
+
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
+        encoder.dateEncodingStrategy = .iso8601
+        let data = try encoder.encode(Report(platform: platform, date: Date(), results: results))
+        if path == "-" {
+            FileHandle.standardOutput.write(data)
+        } else {
+            try data.write(to: URL(fileURLWithPath: path))
+        }
+    }
+
+    private func format(_ value: Double) -> String {
+        String(format: "%10.2f", value)
+    }
+}
+
+/// Convert a Duration to fractional microseconds.
+func microseconds(_ duration: Duration) -> Double {
+    Double(duration.components.seconds) * 1e6 + Double(duration.components.attoseconds) / 1e12
+}
@@ -0,0 +1,87 @@
+import Foundation
+#if os(macOS)
+import AppKit
+#elseif os(Windows)
+import WinSDK
+#endif
+
+/// Platform hooks for the benchmarks: synthesized input and process CPU time.
+///
+/// Input is posted to the application's own queue (NSApp.postEvent,
+/// PostMessageW) rather than injected system-wide with CGEventPost or
+/// SendInput. Those need accessibility permission or the foreground window
+/// and move the real cursor, whereas posted events take the same
+/// translation path through the backend and run unattended in CI.
+
+/// Queue `count` pointer motion events for the window titled `title`.
+///
+/// - Returns: false if the window was not found
+@MainActor
+func synthesizePointerMotion(count: Int, windowTitle title: String) -> Bool {
+    #if os(macOS)
+    guard let nsWindow = NSApp.windows.first(where: { $0.title == title }) else {
+        return false
+    }
+    let timestamp = ProcessInfo.processInfo.systemUptime
+    for index in 0..<count {
+        guard let event = NSEvent.mouseEvent(
+            with: .mouseMoved,
+            location: NSPoint(x: 10 + Double(index % 200), y: 10 + Double(index % 150)),
+            modifierFlags: [],
+            timestamp: timestamp,
+            windowNumber: nsWindow.windowNumber,
+            context: nil,
+            eventNumber: index,
+            clickCount: 0,
+            pressure: 0
+        ) else {
+            return false
+        }
+        NSApp.postEvent(event, atStart: false)
+    }
+    return true
+    #elseif os(Windows)
+    let hwnd = "LuminaWindow".withCString(encodedAs: UTF16.self) { classPtr in
+        title.withCString(encodedAs: UTF16.self) { titlePtr in
+            FindWindowW(classPtr, titlePtr)
+        }
+    }
+    guard let hwnd else {
+        return false
+    }
+    for index in 0..<count {
+        let x = 10 + index % 200
+        let y = 10 + index % 150
+        PostMessageW(hwnd, UINT(WM_MOUSEMOVE), 0, LPARAM(x | (y << 16)))
+    }
+    return true
+    #else
+    return false
+    #endif
+}
+
+/// User plus system CPU time consumed by this process so far.
+func processCPUTime() -> Duration {
+    #if os(macOS)
+    var usage = rusage()
+    getrusage(RUSAGE_SELF, &usage)
+    func duration(_ time: timeval) -> Duration {
+        .seconds(Int64(time.tv_sec)) + .microseconds(Int64(time.tv_usec))
+    }
+    return duration(usage.ru_utime) + duration(usage.ru_stime)
+    #elseif os(Windows)
+    var creation = FILETIME()
+    var exit = FILETIME()
+    var kernel = FILETIME()
+    var user = FILETIME()
+    GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)
+    func duration(_ time: FILETIME) -> Duration {
+        // FILETIME counts 100 ns intervals
+        let ticks = UInt64(time.dwHighDateTime) << 32 | UInt64(time.dwLowDateTime)
+        return .nanoseconds(Int64(ticks) * 100)
+    }
+    return duration(kernel) + duration(user)
+    #else
+    return .zero
+    #endif
+}
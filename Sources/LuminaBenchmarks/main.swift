@@ -0,0 +1,59 @@
+import Foundation
+import Lumina
+
+/// Lumina benchmark suite.
+///
+/// Measures the hot paths of the library with a monotonic clock, warmup
+/// iterations and percentile summaries, and optionally writes the results
+/// as JSON for regression tracking:
+///
+/// ```bash
+/// swift run -c release LuminaBenchmarks --json results.json
+/// swift run -c release LuminaBenchmarks --filter window --quick
+/// ```
+
+@MainActor
+func runBenchmarks() throws {
+    let runner = BenchmarkRunner(options: BenchmarkOptions(arguments: CommandLine.arguments))
+
+    // Must run before an application starts caching the monitor list
+    try runner.group("monitor") {
+        try Benchmarks.monitorsUncached(runner)
+    }
+
+    var app = try createLuminaApp()
+    app.exitOnLastWindowClosed = false
+
+    // Receives the synthesized input; stays open for the whole run
+    var host = try app.createWindow(
+        WindowDescriptor(title: Benchmarks.hostTitle, size: LogicalSize(width: 400, height: 300))
+    ).get()
+    host.show()
+
+    try runner.group("monitor") {
+        try Benchmarks.monitors(runner)
+    }
+    try runner.group("window") {
+        try Benchmarks.windows(runner, app: &app)
+    }
+    try runner.group("poll") {
+        try Benchmarks.pollThroughput(runner, app: &app)
+    }
+    try runner.group("userEvent") {
+        try Benchmarks.userEvents(runner, app: &app)
+    }
+    try runner.group("latency") {
+        try Benchmarks.latency(runner, app: &app)
+    }
+    try runner.group("idle") {
+        try Benchmarks.idleWait(runner, app: &app)
+    }
+
+    host.close()
+
+    if let path = runner.options.jsonPath {
+        try runner.writeJSON(to: path)
+    }
+}
+
+try runBenchmarks()
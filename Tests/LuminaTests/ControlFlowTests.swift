@@ -0,0 +1,37 @@
+import Testing
+@testable import Lumina
+
+/// Tests for control flow modes (ControlFlow, deadline helpers)
+///
+/// Verifies:
+/// - ControlFlow equality, including deadlines
+/// - Remaining time until a deadline is never negative
+
+@Suite("Control Flow")
+struct ControlFlowTests {
+
+    @Test("ControlFlow compares modes and deadlines")
+    func equality() {
+        let deadline = ContinuousClock.now + .seconds(1)
+
+        #expect(ControlFlow.poll == .poll)
+        #expect(ControlFlow.wait != .poll)
+        #expect(ControlFlow.waitUntil(deadline) == .waitUntil(deadline))
+        #expect(ControlFlow.waitUntil(deadline) != .waitUntil(deadline + .milliseconds(1)))
+        #expect(ControlFlow.exit == .exit)
+        #expect(ControlFlow.exit != .poll)
+    }
+
+    @Test("Future deadlines report the remaining seconds")
+    func futureDeadline() {
+        let remaining = (ContinuousClock.now + .seconds(10)).secondsFromNow
+        #expect(remaining > 9)
+        #expect(remaining <= 10)
+    }
+
+    @Test("Past deadlines report zero")
+    func pastDeadline() {
+        let deadline = ContinuousClock.now - .seconds(1)
+        #expect(deadline.secondsFromNow == 0)
+    }
+}
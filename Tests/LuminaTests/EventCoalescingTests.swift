@@ -0,0 +1,399 @@
+import Testing
+@testable import Lumina
+
+/// Tests for event coalescing (EventCoalescing, EventCoalescer, EventPipeline)
+///
+/// Verifies:
+/// - Consecutive pointer motion for one window collapses to the latest sample
+/// - Consecutive wheel and raw motion events sum their deltas
+/// - Events for other windows or of other kinds break a run
+/// - Intermediate pointer samples are retained on request
+/// - Merged events carry the timestamp of the latest event in the run
+/// - Typed text joins across its key events and breaks at other key presses
+/// - Resize/move events collapse to the latest per window across a batch
+/// - Per-window overrides replace the application-wide options
+/// - The pipeline buffers coalesced events beyond a bounded drain
+
+@Suite("Event Coalescing")
+struct EventCoalescingTests {
+
+    // MARK: - EventCoalescer Tests
+
+    @Suite("EventCoalescer")
+    struct CoalescerTests {
+
+        @Test("Disabled coalescing leaves events untouched")
+        func disabled() {
+            let windowID = WindowID()
+            var events: [EventEnvelope] = envelopes([
+                .pointer(.moved(windowID, position: LogicalPosition(x: 1, y: 1))),
+                .pointer(.moved(windowID, position: LogicalPosition(x: 2, y: 2)))
+            ])
+            var coalescer = EventCoalescer()
+            coalescer.coalesce(&events, options: [])
+            #expect(events.count == 2)
+        }
+
+        @Test("Consecutive motion keeps the most recent position")
+        func pointerMotion() {
+            let windowID = WindowID()
+            var events: [EventEnvelope] = envelopes((1...5).map { value in
+                .pointer(.moved(windowID, position: LogicalPosition(x: Float(value), y: 0)))
+            })
+            var coalescer = EventCoalescer()
+            coalescer.coalesce(&events, options: .pointerMotion)
+
+            #expect(events.count == 1)
+            #expect(events[0].timestamp == EventTimestamp(nanoseconds: 5))
+            if case .pointer(.moved(let id, let position)) = events[0].event {
+                #expect(id == windowID)
+                #expect(position.x == 5)
+            } else {
+                Issue.record("Expected .moved event")
+            }
+        }
+
+        @Test("Motion runs are split by other windows and other events")
+        func runBoundaries() {
+            let first = WindowID()
+            let second = WindowID()
+            let origin = LogicalPosition(x: 0, y: 0)
+            var events: [EventEnvelope] = envelopes([
+                .pointer(.moved(first, position: origin)),
+                .pointer(.moved(first, position: origin)),
+                .pointer(.moved(second, position: origin)),
+                .pointer(.buttonPressed(second, button: .left, position: origin)),
+                .pointer(.moved(second, position: origin)),
+                .pointer(.moved(second, position: origin))
+            ])
+            var coalescer = EventCoalescer()
+            coalescer.coalesce(&events, options: .pointerMotion)
+
+            #expect(events.count == 4)
+        }
+
+        @Test("Consecutive wheel events sum their deltas")
+        func wheel() {
+            let windowID = WindowID()
+            var events: [EventEnvelope] = envelopes([
+                .pointer(.wheel(windowID, deltaX: 1, deltaY: -1)),
+                .pointer(.wheel(windowID, deltaX: 0.5, deltaY: -2)),
+                .pointer(.wheel(windowID, deltaX: 0, deltaY: 0.5))
+            ])
+            var coalescer = EventCoalescer()
+            coalescer.coalesce(&events, options: .wheel)
+
+            #expect(events.count == 1)
+            if case .pointer(.wheel(_, let deltaX, let deltaY)) = events[0].event {
+                #expect(deltaX == 1.5)
+                #expect(deltaY == -2.5)
+            } else {
+                Issue.record("Expected .wheel event")
+            }
+        }
+
+        @Test("Consecutive raw motion sums its deltas")
+        func rawMotion() {
+            var events: [EventEnvelope] = envelopes([
+                .pointer(.rawMotion(dx: 1, dy: 2)),
+                .pointer(.rawMotion(dx: -3, dy: 0.5)),
+                .pointer(.rawMotion(dx: 4, dy: 0))
+            ])
+            var coalescer = EventCoalescer()
+            coalescer.coalesce(&events, options: .pointerMotion)
+
+            #expect(events.count == 1)
+            if case .pointer(.rawMotion(let dx, let dy)) = events[0].event {
+                #expect(dx == 2)
+                #expect(dy == 2.5)
+            } else {
+                Issue.record("Expected .rawMotion event")
+            }
+        }
+
+        @Test("Wheel events are not merged with motion-only coalescing")
+        func wheelRequiresOption() {
+            let windowID = WindowID()
+            var events: [EventEnvelope] = envelopes([
+                .pointer(.wheel(windowID, deltaX: 0, deltaY: 1)),
+                .pointer(.wheel(windowID, deltaX: 0, deltaY: 1))
+            ])
+            var coalescer = EventCoalescer()
+            coalescer.coalesce(&events, options: .pointerMotion)
+            #expect(events.count == 2)
+        }
+
+        @Test("Intermediate samples are retained on request")
+        func pointerSamples() {
+            let windowID = WindowID()
+            var events: [EventEnvelope] = envelopes((1...3).map { value in
+                .pointer(.moved(windowID, position: LogicalPosition(x: Float(value), y: 0)))
+            })
+            var coalescer = EventCoalescer()
+            coalescer.coalesce(&events, options: [.pointerMotion, .pointerSamples])
+
+            #expect(events.count == 1)
+            #expect(coalescer.pointerSamples[windowID]?.map(\.x) == [1, 2, 3])
+
+            // Samples describe the latest batch only
+            var next: [EventEnvelope] = []
+            coalescer.coalesce(&next, options: [.pointerMotion, .pointerSamples])
+            #expect(coalescer.pointerSamples[windowID] == nil)
+        }
+    }
+
+    // MARK: - Geometry Coalescing Tests
+
+    @Suite("Resize Coalescing")
+    struct ResizeTests {
+
+        @Test("Resize and move events collapse to the latest per window")
+        func collapseGeometry() {
+            let windowID = WindowID()
+            let other = WindowID()
+            var events: [EventEnvelope] = envelopes([
+                .window(.liveResizeStarted(windowID)),
+                .window(.resized(windowID, LogicalSize(width: 100, height: 100))),
+                .window(.redrawRequested(windowID)),
+                .window(.resized(windowID, LogicalSize(width: 200, height: 150))),
+                .window(.moved(windowID, LogicalPosition(x: 5, y: 5))),
+                .window(.resized(other, LogicalSize(width: 50, height: 50))),
+                .window(.moved(windowID, LogicalPosition(x: 10, y: 20))),
+                .window(.liveResizeEnded(windowID))
+            ])
+            var coalescer = EventCoalescer()
+            coalescer.coalesce(&events, options: .resize)
+
+            #expect(events.count == 6)
+            if case .window(.resized(let id, let size)) = events[2].event {
+                #expect(id == windowID)
+                #expect(size.width == 200)
+            } else {
+                Issue.record("Expected latest .resized event")
+            }
+            if case .window(.moved(_, let position)) = events[4].event {
+                #expect(position.y == 20)
+            } else {
+                Issue.record("Expected latest .moved event")
+            }
+            if case .window(.liveResizeEnded) = events[5].event {
+                // Expected
+            } else {
+                Issue.record("Expected .liveResizeEnded last")
+            }
+        }
+
+        @Test("Per-window overrides replace the global options")
+        func perWindowOverride() {
+            let resizing = WindowID()
+            let plain = WindowID()
+            let size = LogicalSize(width: 1, height: 1)
+            var events: [EventEnvelope] = envelopes([
+                .window(.resized(resizing, size)),
+                .window(.resized(plain, size)),
+                .window(.resized(resizing, size)),
+                .window(.resized(plain, size))
+            ])
+            var coalescer = EventCoalescer()
+            coalescer.coalesce(&events, options: [], overrides: [resizing: .resize])
+
+            #expect(events.count == 3)
+        }
+
+        @Test("An empty override disables coalescing for that window")
+        func emptyOverride() {
+            let windowID = WindowID()
+            let origin = LogicalPosition(x: 0, y: 0)
+            var events: [EventEnvelope] = envelopes([
+                .pointer(.moved(windowID, position: origin)),
+                .pointer(.moved(windowID, position: origin))
+            ])
+            var coalescer = EventCoalescer()
+            coalescer.coalesce(&events, options: .all, overrides: [windowID: []])
+
+            #expect(events.count == 2)
+        }
+    }
+
+    // MARK: - Text Coalescing Tests
+
+    @Suite("Text Coalescing")
+    struct TextTests {
+
+        @Test("Typed characters join across their key events")
+        func typing() {
+            let windowID = WindowID()
+            let a = KeyCode(rawValue: 0x00)
+            let b = KeyCode(rawValue: 0x0B)
+            var events: [EventEnvelope] = envelopes([
+                .keyboard(.keyDown(windowID, key: a, modifiers: [])),
+                .keyboard(.textInput(windowID, text: "a")),
+                .keyboard(.keyUp(windowID, key: a, modifiers: [])),
+                .keyboard(.keyDown(windowID, key: b, modifiers: [])),
+                .keyboard(.textInput(windowID, text: "b")),
+                .keyboard(.keyUp(windowID, key: b, modifiers: []))
+            ])
+            var coalescer = EventCoalescer()
+            coalescer.coalesce(&events, options: .text)
+
+            #expect(events.count == 5)
+            if case .keyboard(.textInput(let id, let text)) = events[3].event {
+                #expect(id == windowID)
+                #expect(text == "ab")
+            } else {
+                Issue.record("Expected merged .textInput event")
+            }
+            #expect(events[3].timestamp == EventTimestamp(nanoseconds: 5))
+            if case .keyboard(.keyUp(_, let key, _)) = events[4].event {
+                #expect(key == b)
+            } else {
+                Issue.record("Expected trailing .keyUp event")
+            }
+        }
+
+        @Test("A long typing burst becomes its key events and one string")
+        func burst() {
+            let windowID = WindowID()
+            let key = KeyCode(rawValue: 0x00)
+            let characters = (0..<200).map { String(UnicodeScalar(UInt8(0x61 + $0 % 26))) }
+            var events: [EventEnvelope] = envelopes(characters.flatMap { character -> [Event] in
+                [
+                    .keyboard(.keyDown(windowID, key: key, modifiers: [])),
+                    .keyboard(.textInput(windowID, text: character)),
+                    .keyboard(.keyUp(windowID, key: key, modifiers: []))
+                ]
+            })
+            var coalescer = EventCoalescer()
+            coalescer.coalesce(&events, options: .text)
+
+            #expect(events.count == 401)
+            #expect(events[0..<399].allSatisfy {
+                if case .keyboard(.textInput) = $0.event { return false }
+                return true
+            })
+            if case .keyboard(.textInput(_, let text)) = events[399].event {
+                #expect(text == characters.joined())
+            } else {
+                Issue.record("Expected merged .textInput event")
+            }
+            if case .keyboard(.keyUp(_, let released, _)) = events[400].event {
+                #expect(released == key)
+            } else {
+                Issue.record("Expected trailing .keyUp event")
+            }
+        }
+
+        @Test("Other key presses end a text run")
+        func editingKeys() {
+            let windowID = WindowID()
+            let backspace = KeyCode(rawValue: 0x33)
+            var events: [EventEnvelope] = envelopes([
+                .keyboard(.textInput(windowID, text: "a")),
+                .keyboard(.keyDown(windowID, key: backspace, modifiers: [])),
+                .keyboard(.keyUp(windowID, key: backspace, modifiers: [])),
+                .keyboard(.textInput(windowID, text: "b"))
+            ])
+            var coalescer = EventCoalescer()
+            coalescer.coalesce(&events, options: .text)
+            #expect(events.count == 4)
+        }
+
+        @Test("Text is untouched without the text option")
+        func requiresOption() {
+            let windowID = WindowID()
+            var events: [EventEnvelope] = envelopes([
+                .keyboard(.textInput(windowID, text: "a")),
+                .keyboard(.textInput(windowID, text: "b"))
+            ])
+            var coalescer = EventCoalescer()
+            coalescer.coalesce(&events, options: .all)
+            #expect(events.count == 2)
+        }
+    }
+
+    // MARK: - EventPipeline Tests
+
+    @Suite("EventPipeline")
+    @MainActor
+    struct PipelineTests {
+
+        @Test("Bounded drain buffers the coalesced remainder")
+        func boundedDrain() {
+            let windowID = WindowID()
+            let pipeline = EventPipeline()
+            pipeline.coalescing = .pointerMotion
+
+            var source: [EventEnvelope] = envelopes([
+                .pointer(.moved(windowID, position: LogicalPosition(x: 1, y: 0))),
+                .pointer(.moved(windowID, position: LogicalPosition(x: 2, y: 0))),
+                .keyboard(.keyDown(windowID, key: .space, modifiers: [])),
+                .pointer(.moved(windowID, position: LogicalPosition(x: 3, y: 0)))
+            ])
+            let backendDrain: (inout [EventEnvelope], Int) -> Int = { events, maxCount in
+                let moved = min(maxCount, source.count)
+                events.append(contentsOf: source.prefix(moved))
+                source.removeFirst(moved)
+                return moved
+            }
+
+            var events: [Event] = []
+            let first = pipeline.drain(into: &events, maxCount: 2, transform: \.event, drain: backendDrain)
+            #expect(first == 2)
+            #expect(!pipeline.isEmpty)
+
+            let next = pipeline.next(poll: { nil }, drain: backendDrain)
+            if case .pointer(.moved(_, let position)) = next?.event {
+                #expect(position.x == 3)
+            } else {
+                Issue.record("Expected buffered .moved event")
+            }
+            #expect(pipeline.isEmpty)
+        }
+
+        @Test("Window overrides fall back to the global options")
+        func windowOverrides() {
+            let windowID = WindowID()
+            let pipeline = EventPipeline()
+            pipeline.coalescing = .pointerMotion
+
+            pipeline.setCoalescing(.resize, for: windowID)
+            #expect(pipeline.coalescing(for: windowID) == .resize)
+            #expect(pipeline.coalescing(for: WindowID()) == .pointerMotion)
+
+            pipeline.setCoalescing(nil, for: windowID)
+            #expect(pipeline.coalescing(for: windowID) == .pointerMotion)
+        }
+
+        @Test("Disabled coalescing uses the single-event path")
+        func passthrough() {
+            let windowID = WindowID()
+            let pipeline = EventPipeline()
+            var polled = 0
+
+            let event = pipeline.next(
+                poll: {
+                    polled += 1
+                    return EventEnvelope(.window(.focused(windowID)))
+                },
+                drain: { _, _ in
+                    Issue.record("Batch path should not be used")
+                    return 0
+                }
+            )
+
+            #expect(polled == 1)
+            if case .window(.focused(let id)) = event?.event {
+                #expect(id == windowID)
+            } else {
+                Issue.record("Expected .focused event")
+            }
+        }
+    }
+}
+
+/// Wrap events in envelopes with increasing timestamps.
+private func envelopes(_ events: [Event]) -> [EventEnvelope] {
+    events.enumerated().map { index, event in
+        EventEnvelope(event, timestamp: EventTimestamp(nanoseconds: UInt64(index + 1)))
+    }
+}
@@ -0,0 +1,59 @@
+import Testing
+@testable import Lumina
+
+/// Tests for run(handler:) dispatch (EventDispatcher, ControlFlow.exit)
+///
+/// Verifies:
+/// - The handler's latest return value becomes the loop's control flow
+/// - Nothing is dispatched after the handler returns `.exit`
+/// - Batches stop at `.exit` and hand back the undelivered remainder
+
+@Suite("Event Dispatcher")
+@MainActor
+struct EventDispatcherTests {
+
+    @Test("The initial control flow applies until the handler returns")
+    func initialControlFlow() {
+        let dispatcher = EventDispatcher(handler: { _ in .poll }, controlFlow: .wait)
+        #expect(dispatcher.controlFlow == .wait)
+        #expect(!dispatcher.isExiting)
+
+        dispatcher.dispatch(.window(.created(WindowID())))
+        #expect(dispatcher.controlFlow == .poll)
+    }
+
+    @Test("Events after exit are not delivered")
+    func exitStopsDispatch() {
+        var received = 0
+        let dispatcher = EventDispatcher(handler: { _ in
+            received += 1
+            return .exit
+        }, controlFlow: .wait)
+
+        #expect(dispatcher.dispatch(.window(.created(WindowID()))))
+        #expect(dispatcher.isExiting)
+        #expect(!dispatcher.dispatch(.window(.created(WindowID()))))
+        #expect(received == 1)
+    }
+
+    @Test("Batches return the events left after exit")
+    func batchRemainder() {
+        let closing = WindowID()
+        let dispatcher = EventDispatcher(handler: { event in
+            if case .window(.closed(let id)) = event, id == closing {
+                return .exit
+            }
+            return .wait
+        }, controlFlow: .wait)
+
+        let batch = [
+            EventEnvelope(.window(.focused(closing))),
+            EventEnvelope(.window(.closed(closing))),
+            EventEnvelope(.window(.created(WindowID()))),
+            EventEnvelope(.window(.created(WindowID())))
+        ]
+        let remainder = dispatcher.dispatch(batch)
+        #expect(remainder.count == 2)
+        #expect(remainder.startIndex == 2)
+    }
+}
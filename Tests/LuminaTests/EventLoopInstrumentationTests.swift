@@ -0,0 +1,76 @@
+import Testing
+@testable import Lumina
+
+/// Tests for event loop instrumentation (EventLoopInstrumentation, statistics())
+///
+/// Verifies:
+/// - A disabled instance records nothing
+/// - Counters, the high-water mark and reset
+/// - Translated, dropped, coalesced and wakeup counts from the headless backend
+
+@Suite("Event Loop Instrumentation")
+@MainActor
+struct EventLoopInstrumentationTests {
+
+    @Test("Disabled instrumentation records nothing")
+    func disabled() {
+        let instrumentation = EventLoopInstrumentation()
+        instrumentation.count(.eventsTranslated, 5)
+        instrumentation.noteQueueDepth(10)
+        let value = instrumentation.measure(.dispatch) { 42 }
+
+        #expect(value == 42)
+        #expect(instrumentation.snapshot() == EventLoopStatistics())
+    }
+
+    @Test("Counters accumulate and reset")
+    func counters() {
+        let instrumentation = EventLoopInstrumentation()
+        instrumentation.isEnabled = true
+        instrumentation.count(.messagesDispatched)
+        instrumentation.count(.messagesDispatched, 2)
+        instrumentation.count(.eventsCoalesced, 0)
+        instrumentation.noteQueueDepth(8)
+        instrumentation.noteQueueDepth(3)
+
+        let statistics = instrumentation.snapshot()
+        #expect(statistics.messagesDispatched == 3)
+        #expect(statistics.eventsCoalesced == 0)
+        #expect(statistics.queueHighWaterMark == 8)
+
+        instrumentation.reset()
+        #expect(instrumentation.snapshot() == EventLoopStatistics())
+    }
+
+    @Test("Headless backend reports translated, dropped, coalesced and wakeups")
+    func headless() throws {
+        var app = HeadlessApplication()
+        let window = try app.createWindow(
+            title: "Test", size: LogicalSize(width: 640, height: 480), resizable: true, monitor: nil
+        ).get()
+        _ = try app.pollBatch()
+
+        app.instrumentationEnabled = true
+        app.eventCoalescing = .pointerMotion
+        for x in 1...3 {
+            app.inject(.pointer(.moved(window.id, position: LogicalPosition(x: Float(x), y: 0))))
+        }
+        app.setEventMask([.pointerMotion], for: window.id)
+        app.inject(.keyboard(.keyDown(window.id, key: KeyCode(rawValue: 7), modifiers: [])))
+        app.postUserEvent(UserEvent(1))
+        app.postUserEvent(UserEvent(2))
+
+        let events = try app.pollBatch()
+        #expect(events.count == 3)
+
+        let statistics = app.statistics()
+        #expect(statistics.eventsTranslated == 3)
+        #expect(statistics.eventsDropped == 1)
+        #expect(statistics.eventsCoalesced == 2)
+        #expect(statistics.queueHighWaterMark == 5)
+        #expect(statistics.wakeups == 1)
+
+        app.resetStatistics()
+        #expect(app.statistics() == EventLoopStatistics())
+    }
+}
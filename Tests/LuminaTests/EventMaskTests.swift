@@ -0,0 +1,48 @@
+import Testing
+@testable import Lumina
+
+/// Tests for input subscription masks (EventMask)
+///
+/// Verifies:
+/// - `.all` covers every input category
+/// - Categories combine and remove like any OptionSet
+/// - Each input event belongs to exactly one category
+
+@Suite("Event Mask")
+struct EventMaskTests {
+
+    @Test("All includes every input category")
+    func all() {
+        let categories: [EventMask] = [.pointerMotion, .pointerButtons, .wheel, .keyboard, .text]
+        for category in categories {
+            #expect(EventMask.all.contains(category))
+        }
+        #expect(EventMask.all == EventMask(categories))
+    }
+
+    @Test("Unsubscribing a category leaves the others")
+    func subtract() {
+        var mask = EventMask.all
+        mask.remove(.pointerMotion)
+        #expect(!mask.contains(.pointerMotion))
+        #expect(mask.contains(.pointerButtons))
+        #expect(mask.contains(.keyboard))
+    }
+
+    @Test("An empty mask subscribes to no input")
+    func empty() {
+        let mask: EventMask = []
+        #expect(mask.isEmpty)
+        #expect(!mask.contains(.text))
+    }
+
+    @Test("Input events map to their category; others are never masked")
+    func category() {
+        let id = WindowID()
+        #expect(EventMask.category(of: .pointer(.entered(id))) == .pointerMotion)
+        #expect(EventMask.category(of: .pointer(.buttonReleased(id, button: .left, position: LogicalPosition(x: 0, y: 0)))) == .pointerButtons)
+        #expect(EventMask.category(of: .keyboard(.textInput(id, text: "a"))) == .text)
+        #expect(EventMask.category(of: .pointer(.rawMotion(dx: 1, dy: 1))) == nil)
+        #expect(EventMask.category(of: .window(.focused(id))) == nil)
+    }
+}
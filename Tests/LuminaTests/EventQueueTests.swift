@@ -0,0 +1,201 @@
+import Testing
+import Foundation
+@testable import Lumina
+
+/// Tests for the internal event queue storage (RingBuffer, EventRingBuffer, EventQueue)
+///
+/// Verifies:
+/// - FIFO ordering across wrap-around and growth
+/// - Bounded and unbounded batch draining
+/// - Packed events keep their out-of-line text and user payloads in order
+/// - Thread-safe concurrent appends
+
+@Suite("Event Queue")
+struct EventQueueTests {
+
+    // MARK: - RingBuffer Tests
+
+    @Suite("RingBuffer")
+    struct RingBufferTests {
+
+        @Test("Capacity rounds up to a power of two")
+        func capacityRounding() {
+            let buffer = RingBuffer<Int>(minimumCapacity: 5)
+            #expect(buffer.capacity == 8)
+            #expect(buffer.isEmpty)
+            #expect(buffer.first == nil)
+        }
+
+        @Test("Pops elements in FIFO order")
+        func fifoOrder() {
+            var buffer = RingBuffer<Int>(minimumCapacity: 4)
+            buffer.append(1)
+            buffer.append(2)
+            buffer.append(3)
+
+            #expect(buffer.first == 1)
+            #expect(buffer.popFirst() == 1)
+            #expect(buffer.popFirst() == 2)
+            #expect(buffer.popFirst() == 3)
+            #expect(buffer.popFirst() == nil)
+        }
+
+        @Test("Preserves order across wrap-around")
+        func wrapAround() {
+            var buffer = RingBuffer<Int>(minimumCapacity: 4)
+            for value in 0..<3 {
+                buffer.append(value)
+            }
+            _ = buffer.popFirst()
+            _ = buffer.popFirst()
+            for value in 3..<6 {
+                buffer.append(value)
+            }
+
+            #expect(buffer.capacity == 4)
+            var drained: [Int] = []
+            buffer.drain(into: &drained)
+            #expect(drained == [2, 3, 4, 5])
+        }
+
+        @Test("Grows when full without reordering")
+        func growth() {
+            var buffer = RingBuffer<Int>(minimumCapacity: 2)
+            buffer.append(0)
+            buffer.append(1)
+            _ = buffer.popFirst()
+            for value in 2..<10 {
+                buffer.append(value)
+            }
+
+            #expect(buffer.count == 9)
+            #expect(buffer.capacity >= 9)
+            var drained: [Int] = []
+            buffer.drain(into: &drained)
+            #expect(drained == Array(1..<10))
+        }
+
+        @Test("Bounded drain leaves the remainder queued")
+        func boundedDrain() {
+            var buffer = RingBuffer<Int>()
+            buffer.append(contentsOf: 0..<10)
+
+            var drained: [Int] = []
+            let moved = buffer.drain(into: &drained, maxCount: 4)
+
+            #expect(moved == 4)
+            #expect(drained == [0, 1, 2, 3])
+            #expect(buffer.count == 6)
+            #expect(buffer.first == 4)
+        }
+
+        @Test("Remove all keeps capacity")
+        func removeAll() {
+            var buffer = RingBuffer<Int>(minimumCapacity: 16)
+            buffer.append(contentsOf: 0..<10)
+            buffer.removeAll()
+
+            #expect(buffer.isEmpty)
+            #expect(buffer.capacity == 16)
+        }
+    }
+
+    // MARK: - EventRingBuffer Tests
+
+    @Suite("EventRingBuffer")
+    struct EventRingBufferTests {
+
+        private static let window = WindowID(index: 2, generation: 5)
+
+        @Test("Records are 32-byte plain values")
+        func layout() {
+            #expect(MemoryLayout<PackedEvent>.stride == 32)
+            #expect(_isPOD(PackedEvent.self))
+        }
+
+        @Test("Events round-trip in order across growth, with their payloads")
+        func roundTrip() {
+            var buffer = EventRingBuffer(minimumCapacity: 2)
+            buffer.append(EventEnvelope(.keyboard(.textInput(Self.window, text: "a")), timestamp: EventTimestamp(nanoseconds: 1)))
+            buffer.append(EventEnvelope(.user(UserEvent(7)), timestamp: EventTimestamp(nanoseconds: 2)))
+            buffer.append(EventEnvelope(.pointer(.wheel(Self.window, deltaX: 0.5, deltaY: -1)), timestamp: EventTimestamp(nanoseconds: 3)))
+            buffer.append(EventEnvelope(.keyboard(.textInput(Self.window, text: "👋")), timestamp: EventTimestamp(nanoseconds: 4)))
+            #expect(buffer.count == 4)
+            #expect(buffer.capacity == 4)
+
+            guard case .keyboard(.textInput(Self.window, let first)) = buffer.popFirst()?.event else {
+                Issue.record("Expected the first text input")
+                return
+            }
+            #expect(first == "a")
+
+            var drained: [EventEnvelope] = []
+            #expect(buffer.drain(into: &drained) == 3)
+            #expect(drained.map(\.timestamp.nanoseconds) == [2, 3, 4])
+            guard case .user(let user) = drained[0].event,
+                  case .pointer(.wheel(Self.window, deltaX: 0.5, deltaY: -1)) = drained[1].event,
+                  case .keyboard(.textInput(_, let second)) = drained[2].event else {
+                Issue.record("Expected user, wheel and text events")
+                return
+            }
+            #expect(user.data as? Int == 7)
+            #expect(second == "👋")
+            #expect(buffer.isEmpty)
+        }
+
+        @Test("Remove all drops queued payloads")
+        func removeAll() {
+            var buffer = EventRingBuffer()
+            buffer.append(EventEnvelope(.keyboard(.textInput(Self.window, text: "stale"))))
+            buffer.removeAll()
+            buffer.append(EventEnvelope(.keyboard(.textInput(Self.window, text: "fresh"))))
+
+            guard case .keyboard(.textInput(_, let text)) = buffer.popFirst()?.event else {
+                Issue.record("Expected text input")
+                return
+            }
+            #expect(text == "fresh")
+        }
+    }
+
+    // MARK: - EventQueue Tests
+
+    @Suite("EventQueue")
+    struct ConcurrentQueueTests {
+
+        @Test("Drain appends to existing contents")
+        func drainAppends() {
+            let queue = EventQueue<RingBuffer<Int>>()
+            queue.append(contentsOf: [1, 2, 3])
+
+            var drained = [0]
+            let moved = queue.drain(into: &drained)
+
+            #expect(moved == 3)
+            #expect(drained == [0, 1, 2, 3])
+            #expect(queue.isEmpty)
+        }
+
+        @Test("Concurrent appends are all delivered")
+        func concurrentAppends() async {
+            let queue = EventQueue<RingBuffer<Int>>(minimumCapacity: 8)
+            let producers = 8
+            let perProducer = 1_000
+
+            await withTaskGroup(of: Void.self) { group in
+                for producer in 0..<producers {
+                    group.addTask {
+                        for index in 0..<perProducer {
+                            queue.append(producer * perProducer + index)
+                        }
+                    }
+                }
+            }
+
+            var drained: [Int] = []
+            queue.drain(into: &drained)
+            #expect(drained.count == producers * perProducer)
+            #expect(Set(drained).count == producers * perProducer)
+        }
+    }
+}
@@ -9,6 +9,7 @@ import Testing
 /// - ModifierKeys OptionSet operations
 /// - KeyCode equality and hashing
 /// - UserEvent creation and type erasure
+/// - EventTimestamp ordering and EventEnvelope wrapping
 
 @Suite("Event Types")
 struct EventTests {
@@ -136,6 +137,35 @@ struct EventTests {
                 Issue.record("Expected .scaleFactorChanged event")
             }
         }
+
+        @Test("Window redraw requested event")
+        func redrawRequested() {
+            let windowID = WindowID()
+            let event = WindowEvent.redrawRequested(windowID)
+
+            if case .redrawRequested(let id) = event {
+                #expect(id == windowID)
+            } else {
+                Issue.record("Expected .redrawRequested event")
+            }
+        }
+
+        @Test("Window live resize events")
+        func liveResize() {
+            let windowID = WindowID()
+
+            if case .liveResizeStarted(let id) = WindowEvent.liveResizeStarted(windowID) {
+                #expect(id == windowID)
+            } else {
+                Issue.record("Expected .liveResizeStarted event")
+            }
+
+            if case .liveResizeEnded(let id) = WindowEvent.liveResizeEnded(windowID) {
+                #expect(id == windowID)
+            } else {
+                Issue.record("Expected .liveResizeEnded event")
+            }
+        }
     }
 
     // MARK: - PointerEvent Tests
@@ -203,6 +233,18 @@ struct EventTests {
                 Issue.record("Expected .wheel event")
             }
         }
+
+        @Test("Raw motion event")
+        func rawMotion() {
+            let event = PointerEvent.rawMotion(dx: 3, dy: -1.5)
+
+            if case .rawMotion(let dx, let dy) = event {
+                #expect(dx == 3)
+                #expect(dy == -1.5)
+            } else {
+                Issue.record("Expected .rawMotion event")
+            }
+        }
     }
 
     // MARK: - KeyboardEvent Tests
@@ -470,4 +512,46 @@ struct EventTests {
             }
         }
     }
+
+    // MARK: - EventEnvelope Tests
+
+    @Suite("EventEnvelope")
+    struct EventEnvelopeTests {
+
+        @Test("Timestamps order by nanoseconds")
+        func ordering() {
+            let earlier = EventTimestamp(nanoseconds: 1_000)
+            let later = EventTimestamp(nanoseconds: 3_500)
+
+            #expect(earlier < later)
+            #expect(earlier.duration(to: later) == .nanoseconds(2_500))
+            #expect(later.duration(to: earlier) == .nanoseconds(-2_500))
+        }
+
+        @Test("Fractional seconds convert to nanoseconds")
+        func fromSeconds() {
+            #expect(EventTimestamp(seconds: 1.5).nanoseconds == 1_500_000_000)
+            #expect(EventTimestamp(seconds: -1).nanoseconds == 0)
+        }
+
+        @Test("The event clock is monotonic")
+        func monotonic() {
+            let first = EventTimestamp.now()
+            let second = EventTimestamp.now()
+            #expect(first <= second)
+        }
+
+        @Test("Envelope defaults to the current time")
+        func defaultTimestamp() {
+            let before = EventTimestamp.now()
+            let envelope = EventEnvelope(.window(.focused(WindowID())))
+
+            #expect(envelope.timestamp >= before)
+            if case .window(.focused) = envelope.event {
+                // Expected
+            } else {
+                Issue.record("Expected .focused event")
+            }
+        }
+    }
 }
@@ -0,0 +1,152 @@
+import Testing
+@testable import Lumina
+
+/// Tests for event traces (EventRecord, EventTraceFormat, ReplayApplication)
+///
+/// Verifies:
+/// - Every recordable event survives the record encoding
+/// - Traces round-trip through the binary format, text included
+/// - User events are skipped; foreign or truncated bytes are handled
+/// - Replay delivers a trace in order and re-addresses recorded windows
+
+@Suite("Event Trace")
+@MainActor
+struct EventTraceTests {
+
+    private static let window = WindowID(index: 3, generation: 2)
+
+    private static let events: [Event] = [
+        .window(.created(window)),
+        .window(.resized(window, LogicalSize(width: 800.5, height: 600))),
+        .window(.moved(window, LogicalPosition(x: -20, y: 40))),
+        .window(.scaleFactorChanged(window, oldFactor: 1, newFactor: 2)),
+        .window(.redrawRequested(window)),
+        .window(.occlusionChanged(window, isOccluded: true)),
+        .window(.minimized(window)),
+        .window(.restored(window)),
+        .pointer(.moved(window, position: LogicalPosition(x: 10.25, y: 20.75))),
+        .pointer(.buttonPressed(window, button: .middle, position: LogicalPosition(x: 1, y: 2))),
+        .pointer(.wheel(window, deltaX: 0, deltaY: -3.5)),
+        .pointer(.rawMotion(dx: 0.125, dy: -0.5)),
+        .keyboard(.keyDown(window, key: KeyCode(rawValue: 42), modifiers: ModifierKeys(rawValue: 5))),
+        .keyboard(.textInput(window, text: "héllo 👋")),
+        .monitorsChanged,
+        .window(.closed(window))
+    ]
+
+    /// Record and text of an event, for comparing events (Event is not Equatable).
+    private static func encoding(_ event: Event) -> EventRecord? {
+        EventRecord.encode(event)?.record
+    }
+
+    private static func text(_ event: Event) -> String? {
+        EventRecord.encode(event)?.text
+    }
+
+    private static func traceBytes(_ envelopes: [EventEnvelope]) -> [UInt8] {
+        var bytes: [UInt8] = []
+        EventTraceFormat.appendHeader(to: &bytes)
+        for envelope in envelopes {
+            _ = EventTraceFormat.append(envelope, to: &bytes)
+        }
+        return bytes
+    }
+
+    private static func decode(_ bytes: [UInt8]) -> Result<[EventEnvelope], LuminaError> {
+        bytes.withUnsafeBytes { EventTraceFormat.decode($0) }
+    }
+
+    @Test("Events survive the record encoding")
+    func recordRoundTrip() throws {
+        for event in Self.events {
+            let encoded = try #require(EventRecord.encode(event))
+            let decoded = try #require(encoded.record.event(text: encoded.text ?? ""))
+            #expect(Self.encoding(decoded) == encoded.record)
+            #expect(Self.text(decoded) == encoded.text)
+        }
+    }
+
+    @Test("Traces round-trip through the binary format")
+    func formatRoundTrip() throws {
+        let envelopes = Self.events.enumerated().map { index, event in
+            EventEnvelope(event, timestamp: EventTimestamp(nanoseconds: 1_000 + UInt64(index) * 16_000_000))
+        }
+        let decoded = try Self.decode(Self.traceBytes(envelopes)).get()
+
+        #expect(decoded.count == envelopes.count)
+        for (original, copy) in zip(envelopes, decoded) {
+            #expect(copy.timestamp == original.timestamp)
+            #expect(Self.encoding(copy.event) == Self.encoding(original.event))
+            #expect(Self.text(copy.event) == Self.text(original.event))
+        }
+    }
+
+    @Test("User events are not recorded")
+    func userEventsSkipped() {
+        var bytes: [UInt8] = []
+        #expect(!EventTraceFormat.append(EventEnvelope(.user(UserEvent(1))), to: &bytes))
+        #expect(bytes.isEmpty)
+    }
+
+    @Test("Bytes without the trace magic are rejected")
+    func badMagic() {
+        var bytes = Self.traceBytes([])
+        bytes[0] = 0
+        guard case .failure = Self.decode(bytes) else {
+            Issue.record("Expected decoding to fail")
+            return
+        }
+    }
+
+    @Test("Decoding stops at the unwritten tail")
+    func zeroTail() throws {
+        var bytes = Self.traceBytes([EventEnvelope(.monitorsChanged)])
+        // A mapped file grows in zeroed chunks; the unused part reads as tag 0
+        bytes.append(contentsOf: repeatElement(0, count: EventTraceFormat.recordSize * 3))
+        #expect(try Self.decode(bytes).get().count == 1)
+    }
+
+    @Test("Replay delivers the trace in order and re-addresses windows")
+    func replay() throws {
+        let recorded = WindowID(index: 7, generation: 9)
+        let trace = EventTrace(events: [
+            EventEnvelope(.window(.resized(recorded, LogicalSize(width: 320, height: 200))), timestamp: EventTimestamp(nanoseconds: 5_000)),
+            EventEnvelope(.keyboard(.keyDown(recorded, key: KeyCode(rawValue: 4), modifiers: [])), timestamp: EventTimestamp(nanoseconds: 9_000)),
+            EventEnvelope(.monitorsChanged, timestamp: EventTimestamp(nanoseconds: 12_000))
+        ])
+
+        var app = ReplayApplication(trace: trace, pace: .unpaced)
+        let window = try app.createWindow(
+            title: "Replay", size: LogicalSize(width: 100, height: 100), resizable: true, monitor: nil
+        ).get()
+
+        var envelopes: [EventEnvelope] = []
+        try app.drain(into: &envelopes)
+
+        #expect(app.isFinished)
+        #expect(envelopes.count == 3)
+        guard case .window(.resized(let id, let size)) = envelopes[0].event else {
+            Issue.record("Expected the recorded resize first")
+            return
+        }
+        #expect(id == window.id)
+        #expect(size == LogicalSize(width: 320, height: 200))
+        #expect(app.keyboardState(for: window.id).isPressed(KeyCode(rawValue: 4)))
+
+        // Recorded spacing is kept
+        #expect(envelopes[0].timestamp.duration(to: envelopes[2].timestamp) == .nanoseconds(7_000))
+    }
+
+    @Test("run(handler:) returns once the trace is delivered")
+    func replayRunReturns() throws {
+        let trace = EventTrace(events: [EventEnvelope(.monitorsChanged), EventEnvelope(.monitorsChanged)])
+        var app = ReplayApplication(trace: trace, pace: .unpaced)
+
+        var received = 0
+        try app.run { _ in
+            received += 1
+            return .wait
+        }
+        #expect(received == 2)
+    }
+}
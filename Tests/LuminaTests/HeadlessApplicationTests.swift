@@ -0,0 +1,162 @@
+import Testing
+@testable import Lumina
+
+/// Tests for the in-memory backend (HeadlessApplication, VirtualWindow)
+///
+/// Verifies:
+/// - Window operations update state and report the events a native window would
+/// - Injected input honors event masks and folds into input state
+/// - Redraw requests coalesce to one event per poll
+/// - Minimized and occluded windows get no redraws until visible again
+/// - Closing the last window ends run(handler:)
+
+@Suite("Headless Application")
+@MainActor
+struct HeadlessApplicationTests {
+
+    private static func makeWindow(_ app: inout HeadlessApplication) throws -> LuminaWindow {
+        try app.createWindow(
+            title: "Test", size: LogicalSize(width: 640, height: 480), resizable: true, monitor: nil
+        ).get()
+    }
+
+    @Test("Resizing respects size limits and reports .resized")
+    func resize() throws {
+        var app = HeadlessApplication()
+        var window = try Self.makeWindow(&app)
+
+        window.setMaxSize(LogicalSize(width: 800, height: 600))
+        window.resize(LogicalSize(width: 1000, height: 300))
+        #expect(window.size() == LogicalSize(width: 800, height: 300))
+
+        let events = try app.pollBatch()
+        #expect(events.count == 1)
+        guard case .window(.resized(let id, let size)) = events.first else {
+            Issue.record("Expected .resized")
+            return
+        }
+        #expect(id == window.id)
+        #expect(size == LogicalSize(width: 800, height: 300))
+    }
+
+    @Test("Focus moves between windows")
+    func focus() throws {
+        var app = HeadlessApplication()
+        var first = try Self.makeWindow(&app)
+        var second = try Self.makeWindow(&app)
+
+        first.requestFocus()
+        second.requestFocus()
+        let events = try app.pollBatch()
+        #expect(events.count == 3)
+        guard case .window(.unfocused(let id)) = events[1] else {
+            Issue.record("Expected the first window to lose focus")
+            return
+        }
+        #expect(id == first.id)
+    }
+
+    @Test("Injected input honors masks and updates input state")
+    func inject() throws {
+        var app = HeadlessApplication()
+        let window = try Self.makeWindow(&app)
+        let key = KeyCode(rawValue: 7)
+
+        #expect(app.inject(.keyboard(.keyDown(window.id, key: key, modifiers: []))))
+        #expect(app.keyboardState(for: window.id).isPressed(key))
+
+        app.setEventMask([.keyboard], for: window.id)
+        #expect(!app.inject(.pointer(.moved(window.id, position: LogicalPosition(x: 1, y: 1)))))
+        #expect(!app.inject(.keyboard(.keyDown(WindowID(), key: key, modifiers: []))))
+        #expect(!app.inject(.pointer(.rawMotion(dx: 1, dy: 0))))
+        #expect(app.pointerState(for: window.id).position == nil)
+
+        #expect(try app.pollBatch().count == 1)
+    }
+
+    @Test("Redraw requests coalesce until the next poll")
+    func redraw() throws {
+        var app = HeadlessApplication()
+        let window = try Self.makeWindow(&app)
+
+        window.requestRedraw()
+        window.requestRedraw()
+        #expect(try app.pollBatch().count == 1)
+        #expect(try app.pollBatch().isEmpty)
+    }
+
+    @Test("Hidden windows get no redraws until they can be seen again")
+    func hiddenRedraw() throws {
+        var app = HeadlessApplication()
+        var window = try Self.makeWindow(&app)
+        window.show()
+        _ = try app.pollBatch()
+
+        app.setMinimized(true, for: window.id)
+        window.requestRedraw()
+        var events = try app.pollBatch()
+        #expect(events.count == 1)
+        guard case .window(.minimized(window.id)) = events.first else {
+            Issue.record("Expected only .minimized")
+            return
+        }
+        #expect(window.proxy().isOccluded)
+
+        // Still hidden while occluded after the restore
+        app.setOccluded(true, for: window.id)
+        app.setMinimized(false, for: window.id)
+        window.requestRedraw()
+        #expect(try app.pollBatch().count == 2)
+
+        app.setOccluded(false, for: window.id)
+        events = try app.pollBatch()
+        #expect(events.count == 2)
+        guard case .window(.occlusionChanged(window.id, isOccluded: false)) = events.first,
+              case .window(.redrawRequested(window.id)) = events.last else {
+            Issue.record("Expected .occlusionChanged, then the parked .redrawRequested")
+            return
+        }
+        #expect(!window.proxy().isOccluded)
+    }
+
+    @Test("Closing the last window ends run(handler:)")
+    func closeLastWindow() throws {
+        var app = HeadlessApplication()
+        let window = try Self.makeWindow(&app)
+        window.requestRedraw()
+
+        var closed = false
+        var pending: LuminaWindow? = window
+        try app.run { event in
+            switch event {
+            case .window(.redrawRequested):
+                if let window = pending {
+                    pending = nil
+                    window.close()
+                }
+            case .window(.closed):
+                closed = true
+            default:
+                break
+            }
+            return .wait
+        }
+        #expect(closed)
+        #expect(app.windowCount == 0)
+    }
+
+    @Test("In-memory windows have no native handle or surface")
+    func noSurface() throws {
+        var app = HeadlessApplication()
+        var window = try Self.makeWindow(&app)
+
+        guard case .unavailable = window.rawWindowHandle() else {
+            Issue.record("Expected no native handle")
+            return
+        }
+        guard case .failure(.platformNotSupported) = window.surface() else {
+            Issue.record("Expected surface() to fail")
+            return
+        }
+    }
+}
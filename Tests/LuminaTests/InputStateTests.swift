@@ -0,0 +1,111 @@
+import Testing
+@testable import Lumina
+
+/// Tests for input state snapshots (KeyboardState, PointerState, WindowInputState)
+///
+/// Verifies:
+/// - Key presses and releases toggle the key's bit, including extended codes
+/// - Modifiers follow the latest key event
+/// - Pointer position and buttons follow pointer events
+/// - Losing focus releases every key and button
+
+@Suite("Input State")
+struct InputStateTests {
+
+    // MARK: - KeyboardState Tests
+
+    @Suite("KeyboardState")
+    struct KeyboardStateTests {
+
+        @Test("Empty state has no keys held")
+        func empty() {
+            let keyboard = KeyboardState()
+            #expect(keyboard.isEmpty)
+            #expect(keyboard.pressedCount == 0)
+            #expect(!keyboard.isPressed(.space))
+            #expect(keyboard.modifiers.isEmpty)
+        }
+
+        @Test("Key down and key up toggle the key")
+        func pressRelease() {
+            let windowID = WindowID()
+            var state = WindowInputState()
+
+            state.apply(.keyboard(.keyDown(windowID, key: .space, modifiers: [.shift])))
+            #expect(state.keyboard.isPressed(.space))
+            #expect(!state.keyboard.isPressed(.escape))
+            #expect(state.keyboard.modifiers == [.shift])
+
+            state.apply(.keyboard(.keyUp(windowID, key: .space, modifiers: [])))
+            #expect(!state.keyboard.isPressed(.space))
+            #expect(state.keyboard.isEmpty)
+            #expect(state.keyboard.modifiers.isEmpty)
+        }
+
+        @Test("Extended scan codes are tracked separately from their base code")
+        func extendedCodes() {
+            var keyboard = KeyboardState()
+            let rightControl = KeyCode(rawValue: 0xE01D)
+            let leftControl = KeyCode(rawValue: 0x1D)
+
+            keyboard.setPressed(rightControl, true)
+            #expect(keyboard.isPressed(rightControl))
+            #expect(!keyboard.isPressed(leftControl))
+
+            keyboard.setPressed(leftControl, true)
+            #expect(keyboard.pressedCount == 2)
+        }
+
+        @Test("Codes outside the tracked range are ignored")
+        func untrackedCodes() {
+            var keyboard = KeyboardState()
+            let unknown = KeyCode(rawValue: 0x1234)
+            keyboard.setPressed(unknown, true)
+            #expect(!keyboard.isPressed(unknown))
+            #expect(keyboard.isEmpty)
+        }
+    }
+
+    // MARK: - PointerState Tests
+
+    @Suite("PointerState")
+    struct PointerStateTests {
+
+        @Test("Pointer events update position and buttons")
+        func pointer() {
+            let windowID = WindowID()
+            var state = WindowInputState()
+            #expect(state.pointer.position == nil)
+            #expect(!state.pointer.isInside)
+
+            state.apply(.pointer(.moved(windowID, position: LogicalPosition(x: 10, y: 20))))
+            #expect(state.pointer.position == LogicalPosition(x: 10, y: 20))
+            #expect(state.pointer.isInside)
+
+            state.apply(.pointer(.buttonPressed(windowID, button: .right, position: LogicalPosition(x: 11, y: 21))))
+            #expect(state.pointer.isPressed(.right))
+            #expect(!state.pointer.isPressed(.left))
+            #expect(state.pointer.position == LogicalPosition(x: 11, y: 21))
+
+            state.apply(.pointer(.buttonReleased(windowID, button: .right, position: LogicalPosition(x: 12, y: 22))))
+            #expect(!state.pointer.isAnyButtonPressed)
+
+            state.apply(.pointer(.left(windowID)))
+            #expect(!state.pointer.isInside)
+            #expect(state.pointer.position == LogicalPosition(x: 12, y: 22))
+        }
+
+        @Test("Losing focus releases keys and buttons")
+        func unfocused() {
+            let windowID = WindowID()
+            var state = WindowInputState()
+            state.apply(.keyboard(.keyDown(windowID, key: .tab, modifiers: [.control])))
+            state.apply(.pointer(.buttonPressed(windowID, button: .left, position: LogicalPosition(x: 0, y: 0))))
+
+            state.apply(.window(.unfocused(windowID)))
+            #expect(state.keyboard.isEmpty)
+            #expect(state.keyboard.modifiers.isEmpty)
+            #expect(!state.pointer.isAnyButtonPressed)
+        }
+    }
+}
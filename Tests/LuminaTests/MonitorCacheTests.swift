@@ -0,0 +1,79 @@
+import Testing
+@testable import Lumina
+
+/// Tests for the monitor list cache (MonitorCache)
+///
+/// Verifies:
+/// - Nothing is cached until display changes are tracked
+/// - The cached list is reused until invalidated
+/// - Repeated invalidations are announced once per read
+
+@Suite("Monitor Cache")
+struct MonitorCacheTests {
+
+    private static func monitor(_ name: String) -> Monitor {
+        Monitor(
+            id: MonitorID(1),
+            name: name,
+            position: LogicalPosition(x: 0, y: 0),
+            size: LogicalSize(width: 1920, height: 1080),
+            scaleFactor: 1.0,
+            isPrimary: true
+        )
+    }
+
+    @Test("Untracked lookups always enumerate")
+    func untracked() {
+        let cache = MonitorCache()
+        var enumerations = 0
+        for _ in 0..<3 {
+            _ = cache.monitors {
+                enumerations += 1
+                return [Self.monitor("Built-in")]
+            }
+        }
+        #expect(enumerations == 3)
+    }
+
+    @Test("Tracked lookups enumerate once until invalidated")
+    func tracked() {
+        let cache = MonitorCache()
+        cache.startTracking()
+        var enumerations = 0
+        let enumerate = {
+            enumerations += 1
+            return [Self.monitor("Display \(enumerations)")]
+        }
+
+        #expect(cache.monitors(enumerate).first?.name == "Display 1")
+        #expect(cache.monitors(enumerate).first?.name == "Display 1")
+        #expect(enumerations == 1)
+
+        cache.invalidate()
+        #expect(cache.monitors(enumerate).first?.name == "Display 2")
+        #expect(enumerations == 2)
+    }
+
+    @Test("A burst of changes is announced once")
+    func dedupe() {
+        let cache = MonitorCache()
+        cache.startTracking()
+        #expect(cache.invalidate())
+        #expect(!cache.invalidate())
+
+        _ = cache.monitors { [] }
+        #expect(cache.invalidate())
+    }
+
+    @Test("Stopping tracking drops the cached list")
+    func stop() {
+        let cache = MonitorCache()
+        cache.startTracking()
+        var enumerations = 0
+        _ = cache.monitors { enumerations += 1; return [] }
+        cache.stopTracking()
+        _ = cache.monitors { enumerations += 1; return [] }
+        _ = cache.monitors { enumerations += 1; return [] }
+        #expect(enumerations == 3)
+    }
+}
@@ -0,0 +1,90 @@
+import Testing
+@testable import Lumina
+
+/// Tests for the lock-free user event channel (UserEventChannel)
+///
+/// Verifies:
+/// - FIFO delivery order from a single producer
+/// - Wakeup coalescing (only the first send after a collect wakes)
+/// - Lossless delivery from many concurrent producers
+
+@Suite("User Event Channel")
+struct UserEventChannelTests {
+
+    @Test("Delivers elements in FIFO order")
+    func fifoOrder() {
+        let channel = UserEventChannel<Int>()
+        for value in 0..<5 {
+            _ = channel.send(value)
+        }
+
+        #expect(channel.popFirst() == 0)
+
+        var drained: [Int] = []
+        channel.drain(into: &drained) { $0 }
+        #expect(drained == [1, 2, 3, 4])
+        #expect(channel.isEmpty)
+        #expect(channel.popFirst() == nil)
+    }
+
+    @Test("Only the first send after a collect requests a wakeup")
+    func wakeupCoalescing() {
+        let channel = UserEventChannel<Int>()
+
+        #expect(channel.send(1) == true)
+        #expect(channel.send(2) == false)
+        #expect(channel.send(3) == false)
+
+        var drained: [Int] = []
+        channel.drain(into: &drained) { $0 }
+        #expect(drained == [1, 2, 3])
+
+        #expect(channel.send(4) == true)
+        #expect(channel.send(5) == false)
+    }
+
+    @Test("Bounded drain keeps the remainder buffered")
+    func boundedDrain() {
+        let channel = UserEventChannel<Int>()
+        for value in 0..<10 {
+            _ = channel.send(value)
+        }
+
+        var drained: [String] = []
+        let moved = channel.drain(into: &drained, maxCount: 3) { String($0) }
+        #expect(moved == 3)
+        #expect(drained == ["0", "1", "2"])
+        #expect(!channel.isEmpty)
+        #expect(channel.removeAll() == 7)
+        #expect(channel.isEmpty)
+    }
+
+    @Test("Concurrent producers lose no elements and wake once")
+    func concurrentProducers() async {
+        let channel = UserEventChannel<Int>()
+        let producers = 8
+        let perProducer = 2_000
+
+        let wakeups = await withTaskGroup(of: Int.self) { group in
+            for producer in 0..<producers {
+                group.addTask {
+                    var requested = 0
+                    for index in 0..<perProducer {
+                        if channel.send(producer * perProducer + index) {
+                            requested += 1
+                        }
+                    }
+                    return requested
+                }
+            }
+            return await group.reduce(0, +)
+        }
+
+        #expect(wakeups == 1)
+
+        var drained: [Int] = []
+        channel.drain(into: &drained) { $0 }
+        #expect(drained.count == producers * perProducer)
+        #expect(Set(drained).count == producers * perProducer)
+    }
+}
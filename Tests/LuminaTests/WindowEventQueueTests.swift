@@ -0,0 +1,87 @@
+import Testing
+@testable import Lumina
+
+/// Tests for per-window event queues (setWindowEventQueue, poll(window:))
+///
+/// Verifies:
+/// - Routed events leave the shared stream; other events stay in it
+/// - Removing a queue returns its events to the shared stream
+/// - A window's queue goes away after it hands out `.closed`
+
+@Suite("Window Event Queues")
+@MainActor
+struct WindowEventQueueTests {
+
+    private static func makeWindow(_ app: inout HeadlessApplication) throws -> LuminaWindow {
+        try app.createWindow(
+            title: "Test", size: LogicalSize(width: 640, height: 480), resizable: true, monitor: nil
+        ).get()
+    }
+
+    private static func press(_ windowID: WindowID) -> Event {
+        .pointer(.buttonPressed(windowID, button: .left, position: LogicalPosition(x: 1, y: 1)))
+    }
+
+    @Test("Events of a window with a queue bypass the shared stream")
+    func routing() throws {
+        var app = HeadlessApplication()
+        let routed = try Self.makeWindow(&app)
+        let shared = try Self.makeWindow(&app)
+        _ = try app.pollBatch()
+
+        app.setWindowEventQueue(true, for: routed.id)
+        #expect(app.hasWindowEventQueue(for: routed.id))
+        #expect(!app.hasWindowEventQueue(for: shared.id))
+
+        app.inject(Self.press(routed.id))
+        app.inject(Self.press(shared.id))
+        app.inject(Self.press(routed.id))
+        app.postUserEvent(UserEvent(1))
+
+        var events: [Event] = []
+        #expect(try app.drain(window: routed.id, into: &events) == 2)
+        #expect(events.allSatisfy { $0.windowID == routed.id })
+
+        // The window's only own events were taken; the rest stays shared
+        #expect(try app.poll(window: routed.id) == nil)
+        let remaining = try app.pollBatch()
+        #expect(remaining.count == 2)
+        #expect(remaining.first?.windowID == shared.id)
+        #expect(try app.poll(window: shared.id) == nil)
+    }
+
+    @Test("Removing a queue returns its events to the shared stream")
+    func removeQueue() throws {
+        var app = HeadlessApplication()
+        let window = try Self.makeWindow(&app)
+        _ = try app.pollBatch()
+
+        app.setWindowEventQueue(true, for: window.id)
+        app.inject(Self.press(window.id))
+        #expect(try app.pollBatch().isEmpty)
+
+        app.setWindowEventQueue(false, for: window.id)
+        let events = try app.pollBatch()
+        #expect(events.count == 1)
+        #expect(events.first?.windowID == window.id)
+    }
+
+    @Test("The queue goes away after delivering .closed")
+    func closedWindow() throws {
+        var app = HeadlessApplication()
+        app.exitOnLastWindowClosed = false
+        let window = try Self.makeWindow(&app)
+        let id = window.id
+        _ = try app.pollBatch()
+
+        app.setWindowEventQueue(true, for: id)
+        window.close()
+
+        guard case .window(.closed(let closedID)) = try app.poll(window: id) else {
+            Issue.record("Expected .closed from the window's queue")
+            return
+        }
+        #expect(closedID == id)
+        #expect(!app.hasWindowEventQueue(for: id))
+    }
+}
@@ -0,0 +1,134 @@
+import Testing
+@testable import Lumina
+
+/// Tests for window identifiers and storage (WindowID, WindowSlab, WindowRegistry)
+///
+/// Verifies:
+/// - WindowID packs slot index and generation into 8 bytes
+/// - Detached identifiers are unique and never alias slab slots
+/// - Freed slots are reused with a new generation
+/// - Stale identifiers miss instead of resolving to a newer window
+/// - The registry maps platform handles and keeps per-window state
+
+@Suite("Window Identifiers")
+struct WindowIDTests {
+
+    // MARK: - WindowID Tests
+
+    @Suite("WindowID")
+    struct IdentifierTests {
+
+        @Test("WindowID is 8 bytes")
+        func compactLayout() {
+            #expect(MemoryLayout<WindowID>.size == 8)
+        }
+
+        @Test("Index and generation round-trip through rawValue")
+        func packing() {
+            let id = WindowID(index: 7, generation: 3)
+            #expect(id.index == 7)
+            #expect(id.generation == 3)
+            #expect(WindowID(rawValue: id.rawValue) == id)
+        }
+
+        @Test("Detached identifiers are unique")
+        func detachedUnique() {
+            let ids = (0..<100).map { _ in WindowID() }
+            #expect(Set(ids).count == 100)
+            #expect(ids.allSatisfy { $0.generation == 0 })
+        }
+    }
+
+    // MARK: - WindowSlab Tests
+
+    @Suite("WindowSlab")
+    struct SlabTests {
+
+        @Test("Insert and look up values")
+        func insertLookup() {
+            var slab = WindowSlab<String>()
+            let first = slab.insert("first")
+            let second = slab.insert("second")
+
+            #expect(slab.count == 2)
+            #expect(slab[first] == "first")
+            #expect(slab[second] == "second")
+            #expect(first != second)
+        }
+
+        @Test("Freed slots are reused with a new generation")
+        func slotReuse() {
+            var slab = WindowSlab<Int>()
+            let original = slab.insert(1)
+            #expect(slab.remove(original) == 1)
+            #expect(slab.isEmpty)
+
+            let reused = slab.insert(2)
+            #expect(reused.index == original.index)
+            #expect(reused.generation != original.generation)
+            #expect(reused != original)
+        }
+
+        @Test("Stale identifiers miss")
+        func staleLookup() {
+            var slab = WindowSlab<Int>()
+            let stale = slab.insert(1)
+            slab.remove(stale)
+            let current = slab.insert(2)
+
+            #expect(slab[stale] == nil)
+            #expect(slab.remove(stale) == nil)
+            slab[stale] = 99
+            #expect(slab[current] == 2)
+            #expect(slab[WindowID()] == nil)
+        }
+
+        @Test("Values can be built from their own ID")
+        func selfReferentialInsert() {
+            var slab = WindowSlab<WindowID>()
+            let id = slab.insert { $0 }
+            #expect(slab[id] == id)
+        }
+
+        @Test("Values can be mutated in place")
+        func mutation() {
+            var slab = WindowSlab<[Int]>()
+            let id = slab.insert([])
+            slab[id]?.append(1)
+            slab[id]?.append(2)
+            #expect(slab[id] == [1, 2])
+        }
+    }
+
+    // MARK: - WindowRegistry Tests
+
+    @Suite("WindowRegistry")
+    @MainActor
+    struct RegistryTests {
+
+        @Test("Registered handles resolve to their WindowID")
+        func handleLookup() {
+            let registry = WindowRegistry<Int, Bool>()
+            let id = registry.reserve(false)
+            registry.register(42, id: id)
+
+            #expect(registry.windowID(for: 42) == id)
+            #expect(registry[id] == false)
+
+            registry[id] = true
+            #expect(registry[id] == true)
+        }
+
+        @Test("Unregistering frees the slot and the handle")
+        func unregister() {
+            let registry = WindowRegistry<Int, Bool>()
+            let id = registry.reserve(false)
+            registry.register(42, id: id)
+            registry.unregister(id)
+
+            #expect(registry.isEmpty)
+            #expect(registry.windowID(for: 42) == nil)
+            #expect(registry[id] == nil)
+        }
+    }
+}
@@ -0,0 +1,110 @@
+import Testing
+@testable import Lumina
+
+/// Tests for the hidden window pool (WindowPool) and WindowDescriptor
+///
+/// Verifies:
+/// - Nothing is parked while the capacity is zero
+/// - Windows are handed out by style, most recent first
+/// - Shrinking the capacity evicts the oldest windows
+/// - A stale handle to a pooled window can't reach the window reusing it
+
+@Suite("Window Pool")
+struct WindowPoolTests {
+
+    @Test("A zero capacity pool parks nothing")
+    func disabled() {
+        var pool = WindowPool<Int>()
+        #expect(!pool.hasRoom)
+        #expect(!pool.offer(1, resizable: true))
+        #expect(pool.isEmpty)
+    }
+
+    @Test("Windows are taken by style, most recent first")
+    func takeByStyle() {
+        var pool = WindowPool<Int>()
+        _ = pool.setCapacity(4)
+        #expect(pool.offer(1, resizable: true))
+        #expect(pool.offer(2, resizable: false))
+        #expect(pool.offer(3, resizable: true))
+
+        #expect(pool.take(resizable: true) == 3)
+        #expect(pool.take(resizable: true) == 1)
+        #expect(pool.take(resizable: true) == nil)
+        #expect(pool.take(resizable: false) == 2)
+        #expect(pool.isEmpty)
+    }
+
+    @Test("The pool refuses windows beyond its capacity")
+    func full() {
+        var pool = WindowPool<Int>()
+        _ = pool.setCapacity(2)
+        #expect(pool.offer(1, resizable: true))
+        #expect(pool.offer(2, resizable: true))
+        #expect(!pool.hasRoom)
+        #expect(!pool.offer(3, resizable: true))
+        #expect(pool.count == 2)
+    }
+
+    @Test("Shrinking the capacity evicts the oldest windows")
+    func shrink() {
+        var pool = WindowPool<Int>()
+        _ = pool.setCapacity(3)
+        for handle in 1...3 {
+            _ = pool.offer(handle, resizable: false)
+        }
+
+        #expect(pool.setCapacity(1) == [1, 2])
+        #expect(pool.count == 1)
+        #expect(pool.take(resizable: false) == 3)
+        #expect(pool.setCapacity(-1).isEmpty)
+        #expect(pool.capacity == 0)
+    }
+
+    @Test("Descriptors default to a resizable window on the primary monitor")
+    func descriptorDefaults() {
+        let descriptor = WindowDescriptor(title: "Tool", size: LogicalSize(width: 320, height: 240))
+        #expect(descriptor.resizable)
+        #expect(descriptor.monitor == nil)
+        #expect(descriptor.size == LogicalSize(width: 320, height: 240))
+    }
+}
+
+#if os(macOS) || os(Windows)
+@Suite("Window Pool (native)")
+@MainActor
+struct NativeWindowPoolTests {
+
+    @Test("A stale handle leaves the window that reused its native window alone")
+    func staleHandle() throws {
+        var app = try createLuminaApp()
+        app.windowPoolCapacity = 1
+        let size = LogicalSize(width: 320, height: 240)
+
+        // Keeps the application from closing its last window for real
+        var anchor = try app.createWindow(title: "Anchor", size: size, resizable: false, monitor: nil).get()
+        defer { anchor.close() }
+
+        let first = try app.createWindow(title: "First", size: size, resizable: true, monitor: nil).get()
+        var stale = first
+        first.close()
+
+        var second = try app.createWindow(title: "Second", size: size, resizable: true, monitor: nil).get()
+        #expect(second.id != stale.id)
+        guard case .unavailable = stale.rawWindowHandle() else {
+            Issue.record("A closed window still exposes its native handle")
+            return
+        }
+
+        stale.resize(LogicalSize(width: 640, height: 480))
+        stale.setMinSize(LogicalSize(width: 600, height: 400))
+        stale.close()
+
+        #expect(second.size() == size)
+        if case .unavailable = second.rawWindowHandle() {
+            Issue.record("Closing a stale handle closed the window reusing its native window")
+        }
+        second.close()
+    }
+}
+#endif
@@ -0,0 +1,89 @@
+import Testing
+@testable import Lumina
+
+/// Tests for the thread-safe window proxy (WindowProxy, LuminaWindow.proxy())
+///
+/// Verifies:
+/// - Snapshots round-trip through the packed representation
+/// - Readers on other threads only see whole snapshots
+/// - The headless backend publishes resizes, visibility and close
+
+@Suite("Window Proxy")
+@MainActor
+struct WindowProxyTests {
+
+    @Test("Snapshots round-trip through packing")
+    func packing() {
+        let snapshot = WindowSnapshot(
+            size: LogicalSize(width: 640.5, height: 480.25),
+            physicalSize: PhysicalSize(width: 1281, height: 961),
+            scaleFactor: 2,
+            isVisible: true,
+            isOccluded: true
+        )
+        let packed = WindowProxy.pack(snapshot)
+        #expect(WindowProxy.unpack(logical: packed.logical, physical: packed.physical, scale: packed.scale) == snapshot)
+
+        let proxy = WindowProxy(id: WindowID(index: 0, generation: 1), snapshot: snapshot)
+        #expect(proxy.snapshot() == snapshot)
+
+        proxy.update { $0.isOccluded = false }
+        #expect(proxy.isVisible)
+        #expect(!proxy.isOccluded)
+        #expect(proxy.physicalSize == PhysicalSize(width: 1281, height: 961))
+    }
+
+    @Test("Concurrent readers never see a torn snapshot")
+    func concurrentReads() async {
+        let proxy = WindowProxy(
+            id: WindowID(index: 0, generation: 1),
+            snapshot: WindowSnapshot(size: LogicalSize(width: 0, height: 0), scaleFactor: 1)
+        )
+
+        // Every published snapshot has width == height and a matching pixel size
+        let reader = Task.detached {
+            var torn = 0
+            for _ in 0..<20_000 {
+                let state = proxy.snapshot()
+                if state.size.width != state.size.height
+                    || state.physicalSize.width != Int(state.size.width * 2) {
+                    torn += 1
+                }
+            }
+            return torn
+        }
+        for value in 1...20_000 {
+            let size = LogicalSize(width: Float(value), height: Float(value))
+            proxy.publish(WindowSnapshot(size: size, scaleFactor: 2))
+        }
+
+        #expect(await reader.value == 0)
+        #expect(proxy.size == LogicalSize(width: 20_000, height: 20_000))
+    }
+
+    @Test("Headless windows publish size, visibility and close")
+    func headless() throws {
+        var app = HeadlessApplication()
+        app.exitOnLastWindowClosed = false
+        var window = try app.createWindow(
+            title: "Test", size: LogicalSize(width: 640, height: 480), resizable: true, monitor: nil
+        ).get()
+        let proxy = window.proxy()
+
+        #expect(proxy.id == window.id)
+        #expect(proxy.size == LogicalSize(width: 640, height: 480))
+        #expect(proxy.physicalSize == PhysicalSize(width: 640, height: 480))
+        #expect(proxy.scaleFactor == 1)
+        #expect(!proxy.isVisible)
+
+        window.show()
+        window.resize(LogicalSize(width: 800, height: 600))
+        #expect(proxy.isVisible)
+        #expect(proxy.size == window.size())
+        #expect(window.proxy() === proxy)
+
+        window.close()
+        #expect(!proxy.isVisible)
+        #expect(proxy.size == LogicalSize(width: 800, height: 600))
+    }
+}